@@ -0,0 +1,124 @@
+#pragma once
+
+#include "common.hpp"
+#include "bit_utils.hpp"
+#include <iterator>
+
+namespace MemoryForensics {
+    
+    // Compressed set of addresses in the style of roaring bitmaps. Addresses are
+    // grouped by their upper 48 bits; each 64KB group stores its 16-bit offsets
+    // as a sorted array while sparse and as a 65536-bit bitmap once dense, so a
+    // hit costs at most 2 bytes instead of 8 and dense hits cost 1 bit.
+    class AddressSet {
+    public:
+        class ConstIterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = MemoryAddress;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const MemoryAddress*;
+            using reference = MemoryAddress;
+            
+            MemoryAddress operator*() const { return current_; }
+            ConstIterator& operator++();
+            ConstIterator operator++(int) { ConstIterator old = *this; ++*this; return old; }
+            
+            bool operator==(const ConstIterator& other) const {
+                return container_ == other.container_ && position_ == other.position_;
+            }
+            bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+        
+        private:
+            friend class AddressSet;
+            
+            const AddressSet* set_ = nullptr;
+            size_t container_ = 0;
+            size_t position_ = 0;     // Array index, or bit index in a bitmap
+            MemoryAddress current_ = 0;
+            
+            ConstIterator(const AddressSet* set, size_t container, size_t position);
+            void Settle();            // Advance to the first value at or after position_
+        };
+        
+        AddressSet() = default;
+        
+        // Scan output is already sorted, which makes this a sequence of appends
+        static AddressSet FromSorted(const std::vector<MemoryAddress>& addresses);
+        
+        void Add(MemoryAddress address);
+        bool Contains(MemoryAddress address) const;
+        
+        // Moves every address of other into this set; all of them must be greater
+        // than the largest address already present
+        void Append(AddressSet&& other);
+        
+        AddressSet Intersect(const AddressSet& other) const;
+        AddressSet Union(const AddressSet& other) const;
+        
+        size_t Size() const { return size_; }
+        bool Empty() const { return size_ == 0; }
+        void Clear();
+        
+        // Heap bytes held by the set
+        size_t MemoryUsage() const;
+        
+        std::vector<MemoryAddress> ToVector() const;
+        
+        ConstIterator begin() const { return ConstIterator(this, 0, 0); }
+        ConstIterator end() const { return ConstIterator(this, containers_.size(), 0); }
+        
+        // Calls f(address) in increasing order; faster than iterating
+        template<typename F>
+        void ForEach(F&& f) const;
+    
+    private:
+        struct Container {
+            std::vector<uint16_t> array;    // Sorted offsets while sparse
+            std::vector<uint64_t> bitmap;   // BITMAP_WORDS words once dense
+            uint32_t cardinality = 0;
+            
+            bool IsBitmap() const { return !bitmap.empty(); }
+        };
+        
+        std::vector<uint64_t> keys_;        // address >> 16, ascending
+        std::vector<Container> containers_;
+        size_t size_ = 0;
+        
+        static void AddToContainer(Container& container, uint16_t offset);
+        static bool ContainerContains(const Container& container, uint16_t offset);
+        static void ToBitmap(Container& container);
+        static void ToArray(Container& container);
+        static Container IntersectContainers(const Container& a, const Container& b);
+        static Container UnionContainers(const Container& a, const Container& b);
+        
+        // Arrays larger than this take more space than a bitmap
+        static constexpr size_t ARRAY_MAX = 4096;
+        static constexpr size_t BITMAP_WORDS = 65536 / 64;
+    };
+    
+    // Template implementation
+    template<typename F>
+    void AddressSet::ForEach(F&& f) const {
+        for (size_t i = 0; i < containers_.size(); ++i) {
+            const Container& container = containers_[i];
+            MemoryAddress base = static_cast<MemoryAddress>(keys_[i] << 16);
+            
+            if (!container.IsBitmap()) {
+                for (uint16_t offset : container.array) {
+                    f(base + offset);
+                }
+                continue;
+            }
+            
+            for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+                uint64_t bits = container.bitmap[word];
+                while (bits != 0) {
+                    f(base + word * 64 + CountTrailingZeros(bits));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+    
+} // namespace MemoryForensics
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace MemoryForensics {
+    
+    // Index of the lowest set bit; bits must be non-zero
+    inline unsigned CountTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
+    
+    inline unsigned PopCount(uint64_t bits) {
+#if defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(bits));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+    }
+    
+#if defined(__x86_64__) || defined(_M_X64)
+    // Runtime check for the AVX2 kernels; SSE2 is part of the x86-64 baseline
+    inline bool CpuSupportsAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        
+        // AVX2 also needs the OS to save YMM state across context switches
+        __cpuid(info, 1);
+        bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+        
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+    
+} // namespace MemoryForensics
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace MemoryForensics {
+    
+    // Byte-oriented LZ77 codec for blocks of up to 64KB, in the spirit of LZ4:
+    // a greedy matcher with a small hash table and no entropy stage, so memory
+    // images compress at disk speed and decode several times faster still.
+    //
+    // A block is a series of sequences, each
+    //   token               literal count (high nibble), match length - 4 (low nibble)
+    //   [255...] n          literal count continued when the nibble is 15
+    //   literals
+    //   offset              uint16 LE back reference, 1..65535
+    //   [255...] n          match length continued when the nibble is 15
+    // and the last sequence stops after its literals.
+    namespace BlockCodec {
+        
+        static constexpr size_t MAX_BLOCK_SIZE = 0x10000;
+        
+        // Worst case output for incompressible input of size bytes
+        constexpr size_t Bound(size_t size) { return size + size / 255 + 16; }
+        
+        // Compressed size, or 0 if the result would not fit in capacity
+        size_t Compress(const uint8_t* input, size_t size, uint8_t* output, size_t capacity);
+        
+        // True only if input decodes to exactly size bytes; never reads or
+        // writes out of bounds, whatever the input holds
+        bool Decompress(const uint8_t* input, size_t input_size, uint8_t* output, size_t size);
+        
+    } // namespace BlockCodec
+    
+} // namespace MemoryForensics
@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <optional>
 #include <cstdint>
+#include <functional>
 
 // Logging
 #include <spdlog/spdlog.h>
@@ -30,6 +31,7 @@ namespace MemoryForensics {
     constexpr const char* TARGET_PROCESS_NAME = "Revolution Idol.exe";
     constexpr size_t MAX_READ_SIZE = 0x1000000; // 16MB max read
     constexpr size_t SCAN_CHUNK_SIZE = 0x10000;  // 64KB chunks
+    constexpr size_t REMOTE_PAGE_SIZE = 0x1000;  // 4KB target pages
     
     // Common structures
     struct MemoryRegion {
@@ -37,6 +39,42 @@ namespace MemoryForensics {
         size_t size;
         DWORD protection;
         std::string name;
+        DWORD type = 0;  // MEM_IMAGE / MEM_MAPPED / MEM_PRIVATE
+    };
+    
+    // Protection flags that allow reading, writing and executing, for every check of any
+    constexpr DWORD READABLE_PROTECTION = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+                                          PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    constexpr DWORD WRITABLE_PROTECTION = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    constexpr DWORD EXECUTABLE_PROTECTION = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    
+    inline bool IsWritable(const MemoryRegion& region) { return (region.protection & WRITABLE_PROTECTION) != 0; }
+    inline bool IsExecutable(const MemoryRegion& region) { return (region.protection & EXECUTABLE_PROTECTION) != 0; }
+    
+    // One element of a scatter/gather read; success is reported per element
+    struct ReadRequest {
+        MemoryAddress address;
+        void* buffer;
+        size_t size;
+        bool success = false;
+    };
+    
+    // Told the index of each request of a batch once that request is finished,
+    // successful or not, so its buffer can be used while others are in flight
+    using ReadCompletion = std::function<void(size_t index)>;
+    
+    struct SignatureHit {
+        std::string name;
+        MemoryAddress address;
+    };
+    
+    // module+offsets[0] -> +offsets[1] -> ...; every offset is dereferenced, so
+    // FollowPointerChain(module base, offsets).back() is the target
+    struct PointerPath {
+        std::string module;
+        std::vector<size_t> offsets;
+        
+        std::string ToString() const;
     };
     
     struct EncryptedBigInteger {
@@ -69,4 +107,7 @@ namespace MemoryForensics {
     bool IsValidPointer(MemoryAddress address);
     std::vector<uint8_t> HexStringToBytes(const std::string& hex);
     std::string BytesToHexString(const std::vector<uint8_t>& bytes);
+    
+    // ASCII case-insensitive equality, the way Windows compares module names
+    bool EqualsIgnoreCase(const std::string& a, const std::string& b);
 }
\ No newline at end of file
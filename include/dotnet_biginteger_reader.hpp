@@ -19,12 +19,18 @@ struct DotNetBigIntegerData {
 
 class DotNetBigIntegerReader {
 public:
+    explicit DotNetBigIntegerReader(std::shared_ptr<MemorySource> source);
+    
+    // Reads through the scanner's read source as it is at construction
     explicit DotNetBigIntegerReader(std::shared_ptr<MemoryScanner> scanner);
     ~DotNetBigIntegerReader() = default;
     
     // Read a .NET BigInteger from the specified memory address
     std::optional<DotNetBigIntegerData> ReadBigInteger(MemoryAddress base_address);
     
+    // Read several BigIntegers with two batched round trips (headers, then bits arrays)
+    std::vector<std::optional<DotNetBigIntegerData>> ReadBigIntegers(const std::vector<MemoryAddress>& addresses);
+    
     // Read and parse BigInteger with detailed logging
     std::optional<DotNetBigIntegerData> ReadBigIntegerVerbose(MemoryAddress base_address);
     
@@ -36,9 +42,16 @@ public:
     
     // Convert BigInteger data to hexadecimal string
     std::string BigIntegerToHex(const DotNetBigIntegerData& bigint);
+    
+    // Derive the bits length from a probed array (last non-zero element)
+    static uint32_t DetermineBitsLength(const std::vector<uint32_t>& probe, int32_t sign);
+    
+    // Layout shared by BigInteger and SerializableBigInteger: int32 sign followed by bits pointer
+    static constexpr size_t HEADER_SIZE = sizeof(int32_t) + sizeof(MemoryAddress);
+    static constexpr uint32_t MAX_PROBE_LENGTH = 32;  // Probe up to 32 uint32 values
 
 private:
-    std::shared_ptr<MemoryScanner> scanner_;
+    std::shared_ptr<MemorySource> source_;
     
     // Helper methods
     void LogMemoryValue(const std::string& field_name, MemoryAddress address, 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "common.hpp"
+#include "memory_source.hpp"
 #include "process_manager.hpp"
+#include "memory_scanner.hpp"
 
 namespace MemoryForensics {
     
@@ -25,6 +27,11 @@ namespace MemoryForensics {
     class DotNetParser {
     public:
         explicit DotNetParser(std::shared_ptr<ProcessManager> process_mgr);
+        explicit DotNetParser(std::shared_ptr<MemorySource> source);
+        
+        // Reads through the scanner's source, page cache included: MethodTables
+        // and EEClasses are read repeatedly
+        explicit DotNetParser(std::shared_ptr<MemoryScanner> scanner);
         ~DotNetParser() = default;
         
         // Object analysis
@@ -51,7 +58,7 @@ namespace MemoryForensics {
         std::vector<MemoryAddress> FindMonoBehaviours();
         
     private:
-        std::shared_ptr<ProcessManager> process_mgr_;
+        std::shared_ptr<MemorySource> source_;
         std::unordered_map<MemoryAddress, MethodTable> method_table_cache_;
         std::unordered_map<std::string, MemoryAddress> type_name_cache_;
         
@@ -66,9 +73,14 @@ namespace MemoryForensics {
         std::string GetTypeNameFromEEClass(MemoryAddress ee_class_addr);
         MemoryAddress GetTypeHandle(MemoryAddress method_table_addr);
         
+        // Memory access through the source
+        bool ReadRaw(MemoryAddress address, void* buffer, size_t size);
+        size_t ReadRawBatch(std::vector<ReadRequest>& requests);
+        
         // Memory validation helpers
         bool IsValidPointer(MemoryAddress addr);
         bool IsInExecutableMemory(MemoryAddress addr);
+        static bool IsManagedHeapCandidate(DWORD protection, size_t size);
         
         // Constants for .NET object validation
         static constexpr uint32_t METHOD_TABLE_MIN_SIZE = 0x28;
@@ -2,6 +2,8 @@
 
 #include "common.hpp"
 #include "memory_scanner.hpp"
+#include "value_scanner.hpp"
+#include "pointer_scanner.hpp"
 #include "decryption_engine.hpp"
 
 #include <sol/sol.hpp>
@@ -36,6 +38,8 @@ namespace MemoryForensics {
     private:
         sol::state lua_;
         std::shared_ptr<MemoryScanner> scanner_;
+        std::unique_ptr<ValueScanner> value_scanner_;
+        std::unique_ptr<PointerScanner> pointer_scanner_;
         std::shared_ptr<DecryptionEngine> decryptor_;
         std::string last_error_;
         std::vector<std::string> available_scripts_;
@@ -48,7 +52,7 @@ namespace MemoryForensics {
         
         // Memory API functions exposed to Lua
         void LuaReadMemory(MemoryAddress address, size_t size);
-        std::vector<MemoryAddress> LuaScanPattern(const std::string& hex_pattern);
+        std::vector<MemoryAddress> LuaScanPattern(const std::string& hex_pattern, const ScanOptions& options = {});
         sol::table LuaFindEncryptedBigIntegers();
         bool LuaDecryptBigInteger(MemoryAddress container_addr);
         
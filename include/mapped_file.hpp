@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace MemoryForensics {
+    
+    // Read-only memory mapping of a whole file
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        bool Open(const std::string& path);
+        void Close();
+        
+        bool IsOpen() const { return data_ != nullptr; }
+        const uint8_t* Data() const { return data_; }
+        size_t Size() const { return size_; }
+    
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef WINDOWS_BUILD
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+    
+    // Layout checks shared by the files that are read through a mapping
+    // (pointer maps, snapshots), whose tables start on 8-byte boundaries
+    namespace FileLayout {
+        inline uint64_t AlignUp(uint64_t value) {
+            return (value + 7) & ~static_cast<uint64_t>(7);
+        }
+        
+        // Whether count records of record_size bytes at offset lie inside a file
+        // of file_size bytes. Offsets and counts come from the file, so nothing
+        // is summed or multiplied where it could wrap.
+        inline bool FitsInFile(uint64_t offset, uint64_t count, size_t record_size, uint64_t file_size) {
+            return offset <= file_size && count <= (file_size - offset) / record_size;
+        }
+    }
+    
+} // namespace MemoryForensics
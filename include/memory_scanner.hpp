@@ -1,19 +1,153 @@
 #pragma once
 
 #include "common.hpp"
+#include "address_set.hpp"
+#include "memory_source.hpp"
 #include "process_manager.hpp"
+#include "page_cache.hpp"
+#include "page_fingerprint.hpp"
+#include "region_chunk_reader.hpp"
+#include "pattern.hpp"
+#include "pattern_matcher.hpp"
+#include "rule_matcher.hpp"
+#include "signature_matcher.hpp"
+#include "string_matcher.hpp"
+#include "thread_pool.hpp"
+#include "write_tracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 
 namespace MemoryForensics {
     
+    // One readable span of a region sweep. Only values starting in
+    // [owned_begin, owned_end) belong to it, so each address is visited once
+    // even though spans overlap.
+    struct SweepSpan {
+        size_t task;
+        MemoryAddress region_base;   // Alignment origin
+        MemoryAddress address;
+        const uint8_t* data;
+        size_t size;
+        MemoryAddress owned_begin;
+        MemoryAddress owned_end;
+    };
+    
+    struct StringMatch {
+        MemoryAddress address;          // First character
+        StringEncoding encoding;
+        MemoryAddress object = 0;       // Managed string object, when its header was checked
+        uint32_t length = 0;            // Characters according to that header
+    };
+    
+    // Shared stop flag; any thread may cancel, running scans notice between chunks
+    class CancellationToken {
+    public:
+        void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+        void Reset() { cancelled_.store(false, std::memory_order_relaxed); }
+        bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+    
+    private:
+        std::atomic<bool> cancelled_{false};
+    };
+    
+    // Per-scan limits. Every condition is checked between chunks, so a scan stops
+    // within one chunk of it being met and returns what it found so far.
+    struct ScanOptions {
+        std::shared_ptr<CancellationToken> cancel;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        size_t max_results = 0;             // 0 for no limit
+        bool first_match_only = false;      // Same as max_results = 1
+        std::function<void(float)> progress;  // Overrides EnableProgressCallback for this scan
+        
+        void SetTimeout(std::chrono::milliseconds timeout) {
+            deadline = std::chrono::steady_clock::now() + timeout;
+        }
+        
+        size_t ResultLimit() const { return first_match_only ? 1 : max_results; }
+    };
+    
+    enum class ScanStatus {
+        Completed,
+        Cancelled,
+        TimedOut,
+        ResultLimit     // Stopped after collecting the requested number of hits
+    };
+    
+    // Pages the untouched-page pre-pass left out of the last scan
+    struct ResidencyStats {
+        struct Region {
+            MemoryAddress base_address;
+            size_t pages;
+            size_t skipped_pages;
+        };
+        
+        std::vector<Region> regions;    // Every region whose residency was queried
+        size_t pages = 0;
+        size_t skipped_pages = 0;
+    };
+    
     class MemoryScanner {
     public:
+        // Pull-based scan, see the definition below
+        template<typename Hit>
+        class ScanCursor;
+        using PatternCursor = ScanCursor<MemoryAddress>;
+        using SignatureCursor = ScanCursor<SignatureHit>;
+        
+        // Receive one batch of hits in address order; return false to stop the scan
+        using MatchSink = std::function<bool(const std::vector<MemoryAddress>& batch)>;
+        using SignatureSink = std::function<bool(const std::vector<SignatureHit>& batch)>;
+        
         explicit MemoryScanner(std::shared_ptr<ProcessManager> process_mgr);
         ~MemoryScanner() = default;
         
         // Pattern scanning
         std::vector<MemoryAddress> ScanForPattern(const ByteVector& pattern, 
                                                  const ByteVector& mask = {});
-        std::vector<MemoryAddress> ScanForPattern(const std::string& hex_pattern);
+        std::vector<MemoryAddress> ScanForPattern(const std::string& hex_pattern, const ScanOptions& options = {});
+        std::vector<MemoryAddress> ScanForPattern(const Pattern& pattern, const ScanOptions& options = {});
+        
+        // Same hits as ScanForPattern, compressed as they are produced for broad scans
+        AddressSet ScanForPatternSet(const std::string& hex_pattern, const ScanOptions& options = {});
+        AddressSet ScanForPatternSet(const Pattern& pattern, const ScanOptions& options = {});
+        
+        // All loaded signatures in a single sweep, sorted by address
+        std::vector<SignatureHit> ScanForSignatures(const ScanOptions& options = {});
+        
+        // Streaming forms: hits go to the sink a window at a time while the scan
+        // runs, so nothing accumulates. Return the number of hits delivered.
+        size_t ScanForPattern(const Pattern& pattern, const MatchSink& sink, const ScanOptions& options = {});
+        size_t ScanForSignatures(const SignatureSink& sink, const ScanOptions& options = {});
+        
+        // Text search in ASCII/UTF-8 and UTF-16LE; only ASCII letters fold when
+        // case_insensitive. managed_only keeps UTF-16 hits that start a System.String,
+        // i.e. follow a plausible length and MethodTable (CoreCLR) or vtable (Mono).
+        // Matches are found at any suitable address, regardless of the scan alignment.
+        std::vector<StringMatch> FindStrings(const std::string& text,
+                                             StringEncoding encoding = StringEncoding::Both,
+                                             bool case_insensitive = false,
+                                             bool managed_only = false,
+                                             const ScanOptions& options = {});
+        
+        // Scans that advance only when asked; nullptr if there is nothing to scan for
+        std::unique_ptr<PatternCursor> OpenPatternCursor(const Pattern& pattern, const ScanOptions& options = {});
+        std::unique_ptr<SignatureCursor> OpenSignatureCursor(const ScanOptions& options = {});
+        
+        // Streams the scan regions through a custom kernel, on the worker pool when
+        // one is configured. prepare receives the task count before any span is
+        // visited so output can be kept per task and merged in address order.
+        // Result limits in options are the kernel's business and are ignored here.
+        void SweepScanRegions(size_t value_size,
+                              const std::function<void(size_t task_count)>& prepare,
+                              const std::function<void(const SweepSpan& span)>& visitor,
+                              const std::function<bool(const MemoryRegion& region)>& region_filter = {},
+                              const ScanOptions& options = {});
+        
+        // How the most recent scan ended. With several workers a result-limited
+        // scan keeps the first hits found, which are not always the lowest addresses.
+        ScanStatus GetLastScanStatus() const { return last_scan_status_; }
         
         // Specific structure scanning
         std::vector<MemoryAddress> FindContainerStructs();
@@ -24,6 +158,11 @@ namespace MemoryForensics {
         std::optional<T> ReadValue(MemoryAddress address);
         
         ByteVector ReadBytes(MemoryAddress address, size_t size);
+        bool ReadInto(MemoryAddress address, Span<uint8_t> buffer);
+        size_t ReadBatch(std::vector<ReadRequest>& requests);
+        
+        // Bytes of the source in place, or empty when it cannot map them
+        Span<const uint8_t> Map(MemoryAddress address, size_t size) { return source_->Map(address, size); }
         std::string ReadString(MemoryAddress address, size_t max_length = 256);
         
         // Primitive type reading functions
@@ -38,42 +177,288 @@ namespace MemoryForensics {
         std::vector<MemoryAddress> FollowPointerChain(MemoryAddress base, 
                                                      const std::vector<size_t>& offsets);
         
+        // Target of a pointer path, or nullopt if the module or any link is missing
+        std::optional<MemoryAddress> ResolvePointerPath(const PointerPath& path);
+        
         // Signature management
         void AddSignature(const std::string& name, const ByteVector& pattern);
+        void AddSignature(const std::string& name, const Pattern& pattern);
+        
+        // Rules replace a pattern signature of the same name and vice versa;
+        // ScanForSignatures reports both kinds
+        void AddRule(const Rule& rule);
+        bool AddRule(const std::string& name, const std::string& text);
         void LoadSignaturesFromConfig(const nlohmann::json& config);
+        void LoadScanSettingsFromConfig(const nlohmann::json& config);
         
         // Scanning configuration
+        // Scans cover the process manager's filtered regions until an explicit
+        // list or range is set. Explicit lists pass through the region filter
+        // too; a range is scanned as given.
         void SetScanRegions(const std::vector<MemoryRegion>& regions);
         void SetScanRange(MemoryAddress start, MemoryAddress end);
+        void UseFilteredRegions();
+        const RegionFilterStats& GetScanFilterStats() const { return scan_filter_stats_; }
+        void SetScanAlignment(size_t alignment) { scan_alignment_ = std::max<size_t>(alignment, 1); }
+        size_t GetScanAlignment() const { return scan_alignment_; }
         void EnableProgressCallback(std::function<void(float)> callback);
         
+        // Parallel scanning: 0 uses every hardware thread, 1 scans on the calling thread
+        void SetWorkerThreads(size_t count);
+        size_t GetWorkerThreads() const { return thread_pool_ ? thread_pool_->Size() : 1; }
+        
+        std::shared_ptr<ProcessManager> GetProcessManager() const { return process_mgr_; }
+        
+        // Where scans and reads take their bytes from: the attached process until
+        // another source, such as a mapped dump, is set; nullptr goes back to it.
+        // Sources that map their memory are scanned in place, without copies.
+        // Switching stops change tracking, which only follows a live process.
+        void SetMemorySource(std::shared_ptr<MemorySource> source);
+        std::shared_ptr<MemorySource> GetMemorySource() const { return scan_source_; }
+        
+        // The source behind the page cache for small, repeated reads, when both apply
+        std::shared_ptr<MemorySource> GetReadSource() const { return source_; }
+        
+        // Optional read-through page cache for small, repeated reads. Region
+        // sweeps stream past it so they do not evict the pages read repeatedly.
+        void SetPageCache(std::shared_ptr<PageCache> cache);
+        std::shared_ptr<PageCache> GetPageCache() const { return page_cache_; }
+        
+        // Optional page fingerprints: pattern rescans reuse the hits of pages whose
+        // content was already matched instead of matching them again
+        void SetPageFingerprints(std::shared_ptr<PageFingerprints> fingerprints) { page_fingerprints_ = fingerprints; }
+        std::shared_ptr<PageFingerprints> GetPageFingerprints() const { return page_fingerprints_; }
+        
+        // Change tracking through the target's soft-dirty bits (Linux). While on,
+        // ScanForPattern keeps each pattern's hits, and later scans of it read
+        // only the pages written since and reuse the previous hits everywhere
+        // else. Enabling starts a new session; false if the target cannot be tracked.
+        bool EnableChangeTracking(bool enable);
+        bool IsChangeTrackingEnabled() const { return write_tracker_ != nullptr; }
+        
+        // Untouched-page pre-pass. Private regions are cut down to the pages the
+        // target populated before any read, so pages it never touched are not
+        // faulted in by the scan; hits that need their zeros are not reported.
+        // Regions that do not start on a page boundary are scanned whole. Only
+        // Linux tells swapped-out pages from untouched ones; on Windows pages
+        // trimmed to the pagefile are skipped as well, so it is off by default.
+        void SetSkipUntouchedPages(bool enabled);
+        bool GetSkipUntouchedPages() const { return skip_untouched_pages_; }
+        const ResidencyStats& GetResidencyStats() const { return residency_stats_; }
+        
     private:
         std::shared_ptr<ProcessManager> process_mgr_;
+        std::shared_ptr<MemorySource> scan_source_;     // As set; what region sweeps read
+        std::shared_ptr<MemorySource> source_;          // scan_source_, behind the page cache when it applies
+        std::shared_ptr<PageCache> page_cache_;
+        std::shared_ptr<PageFingerprints> page_fingerprints_;
+        std::unique_ptr<WriteTracker> write_tracker_;
+        std::unique_ptr<RegionChunkReader> chunk_reader_;  // Streams regions for serial scans
+        std::unique_ptr<ThreadPool> thread_pool_;
+        std::vector<std::unique_ptr<RegionChunkReader>> worker_readers_;  // One per pool worker
         std::vector<MemoryRegion> scan_regions_;
-        std::unordered_map<std::string, ByteVector> signatures_;
+        bool explicit_regions_ = false;
+        RegionFilterStats scan_filter_stats_;   // From the last region evaluation
+        bool skip_untouched_pages_ = false;
+        ResidencyStats residency_stats_;
+        std::unordered_map<std::string, Signature> signatures_;
+        std::unordered_map<std::string, Rule> rules_;
         std::function<void(float)> progress_callback_;
+        size_t scan_alignment_ = SCAN_ALIGNMENT;
+        ScanStatus last_scan_status_ = ScanStatus::Completed;
+        
+        // Hits of one pattern as of a write tracker pass, and the ranges they cover
+        struct TrackedScan {
+            uint64_t pass;
+            std::vector<WriteTracker::Range> covered;
+            std::vector<MemoryAddress> hits;
+            uint64_t last_used;
+        };
+        
+        std::unordered_map<std::string, TrackedScan> tracked_scans_;   // By pattern and alignment
+        uint64_t tracked_scan_count_ = 0;
+        
+        // The page cache only fronts a live source
+        void UpdateReadSource();
+        
+        bool ReadRaw(MemoryAddress address, void* buffer, size_t size);
+        
+        // Pattern signatures and rules compiled for one scan
+        struct CompiledSignatures {
+            SignatureMatcher patterns;
+            RuleMatcher rules;
+            
+            CompiledSignatures(const std::vector<Signature>& signatures, const std::vector<Rule>& rule_list, size_t alignment)
+                : patterns(signatures, alignment), rules(rule_list, alignment) {}
+            
+            size_t Count() const { return patterns.Count() + rules.Count(); }
+            size_t MaxLength() const { return std::max(patterns.MaxLength(), rules.MaxLength()); }
+        };
+        
+        std::shared_ptr<const CompiledSignatures> CompileSignatures() const;
+        
+        // A slice of one scan region; only matches starting in [start, end) belong to it
+        struct ScanTask {
+            const MemoryRegion* region;
+            MemoryAddress start;
+            MemoryAddress end;
+        };
+        
+        // Stop conditions of one scan, shared by its workers
+        class ScanControl {
+        public:
+            ScanControl(const ScanOptions& options, size_t task_count)
+                : total_tasks(task_count), options_(options) {}
+            
+            // Polled between chunks; latches the first reason to stop
+            bool ShouldStop();
+            void AddHits(size_t count);
+            void Stop(ScanStatus status);
+            ScanStatus Status() const { return status_.load(std::memory_order_relaxed); }
+            
+            const ScanOptions& Options() const { return options_; }
+            const size_t total_tasks;
+            std::atomic<size_t> tasks_done{0};
+        
+        private:
+            const ScanOptions& options_;
+            std::atomic<bool> stop_{false};
+            std::atomic<ScanStatus> status_{ScanStatus::Completed};
+            std::atomic<size_t> hits_{0};
+        };
         
         // Internal scanning methods
+        std::vector<MemoryRegion> ScanRegions();   // Explicit regions, else the filtered view
+        std::vector<MemoryRegion> DropUntouchedPages(const std::vector<MemoryRegion>& regions);
         bool IsValidScanRegion(const MemoryRegion& region);
-        std::vector<MemoryAddress> ScanRegionForPattern(const MemoryRegion& region,
-                                                       const ByteVector& pattern,
-                                                       const ByteVector& mask);
+        std::vector<ScanTask> BuildScanTasks(const std::vector<MemoryRegion>& regions,
+                                             const std::function<bool(const MemoryRegion& region)>& region_filter = {});
+        void RunScanTasks(size_t task_count, ScanControl& control,
+                          const std::function<void(size_t task, RegionChunkReader& reader)>& body);
+        void ScanTaskForPattern(const ScanTask& task, const PatternMatcher& matcher, PageFingerprints::Table* fingerprints,
+                                ScanControl& control, RegionChunkReader& reader, std::vector<MemoryAddress>& results);
+        
+        // With change tracking on, advance the tracker and, when the pattern's last
+        // tracked scan is still recent enough, return tasks covering only the starts
+        // that may touch a written or newly scanned page, plus the earlier hits
+        // outside them. nullopt means scanning everything; pass is set whenever
+        // the result may be kept for the next scan.
+        std::optional<std::vector<ScanTask>> PlanTrackedScan(const std::string& key, size_t lookbehind,
+                                                             const std::vector<MemoryRegion>& regions,
+                                                             std::optional<uint64_t>& pass,
+                                                             std::vector<MemoryAddress>& kept);
+        void StoreTrackedScan(const std::string& key, uint64_t pass, const std::vector<MemoryRegion>& regions,
+                              const std::vector<MemoryAddress>& hits);
+        
+        // Fingerprint table for one scan of pattern, or null when fingerprints are off
+        std::shared_ptr<PageFingerprints::Table> BeginFingerprintScan(const Pattern& pattern, const PatternMatcher& matcher);
+        void ScanTaskForSignatures(const ScanTask& task, const CompiledSignatures& matcher, ScanControl& control,
+                                   RegionChunkReader& reader, std::vector<SignatureHit>& hits);
+        void ScanTaskForStrings(const ScanTask& task, const std::vector<StringMatcher>& matchers, bool managed_only,
+                                const RegionMap* region_map, ScanControl& control,
+                                RegionChunkReader& reader, std::vector<StringMatch>& matches);
+        
+        // header holds the MANAGED_STRING_HEADER bytes in front of the characters
+        bool MatchManagedStringHeader(const uint8_t* header, size_t char_count,
+                                      const RegionMap* region_map, StringMatch& match) const;
         
         // Container struct detection
         bool IsContainerStruct(MemoryAddress address);
         bool ValidateContainerStruct(MemoryAddress address);
         
         // Performance optimization
-        static constexpr size_t SCAN_ALIGNMENT = 4;
+        static constexpr size_t SCAN_ALIGNMENT = 4;  // Default match alignment
+        static constexpr size_t SCAN_TASK_SIZE = 16 * SCAN_CHUNK_SIZE;  // Unit of parallel work
+        static constexpr std::chrono::milliseconds PROGRESS_INTERVAL{100};
+        static constexpr size_t CURSOR_TASKS_PER_WORKER = 4;  // Scanned per ScanCursor::Next
+        static constexpr size_t MAX_TRACKED_SCANS = 16;
         static constexpr size_t MIN_VALID_POINTER = 0x10000;
         static constexpr size_t MAX_VALID_POINTER = 0x7FFFFFFFFFFF;
+        
+        // Mono: vtable, sync pointer, length; CoreCLR: MethodTable, length
+        static constexpr size_t MANAGED_STRING_HEADER = 20;
+        static constexpr int32_t MAX_MANAGED_STRING_LENGTH = 0x3FFFFFDF;
+    };
+    
+    // Each Next() scans the following window of tasks, on the worker pool when one
+    // is configured, and returns that window's hits in address order. Memory stays
+    // bounded by one window however many hits there are, the caller's thread runs
+    // every callback, and a cursor can be dropped at any point to abandon the scan.
+    // The cursor keeps its own copy of the scan regions but must not outlive the
+    // scanner, and only one scan may run on a scanner at a time.
+    template<typename Hit>
+    class MemoryScanner::ScanCursor {
+    public:
+        // False once the scan is exhausted or stopped; otherwise batch holds hits
+        bool Next(std::vector<Hit>& batch);
+        void Cancel() { control_.Stop(ScanStatus::Cancelled); }
+        
+        ScanStatus Status() const { return control_.Status(); }
+        size_t Delivered() const { return delivered_; }
+    
+    private:
+        friend class MemoryScanner;
+        
+        // Scans one task; output must be sorted by address
+        using Kernel = std::function<void(const ScanTask& task, ScanControl& control,
+                                          RegionChunkReader& reader, std::vector<Hit>& hits)>;
+        
+        MemoryScanner& scanner_;
+        std::vector<MemoryRegion> regions_;
+        std::vector<ScanTask> tasks_;
+        Kernel kernel_;
+        size_t limit_;
+        ScanOptions options_;       // Without the result limit, which applies per window
+        ScanControl control_;
+        size_t next_task_ = 0;
+        size_t delivered_ = 0;
+        
+        ScanCursor(MemoryScanner& scanner, Kernel kernel, const ScanOptions& options)
+            : scanner_(scanner), regions_(scanner.ScanRegions()), tasks_(scanner.BuildScanTasks(regions_)),
+              kernel_(std::move(kernel)), limit_(options.ResultLimit()), options_(options), control_(options_, tasks_.size()) {
+            // Stopping mid-window could leave gaps before the last hit; whole
+            // windows are trimmed instead so the hits are always the lowest ones
+            options_.max_results = 0;
+            options_.first_match_only = false;
+        }
     };
     
     // Template implementation
+    template<typename Hit>
+    bool MemoryScanner::ScanCursor<Hit>::Next(std::vector<Hit>& batch) {
+        batch.clear();
+        
+        size_t window = CURSOR_TASKS_PER_WORKER * scanner_.GetWorkerThreads();
+        
+        // Windows without hits are skipped so every true return carries data
+        while (batch.empty() && next_task_ < tasks_.size() && !control_.ShouldStop()) {
+            size_t first = next_task_;
+            size_t count = std::min(window, tasks_.size() - first);
+            std::vector<std::vector<Hit>> task_hits(count);
+            
+            scanner_.RunScanTasks(count, control_, [&](size_t task, RegionChunkReader& reader) {
+                kernel_(tasks_[first + task], control_, reader, task_hits[task]);
+            });
+            next_task_ = first + count;
+            
+            for (auto& hits : task_hits) {
+                batch.insert(batch.end(), std::make_move_iterator(hits.begin()), std::make_move_iterator(hits.end()));
+            }
+        }
+        
+        if (limit_ > 0 && delivered_ + batch.size() >= limit_) {
+            batch.resize(limit_ - delivered_);
+            control_.Stop(ScanStatus::ResultLimit);
+        }
+        
+        delivered_ += batch.size();
+        return !batch.empty();
+    }
+    
     template<typename T>
     std::optional<T> MemoryScanner::ReadValue(MemoryAddress address) {
         T value;
-        if (process_mgr_->ReadMemory(address, &value, sizeof(T))) {
+        if (ReadRaw(address, &value, sizeof(T))) {
             return value;
         }
         return std::nullopt;
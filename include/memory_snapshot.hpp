@@ -0,0 +1,124 @@
+#pragma once
+
+#include "common.hpp"
+#include "mapped_file.hpp"
+#include "memory_source.hpp"
+
+namespace MemoryForensics {
+    
+    // Regions of a process captured into one file, for analysis without the
+    // process. The file is mapped, not loaded: reads find their region by binary
+    // search and their block by index, so any address is reached in O(log n)
+    // however large the capture. Blocks of BLOCK_SIZE bytes are stored zero
+    // (no data), raw or compressed with BlockCodec; raw runs are scanned in
+    // place through Map(), whole compressed blocks decode straight into the
+    // reader's buffer, and smaller reads share a per-thread decoded block.
+    //
+    // File layout (little endian, tables 8-byte aligned):
+    //   FileHeader
+    //   block data, in region and address order
+    //   RegionRecord[region_count]   sorted by base
+    //   ModuleRecord[module_count]
+    //   names of regions and modules, back to back
+    //   BlockRecord[block_count]     the page index
+    class MemorySnapshot : public MemorySource {
+    public:
+        struct CaptureStats {
+            size_t regions = 0;
+            size_t blocks = 0;
+            size_t zero_blocks = 0;
+            size_t compressed_blocks = 0;
+            uint64_t bytes = 0;             // Captured address space
+            uint64_t unreadable_bytes = 0;  // Pages that could not be read, stored as zeros
+            uint64_t file_bytes = 0;
+        };
+        
+        // Reads regions from source, with its modules, and writes them to path
+        static std::optional<CaptureStats> Capture(MemorySource& source, const std::vector<MemoryRegion>& regions,
+                                                   const std::string& path, bool compress = true);
+        
+        // nullptr if path is not a readable snapshot
+        static std::shared_ptr<MemorySnapshot> Open(const std::string& path);
+        
+        bool ReadInto(MemoryAddress address, Span<uint8_t> buffer) override;
+        Span<const uint8_t> Map(MemoryAddress address, size_t size) override;
+        std::vector<MemoryRegion> Regions(RegionFilterStats* stats = nullptr) override;
+        std::shared_ptr<const RegionMap> GetRegionMap() override { return region_map_; }
+        std::vector<ModuleInfo> Modules() override { return modules_; }
+        
+        ProcessID GetProcessID() const { return process_id_; }
+        uint64_t CapturedBytes() const;
+        
+        static constexpr size_t BLOCK_SIZE = 0x10000;
+        static constexpr size_t PAGES_PER_BLOCK = BLOCK_SIZE / REMOTE_PAGE_SIZE;
+        static constexpr size_t CAPTURE_BATCH_BLOCKS = 16;     // Blocks read per round trip
+        
+    private:
+        enum class Encoding : uint8_t {
+            Zero = 0,
+            Raw = 1,
+            Compressed = 2
+        };
+        
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t block_size;
+            uint64_t process_id;
+            uint32_t region_count;
+            uint32_t module_count;
+            uint64_t block_count;
+            uint64_t regions_offset;
+            uint64_t modules_offset;
+            uint64_t names_offset;
+            uint64_t names_size;
+            uint64_t blocks_offset;
+        };
+        
+        struct RegionRecord {
+            uint64_t base;
+            uint64_t size;
+            uint32_t protection;
+            uint32_t type;
+            uint32_t name_offset;       // Into the names
+            uint32_t name_length;
+            uint64_t first_block;
+        };
+        
+        struct ModuleRecord {
+            uint64_t base;
+            uint64_t size;
+            uint32_t name_offset;
+            uint32_t name_length;
+        };
+        
+        struct BlockRecord {
+            uint64_t offset;            // File offset of the stored bytes
+            uint32_t stored_size;
+            uint8_t encoding;
+            uint8_t reserved;
+            uint16_t missing_pages;     // Bit n: page n of the block was unreadable
+        };
+        
+        static_assert(PAGES_PER_BLOCK <= 16, "missing_pages holds one bit per page");
+        
+        static constexpr char FILE_MAGIC[8] = { 'M', 'F', 'S', 'N', 'A', 'P', 'S', 'H' };
+        static constexpr uint32_t FILE_VERSION = 1;
+        
+        MappedFile file_;
+        uint64_t id_ = 0;                     // Tells apart snapshots in the per-thread block cache
+        ProcessID process_id_ = 0;
+        const RegionRecord* region_records_ = nullptr;
+        const BlockRecord* blocks_ = nullptr;
+        std::vector<MemoryRegion> regions_;   // Sorted by base
+        std::vector<ModuleInfo> modules_;
+        std::shared_ptr<const RegionMap> region_map_;
+        
+        // Index of the region holding address, or regions_.size()
+        size_t FindRegion(MemoryAddress address) const;
+        
+        // Bytes [offset, offset + size) of a block; false if unreadable or corrupt
+        bool ReadBlock(size_t block, size_t block_size, size_t offset, uint8_t* output, size_t size) const;
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "common.hpp"
+#include "mapped_file.hpp"
+#include "page_cache.hpp"
+#include "process_manager.hpp"
+#include "region_map.hpp"
+#include "span.hpp"
+
+namespace MemoryForensics {
+    
+    struct ModuleInfo {
+        MemoryAddress base;
+        size_t size;
+        std::string name;
+    };
+    
+    // Address space the analysis code reads from: a live process, or captured
+    // memory such as a dump file. Reads fill caller-owned buffers, and sources
+    // that keep the bytes addressable hand them out through Map() so scans run
+    // on them in place. Implementations must allow concurrent reads.
+    class MemorySource {
+    public:
+        virtual ~MemorySource() = default;
+        
+        // Fill buffer with the bytes at address; false if any of them is unavailable
+        virtual bool ReadInto(MemoryAddress address, Span<uint8_t> buffer) = 0;
+        
+        // Same contract as ProcessManager::ReadMemoryBatch; one ReadInto per request by default
+        virtual size_t ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete = {});
+        
+        // The bytes of [address, address + size) without a copy, valid while the
+        // source lives; empty when they are not all directly addressable
+        virtual Span<const uint8_t> Map(MemoryAddress address, size_t size);
+        
+        // Regions a scan covers when none are set explicitly
+        virtual std::vector<MemoryRegion> Regions(RegionFilterStats* stats = nullptr) = 0;
+        
+        // Every region, for address lookups; built from Regions() by default
+        virtual std::shared_ptr<const RegionMap> GetRegionMap();
+        
+        // Loaded modules, and the base of one by name (exact, then ignoring case)
+        virtual std::vector<ModuleInfo> Modules() { return {}; }
+        virtual std::optional<MemoryAddress> ModuleBase(const std::string& name);
+        
+        // Whether reads reach a running process. Residency queries, change
+        // tracking and page caches only apply to live sources.
+        virtual bool IsLive() const { return false; }
+        
+        template<typename T>
+        std::optional<T> Read(MemoryAddress address);
+        
+        template<typename T>
+        std::optional<std::vector<T>> ReadArray(MemoryAddress address, size_t count);
+    };
+    
+    // The attached process, read through ProcessManager
+    class ProcessMemorySource : public MemorySource {
+    public:
+        explicit ProcessMemorySource(std::shared_ptr<ProcessManager> process_mgr) : process_mgr_(process_mgr) {}
+        
+        bool ReadInto(MemoryAddress address, Span<uint8_t> buffer) override;
+        size_t ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete = {}) override;
+        std::vector<MemoryRegion> Regions(RegionFilterStats* stats = nullptr) override;
+        std::shared_ptr<const RegionMap> GetRegionMap() override;
+        std::vector<ModuleInfo> Modules() override;
+        std::optional<MemoryAddress> ModuleBase(const std::string& name) override;
+        bool IsLive() const override { return true; }
+        
+        std::shared_ptr<ProcessManager> GetProcessManager() const { return process_mgr_; }
+        
+    private:
+        std::shared_ptr<ProcessManager> process_mgr_;
+    };
+    
+    // Another source with its reads going through a page cache first
+    class CachedMemorySource : public MemorySource {
+    public:
+        CachedMemorySource(std::shared_ptr<PageCache> cache, std::shared_ptr<MemorySource> source)
+            : cache_(cache), source_(source) {}
+        
+        bool ReadInto(MemoryAddress address, Span<uint8_t> buffer) override;
+        size_t ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete = {}) override;
+        Span<const uint8_t> Map(MemoryAddress address, size_t size) override { return source_->Map(address, size); }
+        std::vector<MemoryRegion> Regions(RegionFilterStats* stats = nullptr) override { return source_->Regions(stats); }
+        std::shared_ptr<const RegionMap> GetRegionMap() override { return source_->GetRegionMap(); }
+        std::vector<ModuleInfo> Modules() override { return source_->Modules(); }
+        std::optional<MemoryAddress> ModuleBase(const std::string& name) override { return source_->ModuleBase(name); }
+        bool IsLive() const override { return source_->IsLive(); }
+        
+    private:
+        std::shared_ptr<PageCache> cache_;
+        std::shared_ptr<MemorySource> source_;
+    };
+    
+    // Raw memory dump (a file holding one contiguous range of the target),
+    // mapped at the address its first byte had. Every read is served from
+    // the mapping, and Map() returns pointers straight into it.
+    class MappedDumpSource : public MemorySource {
+    public:
+        // nullptr if the file cannot be mapped
+        static std::shared_ptr<MappedDumpSource> Open(const std::string& path, MemoryAddress base_address);
+        
+        bool ReadInto(MemoryAddress address, Span<uint8_t> buffer) override;
+        Span<const uint8_t> Map(MemoryAddress address, size_t size) override;
+        std::vector<MemoryRegion> Regions(RegionFilterStats* stats = nullptr) override;
+        std::shared_ptr<const RegionMap> GetRegionMap() override { return region_map_; }
+        
+        MemoryAddress GetBaseAddress() const { return base_address_; }
+        size_t Size() const { return file_.Size(); }
+        
+    private:
+        MappedFile file_;
+        MemoryAddress base_address_ = 0;
+        std::string name_;
+        std::shared_ptr<const RegionMap> region_map_;
+    };
+    
+    // Template implementation
+    template<typename T>
+    std::optional<T> MemorySource::Read(MemoryAddress address) {
+        T value;
+        if (ReadInto(address, AsWritableBytes(value))) {
+            return value;
+        }
+        return std::nullopt;
+    }
+    
+    template<typename T>
+    std::optional<std::vector<T>> MemorySource::ReadArray(MemoryAddress address, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "arrays are read as raw bytes");
+        if (count == 0) {
+            return std::vector<T>();
+        }
+        if (count > MAX_READ_SIZE / sizeof(T)) {
+            return std::nullopt;
+        }
+        
+        std::vector<T> values(count);
+        if (!ReadInto(address, { reinterpret_cast<uint8_t*>(values.data()), count * sizeof(T) })) {
+            return std::nullopt;
+        }
+        return values;
+    }
+    
+} // namespace MemoryForensics
@@ -43,6 +43,9 @@ struct ObscuredBigIntegerData {
 
 class ObscuredBigIntegerReader {
 public:
+    explicit ObscuredBigIntegerReader(std::shared_ptr<MemorySource> source);
+    
+    // Reads through the scanner's read source as it is at construction
     explicit ObscuredBigIntegerReader(std::shared_ptr<MemoryScanner> scanner);
     ~ObscuredBigIntegerReader() = default;
     
@@ -65,7 +68,7 @@ public:
     std::string DecryptedValueToHex(const ObscuredBigIntegerData& obscured);
 
 private:
-    std::shared_ptr<MemoryScanner> scanner_;
+    std::shared_ptr<MemorySource> source_;
     std::shared_ptr<DotNetBigIntegerReader> bigint_reader_;
     
     // Helper methods for reading structures
@@ -73,6 +76,7 @@ private:
                                                                    const std::string& field_name);
     std::optional<BigIntegerContents> ReadBigIntegerContents(MemoryAddress address, 
                                                            const std::string& field_name);
+    SerializableBigInteger BuildSerializableBigInteger(const BigIntegerContents& contents);
     
     // Decryption algorithm implementation (SymmetricShuffle)
     SerializableBigInteger DecryptSerializableBigInteger(const SerializableBigInteger& encrypted, 
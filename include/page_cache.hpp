@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common.hpp"
+#include "process_manager.hpp"
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+
+namespace MemoryForensics {
+    
+    // Read-through cache of remote 4KB pages in front of ProcessManager::ReadMemory.
+    // Entries are tagged with an epoch; advancing the epoch ("tick") invalidates
+    // everything in O(1), stale pages are dropped lazily on their next lookup.
+    class PageCache {
+    public:
+        struct Statistics {
+            uint64_t hits = 0;          // Page segments of reads served from the cache
+            uint64_t misses = 0;        // Page segments that had to be fetched
+            uint64_t evictions = 0;
+            uint64_t bypassed = 0;      // Reads too large to cache
+            uint64_t epoch = 0;
+            size_t resident_pages = 0;
+            size_t capacity_pages = 0;
+        };
+        
+        PageCache(std::shared_ptr<ProcessManager> process_mgr, size_t capacity_bytes);
+        ~PageCache() = default;
+        
+        // Cached memory operations (same contract as ProcessManager)
+        bool ReadMemory(MemoryAddress address, void* buffer, size_t size);
+        size_t ReadMemoryBatch(std::vector<ReadRequest>& requests);
+        
+        // Invalidation
+        uint64_t AdvanceEpoch();
+        void Invalidate(MemoryAddress address, size_t size);  // Drops the pages overlapping the range
+        uint64_t GetEpoch() const { return epoch_.load(std::memory_order_acquire); }
+        void Clear();
+        
+        // Statistics
+        Statistics GetStatistics() const;
+        void ResetStatistics();
+        
+        // The cache drops pages written through process_mgr as the writes happen
+        static std::shared_ptr<PageCache> FromConfig(std::shared_ptr<ProcessManager> process_mgr,
+                                                     const nlohmann::json& config);
+        
+        // Reads above this size (region scans) go straight to the process
+        static constexpr size_t MAX_CACHED_READ = 0x10000;
+        static constexpr size_t SHARD_COUNT = 16;
+    
+    private:
+        struct Page {
+            MemoryAddress page_address;
+            uint64_t epoch;
+            std::array<uint8_t, REMOTE_PAGE_SIZE> data;
+        };
+        
+        // Each shard is an independent LRU so concurrent readers rarely contend
+        struct Shard {
+            mutable std::mutex mutex;
+            std::list<Page> lru;  // Most recently used at the front
+            std::unordered_map<MemoryAddress, std::list<Page>::iterator> index;
+            std::atomic<uint64_t> invalidations{0};   // Bumped by Invalidate and Clear
+        };
+        
+        // Cache state a fetch started from. Pages it read are only inserted while
+        // it is still current: a tick or a write that lands during the fetch may
+        // have changed them, and its invalidation has already run.
+        struct Generation {
+            uint64_t epoch;
+            std::array<uint64_t, SHARD_COUNT> invalidations;
+        };
+        
+        std::shared_ptr<ProcessManager> process_mgr_;
+        std::array<Shard, SHARD_COUNT> shards_;
+        size_t pages_per_shard_;
+        std::atomic<uint64_t> epoch_{0};
+        std::atomic<ProcessID> cached_pid_{0};
+        
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> evictions_{0};
+        std::atomic<uint64_t> bypassed_{0};
+        
+        Shard& ShardFor(MemoryAddress page_address);
+        bool CopyFromPage(MemoryAddress page_address, size_t offset, uint8_t* dest, size_t length);
+        Generation CurrentGeneration() const;
+        void InsertPage(MemoryAddress page_address, const uint8_t* data, const Generation& fetched);
+        void SyncWithProcess();
+    };
+    
+} // namespace MemoryForensics
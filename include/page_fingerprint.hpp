@@ -0,0 +1,111 @@
+#pragma once
+
+#include "common.hpp"
+#include "pattern_matcher.hpp"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace MemoryForensics {
+    
+    // 64-bit content hash for page-sized buffers. Eight multiply-accumulate lanes
+    // consume 64-byte stripes (AVX2/SSE2, chosen at runtime, scalar elsewhere);
+    // every kernel produces the same value. Fast, not collision resistant.
+    uint64_t HashPage(const uint8_t* data, size_t size);
+    
+    // Pattern hits of the pages a scan session has seen, keyed by page content.
+    // A rescan hashes each page and reuses the stored hits when the content was
+    // seen before, whether the page is unchanged or identical to another one
+    // (zero pages, duplicated buffers), so a mostly static heap costs reads and
+    // hashing rather than matching. A hit belongs to the page holding its last
+    // byte, and the key also covers the bytes before the page it can start in.
+    class PageFingerprints {
+    public:
+        struct Key {
+            uint64_t page;          // HashPage of the page
+            uint64_t lookbehind;    // HashPage of the bytes before it that a hit may start in
+            uint32_t phase;         // Page offset from the alignment origin, modulo the alignment
+            
+            bool operator==(const Key& other) const {
+                return page == other.page && lookbehind == other.lookbehind && phase == other.phase;
+            }
+        };
+        
+        struct Statistics {
+            uint64_t pages_reused = 0;      // Hits taken from a stored page
+            uint64_t pages_matched = 0;     // Matched and stored
+            uint64_t hits_reused = 0;
+            size_t tables = 0;
+            size_t entries = 0;
+        };
+        
+        // Stored pages of one pattern at one alignment. Entries not used by the
+        // previous scan are dropped when the next one begins, so a table tracks
+        // the live footprint of the target rather than its history.
+        class Table {
+        public:
+            // Hit offsets relative to the page; starts may precede it
+            using Offsets = std::vector<int16_t>;
+            
+            // Same hits as matcher.FindAll; whole pages of data are looked up
+            // by content and only matched when no stored page has that content
+            void FindAll(const PatternMatcher& matcher, const uint8_t* data, size_t size, MemoryAddress address,
+                         MemoryAddress align_origin, std::vector<MemoryAddress>& results);
+            
+            bool Lookup(const Key& key, Offsets& offsets);
+            void Store(const Key& key, Offsets offsets);
+            size_t Size() const;
+            
+            static constexpr size_t SHARD_COUNT = 16;
+            
+        private:
+            friend class PageFingerprints;
+            
+            struct KeyHash {
+                size_t operator()(const Key& key) const {
+                    return static_cast<size_t>(key.page ^ (key.lookbehind * 0x9E3779B97F4A7C15ULL) ^ key.phase);
+                }
+            };
+            
+            struct Entry {
+                Offsets offsets;
+                uint64_t generation;
+            };
+            
+            // Independent maps so concurrent workers rarely contend
+            struct Shard {
+                mutable std::mutex mutex;
+                std::unordered_map<Key, Entry, KeyHash> entries;
+            };
+            
+            PageFingerprints& owner_;
+            std::array<Shard, SHARD_COUNT> shards_;
+            std::atomic<uint64_t> generation_{0};
+            uint64_t last_used_ = 0;        // Owner's scan count when last begun
+            
+            explicit Table(PageFingerprints& owner) : owner_(owner) {}
+            
+            Shard& ShardFor(const Key& key) { return shards_[(KeyHash()(key) >> 40) % SHARD_COUNT]; }
+            void BeginScan();
+        };
+        
+        // Table for the next scan of a pattern; key names the pattern and alignment
+        std::shared_ptr<Table> BeginScan(const std::string& key);
+        
+        void Clear();
+        Statistics GetStatistics() const;
+        
+        // Patterns whose tables are kept; the least recently scanned goes first
+        static constexpr size_t MAX_TABLES = 16;
+        
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<Table>> tables_;
+        uint64_t scans_ = 0;
+        
+        std::atomic<uint64_t> pages_reused_{0};
+        std::atomic<uint64_t> pages_matched_{0};
+        std::atomic<uint64_t> hits_reused_{0};
+    };
+    
+} // namespace MemoryForensics
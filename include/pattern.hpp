@@ -0,0 +1,68 @@
+#pragma once
+
+#include "common.hpp"
+#include <array>
+
+namespace MemoryForensics {
+    
+    // A compiled byte pattern. Every byte carries a bit mask (0xFF fixed, 0xF0 or
+    // 0x0F for nibble wildcards like "4?", 0x00 for "??"), and the constructor
+    // precomputes how the pattern is best searched for.
+    class Pattern {
+    public:
+        enum class Strategy {
+            Anchor,     // SIMD compare of the two rarest fixed bytes, then verify
+            Horspool,   // Skip-table search over a long fixed run, then verify
+            Wildcard    // No fully fixed byte: every offset is verified
+        };
+        
+        struct Plan {
+            Strategy strategy = Strategy::Wildcard;
+            size_t anchor = 0;          // Offset of the rarest fixed byte
+            size_t second_anchor = 0;   // Offset of the next rarest fixed byte
+            size_t run_offset = 0;      // Longest run of fixed bytes
+            size_t run_length = 0;
+            std::array<uint8_t, 256> skip{};   // Horspool shifts for the run (capped at 255)
+        };
+        
+        Pattern() = default;
+        
+        // mask[i] selects the bits of bytes[i] that must match; missing mask bytes are 0xFF
+        Pattern(const ByteVector& bytes, const ByteVector& mask);
+        
+        // "48 8B ?? 4? ?5", "488B??05" or IDA style single "?" wildcards
+        static std::optional<Pattern> Parse(const std::string& text);
+        
+        // Legacy byte/mask pairs where mask[i] == 0 is a wildcard and anything else is exact
+        static Pattern FromBytes(const ByteVector& bytes, const ByteVector& mask = {});
+        
+        size_t Length() const { return bytes_.size(); }
+        bool Empty() const { return bytes_.empty(); }
+        const ByteVector& Bytes() const { return bytes_; }   // Pre-masked
+        const ByteVector& Mask() const { return mask_; }
+        const Plan& GetPlan() const { return plan_; }
+        
+        bool IsFixed(size_t index) const { return mask_[index] == 0xFF; }
+        bool Matches(const uint8_t* data) const;
+        
+        std::string ToString() const;
+        
+        // Fixed runs at least this long are searched with Horspool; below this the
+        // two-byte SIMD anchor scan is faster on cache-resident chunks
+        static constexpr size_t HORSPOOL_MIN_RUN = 128;
+    
+    private:
+        ByteVector bytes_;
+        ByteVector mask_;
+        Plan plan_;
+        
+        void BuildPlan();
+    };
+    
+    // Named pattern loaded from configuration or added at runtime
+    struct Signature {
+        std::string name;
+        Pattern pattern;
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common.hpp"
+#include "pattern.hpp"
+
+namespace MemoryForensics {
+    
+    // Executes a Pattern's plan over a local buffer. Anchor plans compare the two
+    // rarest fixed bytes across 32/64 offsets per step (SSE2/AVX2, chosen at
+    // runtime, memchr-driven scalar elsewhere); Horspool plans skip through the
+    // longest fixed run. Candidates are confirmed with a vector masked compare.
+    class PatternMatcher {
+    public:
+        // Only matches at offsets that are a multiple of alignment from the origin are reported
+        explicit PatternMatcher(const Pattern& pattern, size_t alignment = 1);
+        
+        // Append the address of every match that lies entirely inside data[0, size)
+        void FindAll(const uint8_t* data, size_t size, MemoryAddress address,
+                     MemoryAddress align_origin, std::vector<MemoryAddress>& results) const;
+        
+        size_t Length() const { return length_; }
+        size_t Alignment() const { return alignment_; }
+        bool Empty() const { return length_ == 0; }
+        
+        // Name of the kernel selected for this CPU ("avx2", "sse2" or "scalar")
+        static const char* ActiveKernel();
+    
+    private:
+        using Kernel = void (PatternMatcher::*)(const uint8_t* data, size_t size, size_t phase,
+                                                std::vector<size_t>& hits) const;
+        
+        Pattern pattern_;
+        size_t length_ = 0;
+        size_t padded_length_ = 0;   // length_ rounded up to the 16-byte verify block
+        ByteVector bytes_;           // Masked pattern, zero padded to padded_length_
+        ByteVector mask_;            // Per-byte bit mask, zero padded to padded_length_
+        size_t anchor_ = 0;
+        size_t second_anchor_ = 0;
+        size_t alignment_ = 1;
+        
+        bool IsAligned(size_t phase, size_t position) const;
+        bool Verify(const uint8_t* candidate, size_t available) const;
+        
+        void FindScalar(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        void FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        void FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        void FindHorspool(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        
+        static Kernel SelectKernel();
+    };
+    
+} // namespace MemoryForensics
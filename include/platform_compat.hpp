@@ -2,6 +2,7 @@
 
 // Platform compatibility layer for cross-platform compilation
 // This allows the Windows-focused memory forensics tool to compile on macOS for development
+// and to run natively on Linux hosts (e.g. against games running under Proton/Wine)
 
 #ifdef __APPLE__
     #define MACOS_BUILD
@@ -11,8 +12,8 @@
     #define LINUX_BUILD
 #endif
 
-#ifdef MACOS_BUILD
-    // macOS compatibility layer for Windows APIs
+#if defined(MACOS_BUILD) || defined(LINUX_BUILD)
+    // Windows type and constant definitions shared by the non-Windows builds
     #include <cstdint>
     #include <string>
     #include <vector>
@@ -28,6 +29,7 @@
     using LPVOID = void*;
     using LPCVOID = const void*;
     using SIZE_T = size_t;
+    using CHAR = char;
     
     // Windows constants
     #define TRUE 1
@@ -36,6 +38,7 @@
     #define MAX_PATH 260
     
     // Memory protection constants (dummy values for compilation)
+    #define PAGE_NOACCESS 0x01
     #define PAGE_READWRITE 0x04
     #define PAGE_READONLY 0x02
     #define PAGE_EXECUTE 0x10
@@ -43,6 +46,7 @@
     #define PAGE_EXECUTE_READWRITE 0x40
     #define PAGE_EXECUTE_WRITECOPY 0x80
     #define PAGE_WRITECOPY 0x08
+    #define PAGE_GUARD 0x100
     
     // Memory allocation constants
     #define MEM_COMMIT 0x1000
@@ -110,6 +114,17 @@
         SIZE_T PeakPagefileUsage;
     };
     
+    struct PSAPI_WORKING_SET_EX_INFORMATION {
+        LPVOID VirtualAddress;
+        struct {
+            uintptr_t Valid : 1;        // Page is in the working set
+            uintptr_t ShareCount : 3;
+            uintptr_t Win32Protection : 11;
+            uintptr_t Shared : 1;
+            uintptr_t Reserved : 48;
+        } VirtualAttributes;
+    };
+    
     // Language constants
     #define LANG_NEUTRAL 0x00
     #define SUBLANG_DEFAULT 0x01
@@ -120,6 +135,9 @@
     #define FORMAT_MESSAGE_FROM_SYSTEM 0x00001000
     #define FORMAT_MESSAGE_IGNORE_INSERTS 0x00000200
     
+#endif
+
+#ifdef MACOS_BUILD
     // Stub functions for Windows API (non-functional on macOS)
     inline HANDLE OpenProcess(DWORD, BOOL, DWORD) { return INVALID_HANDLE_VALUE; }
     inline BOOL CloseHandle(HANDLE) { return FALSE; }
@@ -133,11 +151,19 @@
     inline BOOL Module32Next(HANDLE, MODULEENTRY32*) { return FALSE; }
     inline BOOL QueryFullProcessImageNameA(HANDLE, DWORD, LPSTR, DWORD*) { return FALSE; }
     inline BOOL GetProcessMemoryInfo(HANDLE, PROCESS_MEMORY_COUNTERS*, DWORD) { return FALSE; }
+    inline BOOL QueryWorkingSetEx(HANDLE, LPVOID, DWORD) { return FALSE; }
     inline DWORD GetLastError() { return 0; }
     inline void SetLastError(DWORD) {}
     inline DWORD FormatMessageA(DWORD, LPCVOID, DWORD, DWORD, LPSTR, DWORD, va_list*) { return 0; }
     inline HANDLE LocalFree(HANDLE) { return nullptr; }
     
+#elif defined(LINUX_BUILD)
+    // Native Linux backend (see process_manager_linux.cpp) - uses /proc and process_vm_readv
+    #include <sys/types.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #include <cerrno>
+    
 #else
     // Windows build - include actual Windows headers
     #include <Windows.h>
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "common.hpp"
+#include "mapped_file.hpp"
+
+namespace MemoryForensics {
+    
+    // Every pointer-looking slot of a process together with the value it held,
+    // sorted by value for backward pointer searches. A map lives in memory after
+    // a capture, or is mapped straight from a file written by Save so paths from
+    // earlier sessions can be searched and checked without touching the process.
+    //
+    // File layout (little endian, every section 8-byte aligned):
+    //   FileHeader
+    //   ModuleRecord[module_count], then the module names back to back
+    //   Entry[entry_count]       sorted by value, then address
+    //   uint64_t[entry_count]    entry indices sorted by address
+    class PointerMap {
+    public:
+        struct Entry {
+            uint64_t value;
+            uint64_t address;
+        };
+        
+        struct Module {
+            MemoryAddress base;
+            MemoryAddress end;
+            std::string name;
+        };
+        
+        // Sorts the entries and builds the address index
+        PointerMap(std::vector<Entry> entries, std::vector<Module> modules);
+        
+        static std::shared_ptr<const PointerMap> Load(const std::string& path);
+        bool Save(const std::string& path) const;
+        
+        size_t Size() const { return count_; }
+        bool Empty() const { return count_ == 0; }
+        const std::vector<Module>& Modules() const { return modules_; }
+        
+        const Module* FindModule(MemoryAddress address) const;
+        std::optional<MemoryAddress> ModuleBase(const std::string& name) const;
+        
+        // Entries whose value lies in [low, high], as a [first, last) range
+        std::pair<const Entry*, const Entry*> PointingInto(MemoryAddress low, MemoryAddress high) const;
+        
+        // Value held by slot at capture time, if it looked like a pointer
+        std::optional<MemoryAddress> ValueAt(MemoryAddress slot) const;
+        
+        // Replays a path against the captured memory instead of the live process
+        std::optional<MemoryAddress> ResolvePath(const PointerPath& path) const;
+    
+    private:
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t module_count;
+            uint64_t entry_count;
+            uint64_t modules_offset;
+            uint64_t entries_offset;
+            uint64_t index_offset;
+        };
+        
+        struct ModuleRecord {
+            uint64_t base;
+            uint64_t size;
+            uint32_t name_offset;    // Relative to the end of the module records
+            uint32_t name_length;
+        };
+        
+        static constexpr char FILE_MAGIC[8] = { 'M', 'F', 'P', 'T', 'R', 'M', 'A', 'P' };
+        static constexpr uint32_t FILE_VERSION = 1;
+        
+        // Either owned storage or views into file_
+        std::vector<Entry> owned_entries_;
+        std::vector<uint64_t> owned_index_;
+        std::unique_ptr<MappedFile> file_;
+        const Entry* entries_ = nullptr;
+        const uint64_t* by_address_ = nullptr;
+        size_t count_ = 0;
+        std::vector<Module> modules_;     // Sorted by base
+        
+        PointerMap() = default;
+    };
+    
+} // namespace MemoryForensics
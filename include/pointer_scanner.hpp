@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common.hpp"
+#include "memory_scanner.hpp"
+#include "pointer_map.hpp"
+
+namespace MemoryForensics {
+    
+    struct PointerScanOptions {
+        size_t max_depth = 5;           // Dereferences per path
+        size_t max_offset = 0x1000;     // Largest field offset between links
+        size_t max_results = 10000;
+        size_t max_nodes = 1 << 22;     // Bound on the backward search frontier
+    };
+    
+    // Finds static pointer paths to a target address. BuildPointerMap sweeps the
+    // scan regions once, in parallel, and keeps every aligned 8-byte value that
+    // points into mapped memory, sorted by value. FindPaths then walks backwards
+    // from the target breadth first, so shorter paths are reported first.
+    //
+    // Maps can be saved and loaded again later. Searching a saved map for an
+    // old target and intersecting with today's paths (or keeping the old paths
+    // that still resolve) narrows thousands of candidates to the stable ones.
+    class PointerScanner {
+    public:
+        explicit PointerScanner(std::shared_ptr<MemoryScanner> scanner);
+        
+        // Replaces any previous map; false if the process has no regions
+        bool BuildPointerMap();
+        bool HasPointerMap() const { return map_ && !map_->Empty(); }
+        size_t GetPointerCount() const { return map_ ? map_->Size() : 0; }
+        
+        std::shared_ptr<const PointerMap> GetPointerMap() const { return map_; }
+        void SetPointerMap(std::shared_ptr<const PointerMap> map) { map_ = std::move(map); }
+        
+        std::vector<PointerPath> FindPaths(MemoryAddress target, const PointerScanOptions& options = {}) const;
+        static std::vector<PointerPath> FindPaths(const PointerMap& map, MemoryAddress target,
+                                                  const PointerScanOptions& options = {});
+        
+        // Paths present in both lists; module names compare case-insensitively
+        static std::vector<PointerPath> IntersectPaths(const std::vector<PointerPath>& a,
+                                                       const std::vector<PointerPath>& b);
+        
+        // Paths that still lead to target when replayed against map
+        static std::vector<PointerPath> KeepResolving(const std::vector<PointerPath>& paths,
+                                                      const PointerMap& map, MemoryAddress target);
+    
+    private:
+        // One slot of the backward search; value + offset == the parent's slot
+        struct Node {
+            MemoryAddress slot;
+            size_t parent;
+            size_t offset;
+        };
+        
+        std::shared_ptr<MemoryScanner> scanner_;
+        std::shared_ptr<const PointerMap> map_;
+        
+        static PointerPath MakePath(const std::vector<Node>& nodes, size_t index, const PointerMap::Module& module);
+        
+        static constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+        static constexpr size_t POINTER_ALIGNMENT = sizeof(MemoryAddress);
+    };
+    
+} // namespace MemoryForensics
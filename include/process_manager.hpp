@@ -1,9 +1,22 @@
 #pragma once
 
 #include "common.hpp"
+#include "region_filter.hpp"
+#include "region_map.hpp"
+#include "uring_read_engine.hpp"
+#include <functional>
+#include <mutex>
 
 namespace MemoryForensics {
     
+    // How ReadMemoryBatch reaches the target. io_uring keeps many reads of
+    // /proc/<pid>/mem in flight (Linux); everything else uses the platform's
+    // synchronous call.
+    enum class ReadBackend {
+        Synchronous,
+        IoUring
+    };
+    
     class ProcessManager {
     public:
         ProcessManager();
@@ -17,13 +30,54 @@ namespace MemoryForensics {
         // Process information
         ProcessID GetProcessID() const { return process_id_; }
         HANDLE GetProcessHandle() const { return process_handle_; }
-        bool IsAttached() const { return process_handle_ != nullptr; }
+        bool IsAttached() const { return process_id_ != 0; }
         
         // Memory operations
-        std::vector<MemoryRegion> EnumerateMemoryRegions();
+        std::vector<MemoryRegion> EnumerateMemoryRegions();  // Refreshes the region map
+        
+        // Region map built on attach; lookups need no syscalls. Refresh after the
+        // target allocates or frees memory - the ranged form only re-queries [start, end)
+        std::shared_ptr<const RegionMap> GetRegionMap();
+        std::shared_ptr<const RegionMap> RefreshRegionMap();
+        std::shared_ptr<const RegionMap> RefreshRegionMap(MemoryAddress start, MemoryAddress end);
+        
+        // Region filter policy. The filtered view is evaluated once per region map,
+        // so it is recomputed only after an attach, a refresh or a new filter.
+        void SetRegionFilter(const RegionFilter& filter);
+        RegionFilter GetRegionFilter();
+        std::vector<MemoryRegion> GetFilteredRegions(RegionFilterStats* stats = nullptr);
+        std::vector<MemoryRegion> FilterRegions(const std::vector<MemoryRegion>& regions, RegionFilterStats* stats = nullptr);
+        
         bool ReadMemory(MemoryAddress address, void* buffer, size_t size);
+        // Returns number of successful reads; on_complete hears of each request once it is finished
+        size_t ReadMemoryBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete = {});
         bool WriteMemory(MemoryAddress address, const void* buffer, size_t size);
         
+        // Called after every successful WriteMemory with the written range, so
+        // caches of target memory can drop the bytes it changed
+        using WriteListener = std::function<void(MemoryAddress address, size_t size)>;
+        void AddWriteListener(WriteListener listener);
+        
+        // Backend for ReadMemoryBatch, kept across attaches; false (and no change)
+        // when it is unavailable. Not to be switched while a scan is reading.
+        bool SetReadBackend(ReadBackend backend);
+        ReadBackend GetReadBackend() const { return read_backend_; }
+        
+        // Write tracking through the kernel's soft-dirty bits (Linux only; fails
+        // elsewhere). ClearWrittenPages resets the bits of the whole process, after
+        // which QueryWrittenPages returns the coalesced [start, end) runs of pages
+        // in regions that were written or newly mapped since.
+        bool ClearWrittenPages();
+        std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> QueryWrittenPages(
+            const std::vector<MemoryRegion>& regions);
+        
+        // Coalesced [start, end) runs of pages in regions that hold data: resident
+        // or swapped out on Linux (pagemap), in the working set on Windows
+        // (QueryWorkingSetEx). Other pages of private memory were never touched
+        // and read back as zeros. nullopt when residency cannot be queried.
+        std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> QueryResidentPages(
+            const std::vector<MemoryRegion>& regions);
+        
         // Process enumeration
         static std::vector<std::pair<ProcessID, std::string>> ListRunningProcesses();
         static std::optional<ProcessID> FindProcessByName(const std::string& name);
@@ -37,8 +91,35 @@ namespace MemoryForensics {
         HANDLE process_handle_;
         std::string process_name_;
         
+        ReadBackend read_backend_ = ReadBackend::Synchronous;
+        std::unique_ptr<UringReadEngine> uring_engine_;     // Open while attached with the io_uring backend
+        
+        std::shared_ptr<const RegionMap> region_map_;
+        std::mutex region_map_mutex_;
+        
+        RegionFilter region_filter_;
+        std::shared_ptr<const RegionMap> filtered_source_;   // Map the cached view was built from
+        std::vector<MemoryRegion> filtered_regions_;
+        RegionFilterStats filter_stats_;
+        std::optional<std::vector<RegionFilter::ModuleRange>> module_ranges_;  // Fetched on first use
+        std::mutex filter_mutex_;
+        
+        std::vector<WriteListener> write_listeners_;
+        std::mutex write_listeners_mutex_;
+        
+        const std::vector<RegionFilter::ModuleRange>& ModuleRangesLocked();
+        void ResetFilterCache();
+        void NotifyWrite(MemoryAddress address, size_t size);
+        
         bool ValidateProcessAccess();
         void LogProcessInfo();
+        
+        // Committed regions overlapping [start, end), queried from the OS
+        std::vector<RegionMap::Entry> QueryRegionEntries(MemoryAddress start, MemoryAddress end);
+        
+        // Region naming shared by all platform backends (e.g. "PRIVATE_RW")
+        static std::string BuildRegionName(DWORD type, DWORD protection);
+        friend class RegionMap;
     };
     
 } // namespace MemoryForensics
\ No newline at end of file
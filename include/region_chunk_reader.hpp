@@ -0,0 +1,99 @@
+#pragma once
+
+#include "common.hpp"
+#include "memory_source.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace MemoryForensics {
+    
+    // Streams a region in SCAN_CHUNK_SIZE pieces instead of one large read.
+    // A worker thread keeps up to READ_AHEAD chunks in flight as one batch, and
+    // each chunk is handed to the caller as soon as its own read completes, so
+    // matching overlaps the reads still outstanding. Unreadable pages are
+    // skipped individually, and the last `overlap` bytes of each span are
+    // carried into the next contiguous span so that matches straddling a chunk
+    // boundary are still seen. When the source can map the whole region, it is
+    // handed out as a single span in place.
+    class RegionChunkReader {
+    public:
+        // Contiguous readable bytes; valid until the next call to Next()
+        struct Span {
+            MemoryAddress address;
+            const uint8_t* data;
+            size_t size;
+        };
+        
+        explicit RegionChunkReader(std::shared_ptr<MemorySource> source,
+                                   size_t chunk_size = SCAN_CHUNK_SIZE, size_t read_ahead = READ_AHEAD);
+        ~RegionChunkReader();
+        
+        RegionChunkReader(const RegionChunkReader&) = delete;
+        RegionChunkReader& operator=(const RegionChunkReader&) = delete;
+        
+        // Start streaming [base, base + size), abandoning any previous region
+        void Begin(MemoryAddress base, size_t size, size_t overlap);
+        
+        // Next readable span of the region; false once the region is exhausted
+        bool Next(Span& span);
+        
+        // Bytes of the current region that could not be read
+        size_t GetSkippedBytes() const { return skipped_bytes_; }
+        
+        // Chunks in flight by default: a whole scan task, enough to fill an
+        // io_uring queue with its pieces
+        static constexpr size_t READ_AHEAD = 16;
+    
+    private:
+        enum class ChunkState {
+            Free,       // Not part of any read
+            Reading,    // Submitted to the worker
+            Read,       // Every byte arrived
+            Failed      // Some page was unreadable; read again page by page
+        };
+        
+        struct Chunk {
+            MemoryAddress address = 0;
+            size_t size = 0;
+            ChunkState state = ChunkState::Free;
+            ByteVector storage;                                  // overlap headroom + chunk data
+            std::vector<std::pair<size_t, size_t>> runs;         // readable [offset, length) pairs
+            
+            uint8_t* Data(size_t headroom) { return storage.data() + headroom; }
+        };
+        
+        std::shared_ptr<MemorySource> source_;
+        size_t chunk_size_;
+        
+        // Region state; the counters are shared with the worker under mutex_.
+        // Chunk number n of the region lives in chunks_[n % chunks_.size()].
+        MemoryAddress region_base_ = 0;
+        MemoryAddress region_end_ = 0;
+        size_t overlap_ = 0;
+        size_t skipped_bytes_ = 0;
+        std::vector<Chunk> chunks_;
+        size_t chunk_count_ = 0;        // Chunks of the region still to be read
+        size_t submitted_ = 0;          // Chunks handed to the worker
+        size_t released_ = 0;           // Chunks the caller is done with
+        size_t next_chunk_ = 0;         // Chunk the caller takes next
+        Chunk* current_ = nullptr;      // Chunk being handed out as spans
+        size_t current_run_ = 0;
+        ByteVector carry_;
+        MemoryAddress carry_end_ = 0;
+        MemoryAddress mapped_address_ = 0;
+        MemoryForensics::Span<const uint8_t> mapped_;    // Whole region from Map(), until handed out
+        
+        // Read-ahead worker
+        std::thread worker_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool reading_ = false;          // A batch is in flight
+        bool stop_ = false;
+        
+        void WorkerLoop();
+        void ReadByPage(Chunk& chunk);
+        void ReleaseCurrent();
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace MemoryForensics {
+    
+    // What a filter pass kept and dropped; trimmed exclusion ranges count as skipped
+    struct RegionFilterStats {
+        size_t kept_regions = 0;
+        size_t skipped_regions = 0;
+        uint64_t kept_bytes = 0;
+        uint64_t skipped_bytes = 0;
+    };
+    
+    // Declarative policy that decides which committed regions are worth scanning.
+    // Every test but the module lists looks only at the region itself; module
+    // tests need the loaded-module extents, built once with ModuleRanges.
+    struct RegionFilter {
+        struct ModuleRange {
+            MemoryAddress base;
+            MemoryAddress end;
+            std::string name;
+        };
+        
+        bool skip_readonly = false;     // Drop regions that cannot be written
+        bool skip_executable = false;
+        bool skip_guard = true;         // Guard and no-access pages fault on read
+        bool include_image = true;      // MEM_IMAGE: executables and loaded libraries
+        bool include_mapped = true;     // MEM_MAPPED: file and section views
+        bool include_private = true;    // MEM_PRIVATE: heaps, stacks, GC segments
+        size_t min_size = 0;
+        size_t max_size = 0;            // 0 = unlimited
+        
+        // Module names compare case-insensitively. An allow list only restricts
+        // image regions, so heaps stay in scope while other libraries are dropped.
+        std::vector<std::string> modules;
+        std::vector<std::string> exclude_modules;
+        std::vector<std::pair<MemoryAddress, MemoryAddress>> exclude_ranges;  // [start, end)
+        
+        bool NeedsModules() const { return !modules.empty() || !exclude_modules.empty(); }
+        
+        // Region-level test; module is the owning module's name, or null
+        bool Accepts(const MemoryRegion& region, const std::string* module) const;
+        
+        // Regions that pass, with exclusion ranges cut out of them
+        std::vector<MemoryRegion> Apply(const std::vector<MemoryRegion>& regions,
+                                        const std::vector<ModuleRange>& module_ranges,
+                                        RegionFilterStats* stats = nullptr) const;
+        
+        // memory_scanning.skip_readonly_regions and memory_scanning.region_filter
+        static RegionFilter FromConfig(const nlohmann::json& config);
+        
+        // Sorted extents for Apply
+        static std::vector<ModuleRange> ModuleRanges(const std::vector<MODULEENTRY32>& modules);
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace MemoryForensics {
+    
+    // Immutable, address-sorted view of a process address space. Region data is
+    // kept in parallel arrays so lookups only touch the compact start/end keys,
+    // and region names are interned per (type, protection) pair.
+    class RegionMap {
+    public:
+        struct Entry {
+            MemoryAddress base_address;
+            size_t size;
+            DWORD protection;
+            DWORD type;
+        };
+        
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        
+        RegionMap() = default;
+        explicit RegionMap(std::vector<Entry> entries);
+        
+        // Index of the region containing address, or npos (O(log n), branchless)
+        size_t Find(MemoryAddress address) const;
+        bool Contains(MemoryAddress address) const { return Find(address) != npos; }
+        
+        // Whether [address, address + size) lies entirely in mapped regions with
+        // read access and no guard pages
+        bool IsReadable(MemoryAddress address, size_t size) const;
+        
+        // Region accessors
+        size_t Size() const { return starts_.size(); }
+        bool Empty() const { return starts_.empty(); }
+        MemoryAddress BaseAt(size_t index) const { return starts_[index]; }
+        MemoryAddress EndAt(size_t index) const { return ends_[index]; }
+        size_t SizeAt(size_t index) const { return static_cast<size_t>(ends_[index] - starts_[index]); }
+        DWORD ProtectionAt(size_t index) const { return protections_[index]; }
+        DWORD TypeAt(size_t index) const { return types_[index]; }
+        const std::string& NameAt(size_t index) const { return names_[name_ids_[index]]; }
+        
+        MemoryRegion RegionAt(size_t index) const;
+        std::vector<MemoryRegion> ToMemoryRegions() const;
+        size_t TotalBytes() const;
+        
+        // Same regions with the same protection and type
+        bool operator==(const RegionMap& other) const;
+        bool operator!=(const RegionMap& other) const { return !(*this == other); }
+        
+        // Incremental refresh: a copy of this map with every region overlapping
+        // [start, end) replaced by the freshly queried entries
+        RegionMap WithRange(MemoryAddress start, MemoryAddress end, const std::vector<Entry>& fresh) const;
+    
+    private:
+        std::vector<MemoryAddress> starts_;   // Sorted search keys
+        std::vector<MemoryAddress> ends_;
+        std::vector<DWORD> protections_;
+        std::vector<DWORD> types_;
+        std::vector<uint16_t> name_ids_;
+        std::vector<std::string> names_;      // Interned region names
+        
+        std::vector<Entry> ToEntries() const;
+    };
+    
+} // namespace MemoryForensics
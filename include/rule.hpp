@@ -0,0 +1,92 @@
+#pragma once
+
+#include "common.hpp"
+#include <functional>
+
+namespace MemoryForensics {
+    
+    // A YARA-like rule: several byte strings and a condition over them.
+    //
+    //   $load = { 48 8B ?? [4-16] ( 0F 84 | 0F 85 ) 4? }
+    //   $name = "Player"
+    //   condition: $load and not $name within 256
+    //
+    // Hex strings take exact bytes, nibble wildcards ("4?", "?5", "??"), bounded
+    // jumps ("[8]", "[4-16]") and alternations that may nest. Quoted strings are
+    // literal bytes with \\, \", \n, \t, \0 and \xNN escapes. The condition
+    // combines $ids, "any of them", "all of them" and "N of them" with and, or,
+    // not and parentheses; without one the rule is "any of them".
+    //
+    // A rule matches at the start of a string match when its condition holds over
+    // the window [start, start + within); only matches that lie wholly inside the
+    // window count. Without "within" the window is the longest string.
+    class Rule {
+    public:
+        // One step of a string's byte program
+        struct Instruction {
+            enum class Op : uint8_t {
+                Byte,       // Consume a byte where (byte & mask) == value, go to the next step
+                Split,      // Continue at both target and alternate
+                Jump,       // Continue at target
+                Accept      // The string matched
+            };
+            
+            Op op;
+            uint8_t value = 0;
+            uint8_t mask = 0;
+            uint32_t target = 0;
+            uint32_t alternate = 0;
+        };
+        
+        struct String {
+            std::string id;                      // Without the '$'
+            std::vector<Instruction> program;    // Targets are indices into program
+            size_t min_length = 0;
+            size_t max_length = 0;
+        };
+        
+        struct Condition {
+            enum class Kind {
+                String,     // strings[index] is present
+                And,
+                Or,
+                Not,
+                Count       // At least count strings are present
+            };
+            
+            Kind kind = Kind::Count;
+            size_t index = 0;
+            size_t count = 1;
+            std::vector<Condition> operands;
+        };
+        
+        // Logs the reason and returns nullopt when text is not a valid rule
+        static std::optional<Rule> Parse(const std::string& name, const std::string& text);
+        
+        const std::string& Name() const { return name_; }
+        const std::vector<String>& Strings() const { return strings_; }
+        const Condition& GetCondition() const { return condition_; }
+        
+        size_t Window() const { return window_; }
+        
+        // Strings that can open a window: those the condition does not only negate
+        bool IsAnchor(size_t index) const { return anchors_[index]; }
+        
+        bool Evaluate(const std::function<bool(size_t index)>& present) const;
+        
+        // Keep the overlap carried between scan chunks small
+        static constexpr size_t MAX_JUMP = 1024;
+        static constexpr size_t MAX_WINDOW = 4096;
+        
+    private:
+        std::string name_;
+        std::vector<String> strings_;
+        Condition condition_;
+        size_t window_ = 0;
+        std::vector<bool> anchors_;
+        
+        bool Evaluate(const Condition& condition, const std::function<bool(size_t index)>& present) const;
+        void MarkAnchors(const Condition& condition, bool negated);
+    };
+    
+} // namespace MemoryForensics
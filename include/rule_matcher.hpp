@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common.hpp"
+#include "rule.hpp"
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace MemoryForensics {
+    
+    // Matches many rules in one pass. The strings of every rule are compiled into
+    // one byte program, and its unanchored search runs as a lazily built DFA over
+    // byte equivalence classes: a state is the set of program steps alive after a
+    // byte, and each transition is computed the first time a scan takes it.
+    // String matches in a span are then combined per rule window.
+    class RuleMatcher {
+    public:
+        explicit RuleMatcher(const std::vector<Rule>& rules, size_t alignment = 1);
+        
+        // Append a hit for every rule window opening inside data[0, size). Windows
+        // ending at or before reported_until were decided in the previous span, and
+        // windows running past the span wait for the next one unless at_end says
+        // no more data follows.
+        void FindAll(const uint8_t* data, size_t size, MemoryAddress address, MemoryAddress align_origin,
+                     MemoryAddress reported_until, bool at_end, std::vector<SignatureHit>& hits) const;
+        
+        size_t MaxLength() const { return max_window_; }
+        size_t Count() const { return rules_.size(); }
+        size_t StateCount() const { return state_count_.load(std::memory_order_acquire); }
+        
+        // Beyond this many states the rest of a span is simulated without caching
+        static constexpr size_t MAX_DFA_STATES = 4096;
+        
+    private:
+        struct State {
+            std::vector<uint32_t> steps;     // Live Byte steps, sorted
+            std::vector<uint32_t> accepts;   // Strings that ended on the byte leading here
+        };
+        
+        struct Match {
+            size_t start;
+            size_t end;                      // Shortest match from start
+        };
+        
+        // Per-call work buffers; marks[step] == generation means visited
+        struct Scratch {
+            std::vector<uint32_t> marks;
+            uint32_t generation = 0;
+            std::vector<uint32_t> stack;
+        };
+        
+        std::vector<Rule> rules_;
+        size_t alignment_;
+        size_t max_window_ = 0;
+        
+        std::vector<Rule::Instruction> program_;    // Every string; Accept targets hold the string index
+        std::vector<uint32_t> string_entries_;      // String index -> first step
+        std::vector<size_t> string_min_;
+        std::vector<size_t> string_max_;
+        std::vector<size_t> rule_strings_;          // Rule -> index of its first string
+        
+        std::array<uint16_t, 256> byte_classes_{};  // Bytes no step tells apart share a class
+        std::vector<uint8_t> class_bytes_;          // One representative byte per class
+        size_t class_count_ = 0;
+        
+        // Lazy DFA. Readers only lock to add a transition; a state is complete
+        // before the release store that publishes the transition to it.
+        mutable std::unique_ptr<State[]> states_;
+        mutable std::unique_ptr<std::atomic<int32_t>[]> transitions_;
+        mutable std::atomic<size_t> state_count_{0};
+        mutable std::map<std::vector<uint32_t>, uint32_t> state_index_;
+        mutable std::mutex build_mutex_;
+        mutable std::atomic<bool> cache_full_reported_{false};
+        
+        void Compile();
+        void BuildByteClasses();
+        
+        void Closure(uint32_t step, std::vector<uint32_t>& steps, std::vector<uint32_t>& accepts, Scratch& scratch) const;
+        void Advance(const std::vector<uint32_t>& steps, uint8_t byte, std::vector<uint32_t>& next,
+                     std::vector<uint32_t>& accepts, Scratch& scratch) const;
+        int32_t AddTransition(uint32_t state, uint16_t byte_class) const;
+        int32_t InternLocked(std::vector<uint32_t> steps, std::vector<uint32_t> accepts) const;
+        
+        // Length of the shortest match of string starting at data, or 0
+        size_t AnchoredLength(size_t string, const uint8_t* data, size_t available, Scratch& scratch) const;
+    };
+    
+} // namespace MemoryForensics
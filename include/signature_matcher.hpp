@@ -0,0 +1,40 @@
+#pragma once
+
+#include "common.hpp"
+#include "pattern.hpp"
+#include <array>
+
+namespace MemoryForensics {
+    
+    // Matches many signatures in one pass. The longest run of fixed bytes in
+    // each signature (from its Pattern plan) is compiled into an Aho-Corasick
+    // automaton (a dense DFA over byte equivalence classes); every fragment hit
+    // is then verified against the full signature, wildcards included.
+    class SignatureMatcher {
+    public:
+        explicit SignatureMatcher(const std::vector<Signature>& signatures, size_t alignment = 1);
+        
+        // Append every signature match inside data[0, size). Matches ending at or
+        // before reported_until were already seen in the previous overlapping span.
+        void FindAll(const uint8_t* data, size_t size, MemoryAddress address, MemoryAddress align_origin,
+                     MemoryAddress reported_until, std::vector<SignatureHit>& hits) const;
+        
+        size_t MaxLength() const { return max_length_; }
+        size_t Count() const { return signatures_.size(); }
+        size_t StateCount() const { return outputs_begin_.empty() ? 0 : outputs_begin_.size() - 1; }
+    
+    private:
+        std::vector<Signature> signatures_;
+        size_t alignment_;
+        size_t max_length_ = 0;
+        
+        std::array<uint16_t, 256> byte_classes_{};   // Class 0 = byte absent from every fragment
+        size_t class_count_ = 1;
+        std::vector<uint32_t> transitions_;          // state * class_count_ + class -> state
+        std::vector<uint32_t> outputs_begin_;        // Per state range into outputs_
+        std::vector<uint32_t> outputs_;              // Signature indices whose fragment ends here
+        
+        void Build();
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace MemoryForensics {
+    
+    // Non-owning view of contiguous elements, a C++17 stand-in for std::span.
+    // Span<const T> converts from Span<T> and from const vectors.
+    template<typename T>
+    class Span {
+    public:
+        using element_type = T;
+        using iterator = T*;
+        
+        constexpr Span() = default;
+        constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+        
+        template<typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+        constexpr Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+        
+        template<typename U, typename A, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+        Span(std::vector<U, A>& vector) : data_(vector.data()), size_(vector.size()) {}
+        
+        template<typename U, typename A, typename = std::enable_if_t<std::is_convertible<const U (*)[], T (*)[]>::value>>
+        Span(const std::vector<U, A>& vector) : data_(vector.data()), size_(vector.size()) {}
+        
+        constexpr T* data() const { return data_; }
+        constexpr size_t size() const { return size_; }
+        constexpr size_t size_bytes() const { return size_ * sizeof(T); }
+        constexpr bool empty() const { return size_ == 0; }
+        
+        constexpr T* begin() const { return data_; }
+        constexpr T* end() const { return data_ + size_; }
+        constexpr T& operator[](size_t index) const { return data_[index]; }
+        
+        // Elements [offset, offset + count), clamped to the view
+        constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const {
+            if (offset > size_) {
+                return {};
+            }
+            return { data_ + offset, count < size_ - offset ? count : size_ - offset };
+        }
+        
+    private:
+        T* data_ = nullptr;
+        size_t size_ = 0;
+    };
+    
+    // Bytes of a single object, for reading values in place
+    template<typename T>
+    Span<uint8_t> AsWritableBytes(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read as bytes");
+        return { reinterpret_cast<uint8_t*>(&value), sizeof(T) };
+    }
+    
+} // namespace MemoryForensics
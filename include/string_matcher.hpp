@@ -0,0 +1,59 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace MemoryForensics {
+    
+    enum class StringEncoding {
+        Ascii,      // Byte for byte, so UTF-8 text matches too
+        Utf16,      // UTF-16LE, the layout of System.String characters
+        Both
+    };
+    
+    // Finds one piece of text in a buffer. Every byte is compared as
+    // (byte | fold) == expected, where fold is 0x20 for ASCII letters when
+    // matching case-insensitively, 0xFF for padding and 0 otherwise. That lets
+    // the SIMD kernels fold case with a single OR while they test two anchor
+    // bytes 32 or 64 offsets at a time, and verify candidates 16 bytes per step.
+    // Only ASCII letters fold; any other character has to match exactly.
+    class StringMatcher {
+    public:
+        // text is UTF-8; encoding must be Ascii or Utf16
+        StringMatcher(const std::string& text, StringEncoding encoding, bool case_insensitive);
+        
+        // Append the address of every match that lies entirely inside data[0, size).
+        // UTF-16 matches only start on even addresses.
+        void FindAll(const uint8_t* data, size_t size, MemoryAddress address,
+                     std::vector<MemoryAddress>& results) const;
+        
+        size_t Length() const { return length_; }                    // Bytes
+        size_t CharCount() const { return length_ / unit_size_; }    // Code units
+        bool Empty() const { return length_ == 0; }
+        StringEncoding Encoding() const { return encoding_; }
+        
+        // UTF-8 to UTF-16LE; invalid sequences become U+FFFD
+        static ByteVector EncodeUtf16(const std::string& text);
+        
+    private:
+        using Kernel = void (StringMatcher::*)(const uint8_t* data, size_t size, size_t phase,
+                                               std::vector<size_t>& hits) const;
+        
+        StringEncoding encoding_;
+        size_t unit_size_;
+        size_t length_ = 0;
+        size_t padded_length_ = 0;   // length_ rounded up to the 16-byte verify block
+        ByteVector expected_;        // Encoded text, letters lower-cased when folding
+        ByteVector fold_;            // OR mask applied to each haystack byte first
+        size_t last_anchor_ = 0;     // Low byte of the last code unit
+        
+        bool IsAligned(size_t phase, size_t position) const;
+        bool Verify(const uint8_t* candidate, size_t available) const;
+        
+        void FindScalar(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        void FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        void FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const;
+        
+        static Kernel SelectKernel();
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "common.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MemoryForensics {
+    
+    // Fixed set of workers, each with its own task deque. Tasks are dealt out in
+    // contiguous blocks; a worker takes from the front of its own deque and, once
+    // that is empty, steals from the back of the others.
+    class ThreadPool {
+    public:
+        using Body = std::function<void(size_t task, size_t worker)>;
+        using WaitCallback = std::function<void()>;
+        
+        explicit ThreadPool(size_t thread_count);
+        ~ThreadPool();
+        
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        
+        size_t Size() const { return threads_.size(); }
+        
+        // Run body for every task in [0, task_count) and block until all are done.
+        // The worker index passed to body is stable, so callers can keep per-worker state.
+        // on_wait, if set, runs on the calling thread every wait_interval until then.
+        void ParallelFor(size_t task_count, const Body& body,
+                         const WaitCallback& on_wait = {},
+                         std::chrono::milliseconds wait_interval = std::chrono::milliseconds(100));
+    
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+        
+        std::vector<std::thread> threads_;
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        
+        std::mutex run_mutex_;               // One ParallelFor at a time
+        std::mutex mutex_;
+        std::condition_variable work_cv_;
+        std::condition_variable done_cv_;
+        std::atomic<const Body*> body_{nullptr};
+        std::atomic<size_t> remaining_{0};
+        uint64_t generation_ = 0;
+        bool stop_ = false;
+        
+        void WorkerLoop(size_t worker);
+        bool TakeTask(size_t worker, size_t& task);
+    };
+    
+} // namespace MemoryForensics
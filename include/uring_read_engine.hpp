@@ -0,0 +1,81 @@
+#pragma once
+
+#include "common.hpp"
+#include <mutex>
+
+namespace MemoryForensics {
+    
+    // Asynchronous reads of another process through io_uring on /proc/<pid>/mem
+    // (Linux 5.6+). The file is opened once; every batch is cut into pieces of
+    // at most PIECE_SIZE bytes, and up to QUEUE_DEPTH pieces stay in flight,
+    // with the next one submitted as each completes. The kernel serves /proc
+    // reads from its io-wq workers, so a deep queue has several pieces copied
+    // at once where process_vm_readv walks its elements one after another.
+    // Requests are reported as their last piece lands, so callers can work on
+    // early ones while the rest are still being read.
+    // Like ptrace, the mem file reads through page protections: pages without
+    // read access succeed here while process_vm_readv fails on them, so
+    // ProcessManager only hands over ranges its region map knows to be readable.
+    class UringReadEngine {
+    public:
+        ~UringReadEngine();
+        
+        UringReadEngine(const UringReadEngine&) = delete;
+        UringReadEngine& operator=(const UringReadEngine&) = delete;
+        
+        // Whether the kernel accepts io_uring reads (IORING_OP_READ, probed once)
+        static bool Supported();
+        
+        // nullptr when io_uring or the target's mem file is unavailable
+        static std::unique_ptr<UringReadEngine> Open(ProcessID pid);
+        
+        // Same contract as ProcessManager::ReadMemoryBatch; on_complete runs on
+        // the calling thread. Callers on different threads get rings of their
+        // own; if no ring can be set up, pieces are read with plain pread on the
+        // same file.
+        size_t ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete = {});
+        
+        static constexpr unsigned QUEUE_DEPTH = 64;
+        static constexpr size_t PIECE_SIZE = 0x4000;
+        
+    private:
+        struct Ring;    // Submission and completion queues, used by one thread at a time
+        
+        struct Piece {
+            size_t request;
+            size_t offset;
+            size_t size;
+        };
+        
+        // One ReadBatch call: its pieces and how far each request has come
+        struct Batch {
+            std::vector<ReadRequest>& requests;
+            const ReadCompletion& on_complete;
+            std::vector<Piece> pieces;
+            std::vector<size_t> outstanding;    // Pieces of each request not yet finished
+            std::vector<bool> failed;
+            size_t succeeded = 0;
+        };
+        
+        int mem_fd_ = -1;
+        std::mutex rings_mutex_;
+        std::vector<std::unique_ptr<Ring>> idle_rings_;
+        
+        UringReadEngine() = default;
+        
+        std::unique_ptr<Ring> AcquireRing();
+        void ReleaseRing(std::unique_ptr<Ring> ring);
+        
+        // Both finish every piece they are given, success or not. ReadPieces
+        // returns false when the ring must not be reused.
+        bool ReadPieces(Ring& ring, Batch& batch);
+        void ReadPiecesBlocking(Batch& batch, size_t first);
+        
+        // Consume the completions posted so far and return how many there were
+        size_t ReapCompletions(Ring& ring, Batch& batch);
+        
+        // A request is reported once its last piece is in; one short piece fails it
+        static void FinishPiece(Batch& batch, const Piece& piece, bool complete);
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "common.hpp"
+#include "memory_scanner.hpp"
+
+namespace MemoryForensics {
+    
+    enum class ValueType {
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double
+    };
+    
+    enum class ValueCompare {
+        Exact,       // Equal to value (within the float tolerance)
+        Range,       // value <= x <= max_value
+        Changed,     // Next scan only: differs from the previous scan
+        Unchanged,
+        Increased,
+        Decreased,
+        Unknown      // First scan only: snapshot every writable page
+    };
+    
+    // A literal from the user; integers keep their full 64 bits
+    struct ScanValue {
+        bool is_integer = true;
+        int64_t integer = 0;
+        double real = 0.0;
+        
+        static ScanValue Integer(int64_t value) { return { true, value, static_cast<double>(value) }; }
+        static ScanValue Real(double value) { return { false, 0, value }; }
+        
+        template<typename T>
+        T As() const { return is_integer ? static_cast<T>(integer) : static_cast<T>(real); }
+    };
+    
+    struct ValueQuery {
+        ValueCompare compare = ValueCompare::Exact;
+        ScanValue value;
+        ScanValue max_value;
+    };
+    
+    struct ValueResult {
+        MemoryAddress address;
+        ScanValue value;     // As read by the last scan
+    };
+    
+    // First scan / next scan value search. The first scan sweeps every scan
+    // region of the MemoryScanner; next scans re-read only the surviving
+    // addresses with batched reads and filter them against the previous values.
+    //
+    // An Unknown first scan cannot list its candidates, so it keeps a copy of
+    // every writable page with one survivor bit per value slot instead. Next
+    // scans compare whole pages against that copy and drop pages without
+    // survivors; once a plain address list is smaller than the snapshot, the
+    // results switch over to one. Unknown scans only consider values that lie
+    // within a single page, aligned to the page.
+    class ValueScanner {
+    public:
+        explicit ValueScanner(std::shared_ptr<MemoryScanner> scanner);
+        
+        // Replaces any previous results; only Exact, Range and Unknown are valid here
+        bool FirstScan(ValueType type, const ValueQuery& query);
+        
+        // Narrows the previous results; addresses that became unreadable drop out
+        bool NextScan(const ValueQuery& query);
+        
+        void Reset();
+        
+        bool HasResults() const { return has_results_; }
+        bool IsSnapshotMode() const { return snapshot_mode_; }
+        size_t GetResultCount() const { return snapshot_mode_ ? snapshot_survivors_ : addresses_.size(); }
+        ValueType GetValueType() const { return type_; }
+        
+        // The first limit results in address order
+        std::vector<ValueResult> GetResults(size_t limit = SIZE_MAX) const;
+        
+        // Match alignment relative to the region base; 0 uses the natural alignment of the type
+        void SetAlignment(size_t alignment) { alignment_ = alignment; }
+        size_t GetAlignment() const { return alignment_; }
+        
+        // Absolute tolerance for float and double comparisons
+        void SetFloatTolerance(double tolerance) { float_tolerance_ = std::max(tolerance, 0.0); }
+        double GetFloatTolerance() const { return float_tolerance_; }
+        
+        static size_t ValueSize(ValueType type);
+        static std::optional<ValueType> ParseValueType(const std::string& name);
+        static std::optional<ValueCompare> ParseCompare(const std::string& name);
+    
+    private:
+        std::shared_ptr<MemoryScanner> scanner_;
+        ValueType type_ = ValueType::Int32;
+        bool has_results_ = false;
+        std::vector<MemoryAddress> addresses_;
+        ByteVector values_;     // ValueSize(type_) bytes per address, as last read
+        size_t alignment_ = 0;
+        double float_tolerance_ = 0.0;
+        
+        // One page of an Unknown scan
+        struct SnapshotPage {
+            MemoryAddress address;
+            ByteVector data;                     // Contents at the last pass; empty for a zero page
+            std::vector<uint64_t> survivors;     // One bit per value slot
+        };
+        
+        bool snapshot_mode_ = false;
+        std::vector<SnapshotPage> pages_;
+        size_t snapshot_survivors_ = 0;
+        
+        template<typename T>
+        void FirstScanTyped(const ValueQuery& query);
+        
+        template<typename T>
+        void NextScanTyped(const ValueQuery& query);
+        
+        template<typename T, typename Keep>
+        void FilterResults(Keep keep);
+        
+        template<typename T, typename Keep>
+        void FilterPages(Keep keep);
+        
+        template<typename T>
+        void MaterializeSnapshot();
+        
+        void CaptureSnapshot();
+        size_t SnapshotStride() const { return alignment_ ? alignment_ : ValueSize(type_); }
+        size_t SnapshotSlots() const;
+        size_t SnapshotBytes() const;
+        
+        // Reads the current value of every result into values; returns per-result success
+        std::vector<bool> ReadCurrentValues(ByteVector& values);
+        
+        // Nearby results are re-read as one request covering at most a page
+        static constexpr size_t MAX_RUN_SIZE = REMOTE_PAGE_SIZE;
+        static constexpr size_t MAX_RUN_GAP = 64;
+        static constexpr size_t READ_BATCH_BYTES = 16 * SCAN_CHUNK_SIZE;
+        static constexpr size_t SNAPSHOT_BATCH_PAGES = READ_BATCH_BYTES / REMOTE_PAGE_SIZE;
+    };
+    
+} // namespace MemoryForensics
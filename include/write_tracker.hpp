@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common.hpp"
+#include "process_manager.hpp"
+#include <deque>
+
+namespace MemoryForensics {
+    
+    // Pages the target wrote, collected in passes over its soft-dirty bits. A pass
+    // reads the bits of every writable region and resets them, so it holds exactly
+    // the writes since the pass before, wherever they landed. Readers remember the
+    // pass their data is from and ask for everything written after it; the last
+    // MAX_HISTORY passes are kept, and older readers have to start over.
+    //
+    // The bits belong to the whole process, so only one tracker should run per
+    // target. A write that lands between reading the bits and resetting them is
+    // not seen until the page is written again, and neither is one to a region
+    // made read-only before the next pass.
+    class WriteTracker {
+    public:
+        using Range = std::pair<MemoryAddress, MemoryAddress>;   // [start, end)
+        
+        explicit WriteTracker(std::shared_ptr<ProcessManager> process_mgr);
+        
+        // Reset the target's bits and forget earlier passes; false if unsupported
+        bool Start();
+        bool IsActive() const { return active_; }
+        
+        // Collect the writes since the previous pass and return the new pass
+        // number; nullopt if the bits could not be read, which stops tracking
+        std::optional<uint64_t> Advance();
+        uint64_t CurrentPass() const { return pass_; }
+        
+        // Sorted, coalesced ranges written after pass; nullopt once pass has left the history
+        std::optional<std::vector<Range>> WrittenSince(uint64_t pass) const;
+        
+        // Set operations on sorted, coalesced range lists
+        static std::vector<Range> Union(const std::vector<Range>& a, const std::vector<Range>& b);
+        static std::vector<Range> Subtract(const std::vector<Range>& from, const std::vector<Range>& remove);
+        
+        static constexpr size_t MAX_HISTORY = 64;
+        
+    private:
+        std::shared_ptr<ProcessManager> process_mgr_;
+        ProcessID process_id_ = 0;
+        bool active_ = false;
+        uint64_t pass_ = 0;
+        std::deque<std::vector<Range>> history_;   // history_.back() holds the writes of pass_
+    };
+    
+} // namespace MemoryForensics
@@ -0,0 +1,333 @@
+#include "address_set.hpp"
+#include <algorithm>
+
+namespace MemoryForensics {
+
+AddressSet::ConstIterator::ConstIterator(const AddressSet* set, size_t container, size_t position)
+    : set_(set), container_(container), position_(position) {
+    Settle();
+}
+
+AddressSet::ConstIterator& AddressSet::ConstIterator::operator++() {
+    ++position_;
+    Settle();
+    return *this;
+}
+
+void AddressSet::ConstIterator::Settle() {
+    while (container_ < set_->containers_.size()) {
+        const Container& container = set_->containers_[container_];
+        MemoryAddress base = static_cast<MemoryAddress>(set_->keys_[container_] << 16);
+        
+        if (!container.IsBitmap()) {
+            if (position_ < container.array.size()) {
+                current_ = base + container.array[position_];
+                return;
+            }
+        } else {
+            for (size_t word = position_ / 64; word < BITMAP_WORDS; ++word) {
+                uint64_t bits = container.bitmap[word];
+                if (word == position_ / 64) {
+                    bits &= ~uint64_t{0} << (position_ % 64);
+                }
+                if (bits != 0) {
+                    position_ = word * 64 + CountTrailingZeros(bits);
+                    current_ = base + position_;
+                    return;
+                }
+            }
+        }
+        
+        ++container_;
+        position_ = 0;
+    }
+    
+    // Past the end; matches end()
+    position_ = 0;
+}
+
+AddressSet AddressSet::FromSorted(const std::vector<MemoryAddress>& addresses) {
+    AddressSet set;
+    for (MemoryAddress address : addresses) {
+        set.Add(address);
+    }
+    
+    // Growth slack would otherwise cost up to half of the compression
+    for (auto& container : set.containers_) {
+        container.array.shrink_to_fit();
+    }
+    set.keys_.shrink_to_fit();
+    set.containers_.shrink_to_fit();
+    return set;
+}
+
+void AddressSet::Add(MemoryAddress address) {
+    uint64_t key = static_cast<uint64_t>(address) >> 16;
+    uint16_t offset = static_cast<uint16_t>(address & 0xFFFF);
+    
+    // Sorted input only ever touches the last container
+    size_t index;
+    if (!keys_.empty() && keys_.back() == key) {
+        index = keys_.size() - 1;
+    } else if (keys_.empty() || keys_.back() < key) {
+        keys_.push_back(key);
+        containers_.emplace_back();
+        index = keys_.size() - 1;
+    } else {
+        auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+        index = static_cast<size_t>(it - keys_.begin());
+        if (it == keys_.end() || *it != key) {
+            keys_.insert(it, key);
+            containers_.insert(containers_.begin() + index, Container{});
+        }
+    }
+    
+    Container& container = containers_[index];
+    uint32_t before = container.cardinality;
+    AddToContainer(container, offset);
+    size_ += container.cardinality - before;
+}
+
+bool AddressSet::Contains(MemoryAddress address) const {
+    uint64_t key = static_cast<uint64_t>(address) >> 16;
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) {
+        return false;
+    }
+    
+    return ContainerContains(containers_[it - keys_.begin()], static_cast<uint16_t>(address & 0xFFFF));
+}
+
+void AddressSet::Append(AddressSet&& other) {
+    if (other.Empty()) {
+        return;
+    }
+    if (Empty()) {
+        *this = std::move(other);
+        return;
+    }
+    
+    // Neighbouring scan tasks can share the 64KB group at their boundary
+    size_t first = 0;
+    if (other.keys_.front() == keys_.back()) {
+        Container& last = containers_.back();
+        size_ -= last.cardinality;
+        last = UnionContainers(last, other.containers_.front());
+        size_ += last.cardinality;
+        first = 1;
+    }
+    
+    for (size_t i = first; i < other.keys_.size(); ++i) {
+        keys_.push_back(other.keys_[i]);
+        size_ += other.containers_[i].cardinality;
+        containers_.push_back(std::move(other.containers_[i]));
+    }
+    
+    other.Clear();
+}
+
+AddressSet AddressSet::Intersect(const AddressSet& other) const {
+    AddressSet result;
+    
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_.size() && j < other.keys_.size()) {
+        if (keys_[i] < other.keys_[j]) {
+            ++i;
+        } else if (other.keys_[j] < keys_[i]) {
+            ++j;
+        } else {
+            Container container = IntersectContainers(containers_[i], other.containers_[j]);
+            if (container.cardinality != 0) {
+                result.keys_.push_back(keys_[i]);
+                result.size_ += container.cardinality;
+                result.containers_.push_back(std::move(container));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    
+    return result;
+}
+
+AddressSet AddressSet::Union(const AddressSet& other) const {
+    AddressSet result;
+    
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_.size() || j < other.keys_.size()) {
+        uint64_t key;
+        Container container;
+        
+        if (j == other.keys_.size() || (i < keys_.size() && keys_[i] < other.keys_[j])) {
+            key = keys_[i];
+            container = containers_[i++];
+        } else if (i == keys_.size() || other.keys_[j] < keys_[i]) {
+            key = other.keys_[j];
+            container = other.containers_[j++];
+        } else {
+            key = keys_[i];
+            container = UnionContainers(containers_[i++], other.containers_[j++]);
+        }
+        
+        result.keys_.push_back(key);
+        result.size_ += container.cardinality;
+        result.containers_.push_back(std::move(container));
+    }
+    
+    return result;
+}
+
+void AddressSet::Clear() {
+    keys_.clear();
+    containers_.clear();
+    size_ = 0;
+}
+
+size_t AddressSet::MemoryUsage() const {
+    size_t bytes = keys_.capacity() * sizeof(uint64_t) + containers_.capacity() * sizeof(Container);
+    for (const auto& container : containers_) {
+        bytes += container.array.capacity() * sizeof(uint16_t);
+        bytes += container.bitmap.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+std::vector<MemoryAddress> AddressSet::ToVector() const {
+    std::vector<MemoryAddress> addresses;
+    addresses.reserve(size_);
+    ForEach([&](MemoryAddress address) {
+        addresses.push_back(address);
+    });
+    return addresses;
+}
+
+void AddressSet::AddToContainer(Container& container, uint16_t offset) {
+    if (container.IsBitmap()) {
+        uint64_t bit = uint64_t{1} << (offset % 64);
+        uint64_t& word = container.bitmap[offset / 64];
+        if ((word & bit) == 0) {
+            word |= bit;
+            ++container.cardinality;
+        }
+        return;
+    }
+    
+    auto& array = container.array;
+    if (array.empty() || array.back() < offset) {
+        array.push_back(offset);
+    } else {
+        auto it = std::lower_bound(array.begin(), array.end(), offset);
+        if (*it == offset) {
+            return;
+        }
+        array.insert(it, offset);
+    }
+    
+    if (++container.cardinality > ARRAY_MAX) {
+        ToBitmap(container);
+    }
+}
+
+bool AddressSet::ContainerContains(const Container& container, uint16_t offset) {
+    if (container.IsBitmap()) {
+        return (container.bitmap[offset / 64] >> (offset % 64)) & 1;
+    }
+    return std::binary_search(container.array.begin(), container.array.end(), offset);
+}
+
+void AddressSet::ToBitmap(Container& container) {
+    container.bitmap.assign(BITMAP_WORDS, 0);
+    for (uint16_t offset : container.array) {
+        container.bitmap[offset / 64] |= uint64_t{1} << (offset % 64);
+    }
+    
+    container.array.clear();
+    container.array.shrink_to_fit();
+}
+
+void AddressSet::ToArray(Container& container) {
+    container.array.clear();
+    container.array.reserve(container.cardinality);
+    for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+        uint64_t bits = container.bitmap[word];
+        while (bits != 0) {
+            container.array.push_back(static_cast<uint16_t>(word * 64 + CountTrailingZeros(bits)));
+            bits &= bits - 1;
+        }
+    }
+    
+    container.bitmap.clear();
+    container.bitmap.shrink_to_fit();
+}
+
+AddressSet::Container AddressSet::IntersectContainers(const Container& a, const Container& b) {
+    Container result;
+    
+    if (a.IsBitmap() && b.IsBitmap()) {
+        result.bitmap.resize(BITMAP_WORDS);
+        for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+            result.bitmap[word] = a.bitmap[word] & b.bitmap[word];
+            result.cardinality += PopCount(result.bitmap[word]);
+        }
+        if (result.cardinality <= ARRAY_MAX) {
+            ToArray(result);
+        }
+        return result;
+    }
+    
+    if (!a.IsBitmap() && !b.IsBitmap()) {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+    } else {
+        // Probe the bitmap with each offset of the array
+        const Container& array = a.IsBitmap() ? b : a;
+        const Container& bitmap = a.IsBitmap() ? a : b;
+        for (uint16_t offset : array.array) {
+            if (ContainerContains(bitmap, offset)) {
+                result.array.push_back(offset);
+            }
+        }
+    }
+    
+    result.cardinality = static_cast<uint32_t>(result.array.size());
+    result.array.shrink_to_fit();
+    return result;
+}
+
+AddressSet::Container AddressSet::UnionContainers(const Container& a, const Container& b) {
+    Container result;
+    
+    if (!a.IsBitmap() && !b.IsBitmap()) {
+        result.array.reserve(a.array.size() + b.array.size());
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        if (result.cardinality > ARRAY_MAX) {
+            ToBitmap(result);
+        }
+        return result;
+    }
+    
+    // At least one side is dense, so the result is a bitmap
+    result = a.IsBitmap() ? a : b;
+    const Container& other = a.IsBitmap() ? b : a;
+    if (other.IsBitmap()) {
+        for (size_t word = 0; word < BITMAP_WORDS; ++word) {
+            result.bitmap[word] |= other.bitmap[word];
+        }
+    } else {
+        for (uint16_t offset : other.array) {
+            result.bitmap[offset / 64] |= uint64_t{1} << (offset % 64);
+        }
+    }
+    
+    result.cardinality = 0;
+    for (uint64_t word : result.bitmap) {
+        result.cardinality += PopCount(word);
+    }
+    return result;
+}
+
+} // namespace MemoryForensics
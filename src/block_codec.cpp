@@ -0,0 +1,212 @@
+#include "block_codec.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MemoryForensics {
+namespace BlockCodec {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t HASH_BITS = 12;
+constexpr size_t MAX_OFFSET = 0xFFFF;
+
+// Literal runs longer than 2^SKIP_SHIFT bytes advance faster, so data that
+// does not compress costs little time
+constexpr size_t SKIP_SHIFT = 6;
+
+uint32_t Load32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t HashOf(uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+class Writer {
+public:
+    Writer(uint8_t* output, size_t capacity) : begin_(output), out_(output), end_(output + capacity) {}
+    
+    bool Put(uint8_t byte) {
+        if (out_ == end_) {
+            return false;
+        }
+        *out_++ = byte;
+        return true;
+    }
+    
+    bool Put(const uint8_t* data, size_t size) {
+        if (static_cast<size_t>(end_ - out_) < size) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(out_, data, size);
+        }
+        out_ += size;
+        return true;
+    }
+    
+    // Remainder of a length whose nibble was saturated
+    bool PutLength(size_t length) {
+        for (; length >= 255; length -= 255) {
+            if (!Put(255)) {
+                return false;
+            }
+        }
+        return Put(static_cast<uint8_t>(length));
+    }
+    
+    size_t Written() const { return static_cast<size_t>(out_ - begin_); }
+    
+private:
+    uint8_t* begin_;
+    uint8_t* out_;
+    uint8_t* end_;
+};
+
+// match_length 0 writes the closing, literals-only sequence
+bool WriteSequence(Writer& writer, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length) {
+    size_t match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15));
+    
+    if (!writer.Put(token) ||
+        (literal_count >= 15 && !writer.PutLength(literal_count - 15)) ||
+        !writer.Put(literals, literal_count)) {
+        return false;
+    }
+    
+    if (match_length == 0) {
+        return true;
+    }
+    
+    return writer.Put(static_cast<uint8_t>(offset)) && writer.Put(static_cast<uint8_t>(offset >> 8)) &&
+           (match_code < 15 || writer.PutLength(match_code - 15));
+}
+
+// Length continuation; false if the input ends inside it
+bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in == end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t Compress(const uint8_t* input, size_t size, uint8_t* output, size_t capacity) {
+    if (size > MAX_BLOCK_SIZE) {
+        return 0;
+    }
+    
+    // Positions fit 16 bits because blocks do; empty or stale slots are
+    // caught by comparing the bytes they point at
+    uint16_t table[size_t{1} << HASH_BITS] = {};
+    Writer writer(output, capacity);
+    
+    size_t anchor = 0;
+    size_t position = 1;
+    while (size >= MIN_MATCH && position <= size - MIN_MATCH) {
+        uint32_t sequence = Load32(input + position);
+        uint16_t& slot = table[HashOf(sequence)];
+        size_t candidate = slot;
+        slot = static_cast<uint16_t>(position);
+        
+        if (candidate >= position || position - candidate > MAX_OFFSET || Load32(input + candidate) != sequence) {
+            position += 1 + ((position - anchor) >> SKIP_SHIFT);
+            continue;
+        }
+        
+        // Extend backwards over pending literals, then forwards
+        while (position > anchor && candidate > 0 && input[position - 1] == input[candidate - 1]) {
+            --position;
+            --candidate;
+        }
+        size_t length = MIN_MATCH;
+        while (position + length < size && input[candidate + length] == input[position + length]) {
+            ++length;
+        }
+        
+        if (!WriteSequence(writer, input + anchor, position - anchor, position - candidate, length)) {
+            return 0;
+        }
+        
+        position += length;
+        anchor = position;
+        if (position >= 2 && position + 2 <= size) {
+            table[HashOf(Load32(input + position - 2))] = static_cast<uint16_t>(position - 2);
+        }
+    }
+    
+    if (!WriteSequence(writer, input + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+    return writer.Written();
+}
+
+bool Decompress(const uint8_t* input, size_t input_size, uint8_t* output, size_t size) {
+    const uint8_t* in = input;
+    const uint8_t* in_end = input + input_size;
+    size_t out = 0;
+    
+    while (in != in_end) {
+        uint8_t token = *in++;
+        
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !ReadLength(in, in_end, literal_count)) {
+            return false;
+        }
+        if (literal_count > static_cast<size_t>(in_end - in) || literal_count > size - out) {
+            return false;
+        }
+        if (literal_count > 0) {
+            std::memcpy(output + out, in, literal_count);
+        }
+        in += literal_count;
+        out += literal_count;
+        
+        // The closing sequence has no match
+        if (in == in_end) {
+            break;
+        }
+        
+        if (in_end - in < 2) {
+            return false;
+        }
+        size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        
+        size_t length = token & 0x0F;
+        if (length == 15 && !ReadLength(in, in_end, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        
+        if (offset == 0 || offset > out || length > size - out) {
+            return false;
+        }
+        
+        // A match longer than its offset repeats its first offset bytes; each
+        // copy doubles the repeated part so runs of zeros stay cheap
+        uint8_t* to = output + out;
+        size_t done = std::min(offset, length);
+        std::memcpy(to, to - offset, done);
+        while (done < length) {
+            size_t count = std::min(done, length - done);
+            std::memcpy(to + done, to, count);
+            done += count;
+        }
+        out += length;
+    }
+    
+    return out == size;
+}
+
+} // namespace BlockCodec
+} // namespace MemoryForensics
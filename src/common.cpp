@@ -2,10 +2,20 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 
 namespace MemoryForensics {
 
 std::string GetLastErrorString() {
+#ifdef LINUX_BUILD
+    int error = errno;
+    if (error == 0) {
+        return "No error";
+    }
+    
+    return std::strerror(error);
+#else
     DWORD error = GetLastError();
     if (error == 0) {
         return "No error";
@@ -31,6 +41,14 @@ std::string GetLastErrorString() {
     }
     
     return message;
+#endif
+}
+
+bool EqualsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
 }
 
 bool IsValidPointer(MemoryAddress address) {
@@ -82,6 +100,17 @@ std::vector<uint8_t> HexStringToBytes(const std::string& hex) {
     return bytes;
 }
 
+std::string PointerPath::ToString() const {
+    std::stringstream ss;
+    ss << module << std::hex << std::uppercase;
+    
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ss << (i == 0 ? "+0x" : " -> +0x") << offsets[i];
+    }
+    
+    return ss.str();
+}
+
 std::string BytesToHexString(const std::vector<uint8_t>& bytes) {
     std::stringstream ss;
     ss << std::hex << std::uppercase << std::setfill('0');
@@ -1,104 +1,110 @@
 #include "dotnet_biginteger_reader.hpp"
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 
 namespace MemoryForensics {
 
+DotNetBigIntegerReader::DotNetBigIntegerReader(std::shared_ptr<MemorySource> source)
+    : source_(source) {
+}
+
 DotNetBigIntegerReader::DotNetBigIntegerReader(std::shared_ptr<MemoryScanner> scanner)
-    : scanner_(scanner) {
+    : DotNetBigIntegerReader(scanner ? scanner->GetReadSource() : nullptr) {
 }
 
 std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigInteger(MemoryAddress base_address) {
-    if (!scanner_) {
-        LOG_ERROR("MemoryScanner is null");
-        return std::nullopt;
-    }
-    
-    if (!IsValidPointer(base_address)) {
-        LOG_ERROR("Invalid base address: 0x{:X}", base_address);
-        return std::nullopt;
-    }
-    
-    DotNetBigIntegerData result;
+    return ReadBigIntegers({ base_address }).front();
+}
+
+std::vector<std::optional<DotNetBigIntegerData>> DotNetBigIntegerReader::ReadBigIntegers(const std::vector<MemoryAddress>& addresses) {
+    std::vector<std::optional<DotNetBigIntegerData>> results(addresses.size());
     
-    // Read the sign field (typically at offset 0)
-    auto sign_opt = scanner_->ReadInt32(base_address);
-    if (!sign_opt) {
-        LOG_ERROR("Failed to read sign field at 0x{:X}", base_address);
-        return std::nullopt;
+    if (!source_) {
+        LOG_ERROR("Memory source is null");
+        return results;
     }
-    result.sign = *sign_opt;
     
-    // Read the bits pointer (typically at offset 4 or 8 depending on architecture)
-    MemoryAddress bits_ptr_address = base_address + sizeof(int32_t);
-    auto bits_ptr_opt = scanner_->ReadUInt64(bits_ptr_address);  // Assuming 64-bit pointers
-    if (!bits_ptr_opt) {
-        LOG_ERROR("Failed to read bits pointer at 0x{:X}", bits_ptr_address);
-        return std::nullopt;
-    }
-    result.bits_ptr = reinterpret_cast<uint32_t*>(*bits_ptr_opt);
+    // First round trip: sign and bits pointer of every BigInteger
+    std::vector<std::array<uint8_t, HEADER_SIZE>> headers(addresses.size());
+    std::vector<ReadRequest> header_requests;
+    std::vector<size_t> header_owners;
     
-    // Validate the bits pointer
-    if (!IsValidPointer(reinterpret_cast<MemoryAddress>(result.bits_ptr))) {
-        LOG_WARN("Invalid bits pointer: 0x{:X}", reinterpret_cast<MemoryAddress>(result.bits_ptr));
-        return std::nullopt;
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        if (!IsValidPointer(addresses[i])) {
+            LOG_ERROR("Invalid base address: 0x{:X}", addresses[i]);
+            continue;
+        }
+        header_requests.push_back({ addresses[i], headers[i].data(), HEADER_SIZE });
+        header_owners.push_back(i);
     }
     
-    // Read the bits length (may be stored separately or derived)
-    // For now, we'll try to determine it by reading a reasonable amount
-    // In a real .NET BigInteger, this information might be stored differently
+    source_->ReadBatch(header_requests);
     
-    // Try to read the first few uint32 values to determine the actual length
-    const uint32_t max_probe_length = 32;  // Probe up to 32 uint32 values
-    MemoryAddress bits_address = reinterpret_cast<MemoryAddress>(result.bits_ptr);
-    
-    auto probe_array = scanner_->ReadUInt32Array(bits_address, max_probe_length);
-    if (!probe_array) {
-        LOG_ERROR("Failed to read bits array at 0x{:X}", bits_address);
-        return std::nullopt;
-    }
+    // Second round trip: probe the bits array of every BigInteger with a valid header.
+    // The actual bits are a prefix of the probe, so no third read is needed.
+    std::vector<DotNetBigIntegerData> decoded(addresses.size());
+    std::vector<std::vector<uint32_t>> probes(addresses.size());
+    std::vector<ReadRequest> probe_requests;
+    std::vector<size_t> probe_owners;
     
-    // Find the actual length by looking for the last non-zero value
-    uint32_t actual_length = 0;
-    for (int i = probe_array->size() - 1; i >= 0; --i) {
-        if ((*probe_array)[i] != 0) {
-            actual_length = i + 1;
-            break;
+    for (size_t k = 0; k < header_requests.size(); ++k) {
+        size_t i = header_owners[k];
+        if (!header_requests[k].success) {
+            LOG_ERROR("Failed to read sign and bits pointer at 0x{:X}", addresses[i]);
+            continue;
         }
+        
+        // Read the sign field (offset 0) and the bits pointer (offset 4, 64-bit pointers)
+        MemoryAddress bits_ptr = 0;
+        std::memcpy(&decoded[i].sign, headers[i].data(), sizeof(int32_t));
+        std::memcpy(&bits_ptr, headers[i].data() + sizeof(int32_t), sizeof(MemoryAddress));
+        decoded[i].bits_ptr = reinterpret_cast<uint32_t*>(bits_ptr);
+        
+        // Validate the bits pointer
+        if (!IsValidPointer(bits_ptr)) {
+            LOG_WARN("Invalid bits pointer: 0x{:X}", bits_ptr);
+            continue;
+        }
+        
+        probes[i].resize(MAX_PROBE_LENGTH);
+        probe_requests.push_back({ bits_ptr, probes[i].data(), MAX_PROBE_LENGTH * sizeof(uint32_t) });
+        probe_owners.push_back(i);
     }
     
-    if (actual_length == 0 && result.sign != 0) {
-        actual_length = 1;  // At least one element for non-zero numbers
-    }
-    
-    result.bits_length = actual_length;
+    source_->ReadBatch(probe_requests);
     
-    if (!IsValidBitsLength(result.bits_length)) {
-        LOG_WARN("Invalid bits length: {}", result.bits_length);
-        return std::nullopt;
-    }
-    
-    // Read the actual bits data
-    if (result.bits_length > 0) {
-        auto bits_data_opt = scanner_->ReadUInt32Array(bits_address, result.bits_length);
-        if (!bits_data_opt) {
-            LOG_ERROR("Failed to read {} bits from 0x{:X}", result.bits_length, bits_address);
-            return std::nullopt;
+    for (size_t k = 0; k < probe_requests.size(); ++k) {
+        size_t i = probe_owners[k];
+        if (!probe_requests[k].success) {
+            LOG_ERROR("Failed to read bits array at 0x{:X}", probe_requests[k].address);
+            continue;
         }
-        result.bits_data = *bits_data_opt;
+        
+        DotNetBigIntegerData& result = decoded[i];
+        result.bits_length = DetermineBitsLength(probes[i], result.sign);
+        
+        if (!IsValidBitsLength(result.bits_length)) {
+            LOG_WARN("Invalid bits length: {}", result.bits_length);
+            continue;
+        }
+        
+        result.bits_data.assign(probes[i].begin(), probes[i].begin() + result.bits_length);
+        result.is_valid = true;
+        results[i] = std::move(result);
     }
     
-    result.is_valid = true;
-    return result;
+    return results;
 }
 
 std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigIntegerVerbose(MemoryAddress base_address) {
     LOG_INFO("Reading .NET BigInteger at 0x{:X}", base_address);
     LOG_INDENT();
     
-    if (!scanner_) {
-        LOG_ERROR("MemoryScanner is null");
+    if (!source_) {
+        LOG_ERROR("Memory source is null");
         return std::nullopt;
     }
     
@@ -113,7 +119,7 @@ std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigIntegerVerbos
     LOG_INFO("Reading sign field...");
     {
         LOG_INDENT();
-        auto sign_opt = scanner_->ReadInt32(base_address);
+        auto sign_opt = source_->Read<int32_t>(base_address);
         if (!sign_opt) {
             LOG_ERROR("Failed to read sign field at 0x{:X}", base_address);
             return std::nullopt;
@@ -127,7 +133,7 @@ std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigIntegerVerbos
     {
         LOG_INDENT();
         MemoryAddress bits_ptr_address = base_address + sizeof(int32_t);
-        auto bits_ptr_opt = scanner_->ReadUInt64(bits_ptr_address);
+        auto bits_ptr_opt = source_->Read<uint64_t>(bits_ptr_address);
         if (!bits_ptr_opt) {
             LOG_ERROR("Failed to read bits pointer at 0x{:X}", bits_ptr_address);
             return std::nullopt;
@@ -145,29 +151,16 @@ std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigIntegerVerbos
     LOG_INFO("Determining bits array length...");
     {
         LOG_INDENT();
-        const uint32_t max_probe_length = 32;
         MemoryAddress bits_address = reinterpret_cast<MemoryAddress>(result.bits_ptr);
         
-        auto probe_array = scanner_->ReadUInt32Array(bits_address, max_probe_length);
+        auto probe_array = source_->ReadArray<uint32_t>(bits_address, MAX_PROBE_LENGTH);
         if (!probe_array) {
             LOG_ERROR("Failed to read bits array at 0x{:X}", bits_address);
             return std::nullopt;
         }
         
         // Find actual length
-        uint32_t actual_length = 0;
-        for (int i = probe_array->size() - 1; i >= 0; --i) {
-            if ((*probe_array)[i] != 0) {
-                actual_length = i + 1;
-                break;
-            }
-        }
-        
-        if (actual_length == 0 && result.sign != 0) {
-            actual_length = 1;
-        }
-        
-        result.bits_length = actual_length;
+        result.bits_length = DetermineBitsLength(*probe_array, result.sign);
         LogTypedValue("determined_bits_length", bits_address, result.bits_length);
         
         if (!IsValidBitsLength(result.bits_length)) {
@@ -182,7 +175,7 @@ std::optional<DotNetBigIntegerData> DotNetBigIntegerReader::ReadBigIntegerVerbos
         LOG_INDENT();
         
         MemoryAddress bits_address = reinterpret_cast<MemoryAddress>(result.bits_ptr);
-        auto bits_data_opt = scanner_->ReadUInt32Array(bits_address, result.bits_length);
+        auto bits_data_opt = source_->ReadArray<uint32_t>(bits_address, result.bits_length);
         if (!bits_data_opt) {
             LOG_ERROR("Failed to read {} bits from 0x{:X}", result.bits_length, bits_address);
             return std::nullopt;
@@ -257,6 +250,23 @@ std::string DotNetBigIntegerReader::BigIntegerToHex(const DotNetBigIntegerData&
     return ss.str();
 }
 
+uint32_t DotNetBigIntegerReader::DetermineBitsLength(const std::vector<uint32_t>& probe, int32_t sign) {
+    // Find the actual length by looking for the last non-zero value
+    uint32_t actual_length = 0;
+    for (size_t i = probe.size(); i > 0; --i) {
+        if (probe[i - 1] != 0) {
+            actual_length = static_cast<uint32_t>(i);
+            break;
+        }
+    }
+    
+    if (actual_length == 0 && sign != 0) {
+        actual_length = 1;  // At least one element for non-zero numbers
+    }
+    
+    return actual_length;
+}
+
 void DotNetBigIntegerReader::LogMemoryValue(const std::string& field_name, 
                                           MemoryAddress address, 
                                           const std::string& value_str) {
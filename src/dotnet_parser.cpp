@@ -6,7 +6,15 @@
 namespace MemoryForensics {
 
 DotNetParser::DotNetParser(std::shared_ptr<ProcessManager> process_mgr)
-    : process_mgr_(process_mgr) {
+    : DotNetParser(std::make_shared<ProcessMemorySource>(process_mgr)) {
+}
+
+DotNetParser::DotNetParser(std::shared_ptr<MemorySource> source)
+    : source_(source) {
+}
+
+DotNetParser::DotNetParser(std::shared_ptr<MemoryScanner> scanner)
+    : DotNetParser(scanner->GetReadSource()) {
 }
 
 bool DotNetParser::IsValidObject(MemoryAddress object_addr) {
@@ -14,19 +22,20 @@ bool DotNetParser::IsValidObject(MemoryAddress object_addr) {
         return false;
     }
     
-    // Read the object header
+    // Read the object header and the method table pointer (typically right after
+    // the object header) in a single round trip
     ObjectHeader header;
-    if (!process_mgr_->ReadMemory(object_addr, &header, sizeof(ObjectHeader))) {
-        return false;
-    }
+    MemoryAddress method_table_addr;
+    std::vector<ReadRequest> requests = {
+        { object_addr, &header, sizeof(ObjectHeader) },
+        { object_addr + sizeof(ObjectHeader), &method_table_addr, sizeof(MemoryAddress) }
+    };
     
-    if (!ValidateObjectHeader(header)) {
+    if (ReadRawBatch(requests) != requests.size()) {
         return false;
     }
     
-    // Get the method table pointer (typically right after the object header)
-    MemoryAddress method_table_addr;
-    if (!process_mgr_->ReadMemory(object_addr + sizeof(ObjectHeader), &method_table_addr, sizeof(MemoryAddress))) {
+    if (!ValidateObjectHeader(header)) {
         return false;
     }
     
@@ -36,7 +45,7 @@ bool DotNetParser::IsValidObject(MemoryAddress object_addr) {
     
     // Read and validate the method table
     MethodTable mt;
-    if (!process_mgr_->ReadMemory(method_table_addr, &mt, sizeof(MethodTable))) {
+    if (!ReadRaw(method_table_addr, &mt, sizeof(MethodTable))) {
         return false;
     }
     
@@ -56,7 +65,7 @@ std::optional<MethodTable> DotNetParser::GetMethodTable(MemoryAddress object_add
     
     // Read method table pointer from object
     MemoryAddress method_table_addr;
-    if (!process_mgr_->ReadMemory(object_addr + sizeof(ObjectHeader), &method_table_addr, sizeof(MemoryAddress))) {
+    if (!ReadRaw(object_addr + sizeof(ObjectHeader), &method_table_addr, sizeof(MemoryAddress))) {
         return std::nullopt;
     }
     
@@ -66,7 +75,7 @@ std::optional<MethodTable> DotNetParser::GetMethodTable(MemoryAddress object_add
     
     // Read the method table
     MethodTable mt;
-    if (!process_mgr_->ReadMemory(method_table_addr, &mt, sizeof(MethodTable))) {
+    if (!ReadRaw(method_table_addr, &mt, sizeof(MethodTable))) {
         return std::nullopt;
     }
     
@@ -93,7 +102,7 @@ std::string DotNetParser::GetTypeName(MemoryAddress method_table_addr) {
     
     // Read method table
     MethodTable mt;
-    if (!process_mgr_->ReadMemory(method_table_addr, &mt, sizeof(MethodTable))) {
+    if (!ReadRaw(method_table_addr, &mt, sizeof(MethodTable))) {
         return "READ_FAILED";
     }
     
@@ -171,46 +180,32 @@ std::vector<MemoryAddress> DotNetParser::ScanForBigIntegers() {
 std::vector<MemoryRegion> DotNetParser::GetManagedHeapRegions() {
     std::vector<MemoryRegion> heap_regions;
     
-    // Get all memory regions from the process
-    MEMORY_BASIC_INFORMATION mbi;
-    MemoryAddress current_addr = 0;
-    
-    while (VirtualQueryEx(process_mgr_->GetProcessHandle(), 
-                         reinterpret_cast<LPCVOID>(current_addr), 
-                         &mbi, sizeof(mbi)) == sizeof(mbi)) {
-        
-        // Look for committed memory regions that could contain managed heap
-        if (mbi.State == MEM_COMMIT && 
-            (mbi.Protect & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE)) &&
-            mbi.RegionSize > 64 * 1024) { // At least 64KB regions
-            
-            MemoryRegion region;
-            region.base_address = reinterpret_cast<MemoryAddress>(mbi.BaseAddress);
-            region.size = mbi.RegionSize;
-            region.protection = mbi.Protect;
+    // The filtered view is cached per region map, so this never walks the address space again
+    RegionFilterStats stats;
+    for (auto& region : source_->Regions(&stats)) {
+        if (IsManagedHeapCandidate(region.protection, region.size)) {
             region.name = "PotentialManagedHeap";
-            
-            heap_regions.push_back(region);
+            heap_regions.push_back(std::move(region));
         }
-        
-        current_addr = reinterpret_cast<MemoryAddress>(mbi.BaseAddress) + mbi.RegionSize;
     }
     
-    LOG_DEBUG("Found {} potential managed heap regions", heap_regions.size());
+    LOG_DEBUG("Found {} potential managed heap regions ({} MB skipped by the region filter)",
+              heap_regions.size(), stats.skipped_bytes / (1024 * 1024));
     return heap_regions;
 }
 
 bool DotNetParser::IsInManagedHeap(MemoryAddress address) {
-    auto heap_regions = GetManagedHeapRegions();
-    
-    for (const auto& region : heap_regions) {
-        if (address >= region.base_address && 
-            address < region.base_address + region.size) {
-            return true;
-        }
-    }
+    auto region_map = source_->GetRegionMap();
+    size_t index = region_map->Find(address);
     
-    return false;
+    return index != RegionMap::npos &&
+           IsManagedHeapCandidate(region_map->ProtectionAt(index), region_map->SizeAt(index));
+}
+
+bool DotNetParser::IsManagedHeapCandidate(DWORD protection, size_t size) {
+    // Look for regions that could contain managed heap
+    return (protection & (PAGE_READWRITE | PAGE_EXECUTE_READWRITE)) &&
+           size > 64 * 1024; // At least 64KB regions
 }
 
 void DotNetParser::CacheMethodTable(MemoryAddress addr, const MethodTable& mt) {
@@ -318,7 +313,7 @@ std::string DotNetParser::ReadManagedString(MemoryAddress string_addr) {
     
     // Read string length
     uint32_t length;
-    if (!process_mgr_->ReadMemory(data_offset, &length, sizeof(uint32_t))) {
+    if (!ReadRaw(data_offset, &length, sizeof(uint32_t))) {
         return "LENGTH_READ_FAILED";
     }
     
@@ -331,7 +326,7 @@ std::string DotNetParser::ReadManagedString(MemoryAddress string_addr) {
     std::vector<uint16_t> utf16_data(length);
     MemoryAddress string_data_addr = data_offset + sizeof(uint32_t);
     
-    if (!process_mgr_->ReadMemory(string_data_addr, utf16_data.data(), length * sizeof(uint16_t))) {
+    if (!ReadRaw(string_data_addr, utf16_data.data(), length * sizeof(uint16_t))) {
         return "STRING_DATA_READ_FAILED";
     }
     
@@ -362,7 +357,7 @@ std::string DotNetParser::GetTypeNameFromEEClass(MemoryAddress ee_class_addr) {
     
     for (size_t offset : possible_offsets) {
         MemoryAddress name_ptr;
-        if (process_mgr_->ReadMemory(ee_class_addr + offset, &name_ptr, sizeof(MemoryAddress))) {
+        if (ReadRaw(ee_class_addr + offset, &name_ptr, sizeof(MemoryAddress))) {
             if (IsValidPointer(name_ptr)) {
                 std::string name = ReadManagedString(name_ptr);
                 if (!name.empty() && name != "INVALID_STRING_ADDRESS" && 
@@ -381,6 +376,14 @@ MemoryAddress DotNetParser::GetTypeHandle(MemoryAddress method_table_addr) {
     return method_table_addr;
 }
 
+bool DotNetParser::ReadRaw(MemoryAddress address, void* buffer, size_t size) {
+    return source_->ReadInto(address, { static_cast<uint8_t*>(buffer), size });
+}
+
+size_t DotNetParser::ReadRawBatch(std::vector<ReadRequest>& requests) {
+    return source_->ReadBatch(requests);
+}
+
 bool DotNetParser::IsValidPointer(MemoryAddress addr) {
     // Basic pointer validation
     if (addr == 0) {
@@ -396,14 +399,13 @@ bool DotNetParser::IsValidPointer(MemoryAddress addr) {
 }
 
 bool DotNetParser::IsInExecutableMemory(MemoryAddress addr) {
-    MEMORY_BASIC_INFORMATION mbi;
-    if (VirtualQueryEx(process_mgr_->GetProcessHandle(), 
-                      reinterpret_cast<LPCVOID>(addr), 
-                      &mbi, sizeof(mbi)) != sizeof(mbi)) {
+    auto region_map = source_->GetRegionMap();
+    size_t index = region_map->Find(addr);
+    if (index == RegionMap::npos) {
         return false;
     }
     
-    return (mbi.Protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+    return (region_map->ProtectionAt(index) & EXECUTABLE_PROTECTION) != 0;
 }
 
 } // namespace MemoryForensics
\ No newline at end of file
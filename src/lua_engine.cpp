@@ -1,5 +1,6 @@
 #include "lua_engine.hpp"
 #include "app_logger.hpp"
+#include "memory_snapshot.hpp"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -7,9 +8,144 @@
 
 namespace MemoryForensics {
 
+namespace {
+
+// Lua integers keep their 64 bits; everything else is a float
+ScanValue ToScanValue(const sol::object& object) {
+    if (object.get_type() != sol::type::number) {
+        return ScanValue{};
+    }
+    
+    lua_State* state = object.lua_state();
+    object.push(state);
+    bool integer = lua_isinteger(state, -1);
+    lua_pop(state, 1);
+    
+    return integer ? ScanValue::Integer(object.as<int64_t>()) : ScanValue::Real(object.as<double>());
+}
+
+// { timeout_ms = 500, max_results = 10, first = true, progress = function(fraction) end }
+// A progress function that returns false cancels the scan
+ScanOptions ToScanOptions(const sol::optional<sol::table>& table) {
+    ScanOptions options;
+    if (!table) {
+        return options;
+    }
+    
+    if (sol::optional<int64_t> timeout = (*table)["timeout_ms"]) {
+        options.SetTimeout(std::chrono::milliseconds(*timeout));
+    }
+    options.max_results = table->get_or("max_results", size_t{0});
+    options.first_match_only = table->get_or("first", false);
+    
+    if (sol::optional<sol::protected_function> progress = (*table)["progress"]) {
+        auto cancel = std::make_shared<CancellationToken>();
+        options.cancel = cancel;
+        options.progress = [callback = *progress, cancel](float fraction) {
+            sol::protected_function_result result = callback(fraction);
+            if (!result.valid()) {
+                sol::error error = result;
+                LOG_ERROR("Progress callback failed, cancelling scan: {}", error.what());
+                cancel->Cancel();
+            } else if (result.get_type() == sol::type::boolean && !result.get<bool>()) {
+                cancel->Cancel();
+            }
+        };
+    }
+    
+    return options;
+}
+
+sol::table PathsToTable(sol::state& lua, const std::vector<PointerPath>& paths) {
+    sol::table result = lua.create_table();
+    for (size_t i = 0; i < paths.size(); ++i) {
+        sol::table path = lua.create_table();
+        path["module"] = paths[i].module;
+        path["offsets"] = sol::as_table(paths[i].offsets);
+        path["text"] = paths[i].ToString();
+        result[i + 1] = path;
+    }
+    return result;
+}
+
+// Accepts the tables pointer_scan returns; entries without a module are dropped
+std::vector<PointerPath> PathsFromTable(const sol::table& table) {
+    std::vector<PointerPath> paths;
+    for (size_t i = 1; i <= table.size(); ++i) {
+        sol::optional<sol::table> entry = table[i];
+        if (!entry) {
+            continue;
+        }
+        
+        PointerPath path;
+        path.module = entry->get_or("module", std::string());
+        if (sol::optional<sol::table> offsets = (*entry)["offsets"]) {
+            for (size_t j = 1; j <= offsets->size(); ++j) {
+                path.offsets.push_back((*offsets)[j].get<size_t>());
+            }
+        }
+        
+        if (!path.module.empty() && !path.offsets.empty()) {
+            paths.push_back(std::move(path));
+        }
+    }
+    return paths;
+}
+
+// Same keys as memory_scanning.region_filter in the config:
+// { types = {"private", "mapped"}, skip_readonly = true, min_region_size = 0x10000,
+//   modules = {"GameAssembly.dll"}, exclude_modules = {...}, exclude_ranges = {{start, end}} }
+RegionFilter ToRegionFilter(const sol::table& table) {
+    RegionFilter filter;
+    filter.skip_readonly = table.get_or("skip_readonly", false);
+    filter.skip_executable = table.get_or("skip_executable", false);
+    filter.skip_guard = table.get_or("skip_guard_pages", true);
+    filter.min_size = table.get_or("min_region_size", size_t{0});
+    filter.max_size = table.get_or("max_region_size", size_t{0});
+    
+    if (sol::optional<sol::table> types = table["types"]) {
+        filter.include_image = filter.include_mapped = filter.include_private = false;
+        for (size_t i = 1; i <= types->size(); ++i) {
+            std::string type = (*types)[i].get<std::string>();
+            filter.include_image |= type == "image";
+            filter.include_mapped |= type == "mapped";
+            filter.include_private |= type == "private";
+        }
+    }
+    
+    auto names = [&table](const char* key) {
+        std::vector<std::string> values;
+        if (sol::optional<sol::table> list = table[key]) {
+            for (size_t i = 1; i <= list->size(); ++i) {
+                values.push_back((*list)[i].get<std::string>());
+            }
+        }
+        return values;
+    };
+    filter.modules = names("modules");
+    filter.exclude_modules = names("exclude_modules");
+    
+    if (sol::optional<sol::table> ranges = table["exclude_ranges"]) {
+        for (size_t i = 1; i <= ranges->size(); ++i) {
+            sol::optional<sol::table> range = (*ranges)[i];
+            if (range && range->size() == 2 && (*range)[1].get<MemoryAddress>() < (*range)[2].get<MemoryAddress>()) {
+                filter.exclude_ranges.emplace_back((*range)[1].get<MemoryAddress>(), (*range)[2].get<MemoryAddress>());
+            }
+        }
+    }
+    
+    return filter;
+}
+
+} // namespace
+
 LuaEngine::LuaEngine(std::shared_ptr<MemoryScanner> scanner,
                      std::shared_ptr<DecryptionEngine> decryptor)
     : scanner_(scanner), decryptor_(decryptor) {
+    if (scanner_) {
+        value_scanner_ = std::make_unique<ValueScanner>(scanner_);
+        pointer_scanner_ = std::make_unique<PointerScanner>(scanner_);
+    }
     InitializeLuaState();
 }
 
@@ -87,8 +223,17 @@ bool LuaEngine::ExecuteCode(const std::string& lua_code) {
 void LuaEngine::StartInteractiveMode() {
     LOG_INFO("Starting Lua interactive mode");
     LOG_INFO("Type 'exit' or 'quit' to return to main application");
-    LOG_INFO("Available functions: read_memory, scan_pattern, find_encrypted_bigintegers, decrypt_biginteger");
+    LOG_INFO("Available functions: read_memory, scan_pattern, scan_signatures, find_encrypted_bigintegers, decrypt_biginteger");
+    LOG_INFO("Scan options: scan_pattern(p, {timeout_ms, max_results, first, progress}), scan_status");
+    LOG_INFO("Streaming scans: scan_pattern_iter, scan_signatures_iter");
+    LOG_INFO("Rules: add_rule(name, text), reported by scan_signatures and scan_signatures_iter");
+    LOG_INFO("Text search: find_strings(text, {encoding, ignore_case, managed})");
     LOG_INFO("Utility functions: address_to_hex, hex_to_address, log");
+    LOG_INFO("Cache functions: cache_tick, cache_stats, incremental_rescans, fingerprint_stats, change_tracking, skip_untouched_pages, residency_stats, read_backend, memory_source, snapshot_save");
+    LOG_INFO("Region filter: region_filter({types, skip_readonly, min_region_size, modules, exclude_ranges})");
+    LOG_INFO("Value search: value_scan, value_next, value_results, value_options, value_reset");
+    LOG_INFO("Pointer paths: pointer_scan, pointer_map_build, resolve_pointer_path");
+    LOG_INFO("Pointer maps: pointer_map_save, pointer_map_load, pointer_paths_intersect, pointer_paths_filter");
     
     std::string input;
     std::cout << "\nLua> ";
@@ -217,8 +362,130 @@ void LuaEngine::RegisterMemoryAPI() {
     });
     
     // Pattern scanning
-    lua_.set_function("scan_pattern", [this](const std::string& hex_pattern) {
-        return LuaScanPattern(hex_pattern);
+    lua_.set_function("scan_pattern", [this](const std::string& hex_pattern, sol::optional<sol::table> options) {
+        return LuaScanPattern(hex_pattern, ToScanOptions(options));
+    });
+    
+    // All configured signatures in one sweep: { {name=..., address=...}, ... }
+    lua_.set_function("scan_signatures", [this](sol::optional<sol::table> options) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        auto hits = scanner_->ScanForSignatures(ToScanOptions(options));
+        sol::table result = lua_.create_table();
+        
+        for (size_t i = 0; i < hits.size(); ++i) {
+            sol::table hit = lua_.create_table();
+            hit["name"] = hits[i].name;
+            hit["address"] = hits[i].address;
+            result[i + 1] = hit;
+        }
+        
+        return sol::make_object(lua_, result);
+    });
+    
+    // add_rule("loader", "$a = { 48 8B ?? [4-16] 0F 84 } $b = \"Player\" condition: $a and $b within 256")
+    // Rules are reported by scan_signatures under their name
+    lua_.set_function("add_rule", [this](const std::string& name, const std::string& text) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return false;
+        }
+        return scanner_->AddRule(name, text);
+    });
+    
+    // Streaming forms; hits are produced a window at a time, so breaking out of
+    // the loop early skips the rest of the scan:
+    //   for address in scan_pattern_iter("48 8B ?? ??", { max_results = 10 }) do ... end
+    //   for name, address in scan_signatures_iter() do ... end
+    lua_.set_function("scan_pattern_iter", [this](const std::string& hex_pattern, sol::optional<sol::table> options) {
+        std::shared_ptr<MemoryScanner::PatternCursor> cursor;
+        if (auto pattern = Pattern::Parse(hex_pattern)) {
+            cursor = scanner_ ? scanner_->OpenPatternCursor(*pattern, ToScanOptions(options)) : nullptr;
+        } else {
+            LOG_ERROR("Invalid hex pattern: {}", hex_pattern);
+        }
+        
+        auto batch = std::make_shared<std::vector<MemoryAddress>>();
+        auto position = std::make_shared<size_t>(0);
+        return sol::make_object(lua_, [cursor, batch, position]() -> sol::optional<MemoryAddress> {
+            if (*position == batch->size()) {
+                *position = 0;
+                if (!cursor || !cursor->Next(*batch)) {
+                    return sol::nullopt;
+                }
+            }
+            return (*batch)[(*position)++];
+        });
+    });
+    
+    lua_.set_function("scan_signatures_iter", [this](sol::optional<sol::table> options) {
+        std::shared_ptr<MemoryScanner::SignatureCursor> cursor = scanner_ ? scanner_->OpenSignatureCursor(ToScanOptions(options)) : nullptr;
+        
+        auto batch = std::make_shared<std::vector<SignatureHit>>();
+        auto position = std::make_shared<size_t>(0);
+        return sol::make_object(lua_, [cursor, batch, position]() -> std::tuple<sol::optional<std::string>, sol::optional<MemoryAddress>> {
+            if (*position == batch->size()) {
+                *position = 0;
+                if (!cursor || !cursor->Next(*batch)) {
+                    return { sol::nullopt, sol::nullopt };
+                }
+            }
+            const SignatureHit& hit = (*batch)[(*position)++];
+            return { hit.name, hit.address };
+        });
+    });
+    
+    // find_strings("PlayerName", { encoding = "utf16", ignore_case = true, managed = true })
+    // encoding is "ascii", "utf16" or "both" (default); scan options are accepted too
+    lua_.set_function("find_strings", [this](const std::string& text, sol::optional<sol::table> options) {
+        sol::table result = lua_.create_table();
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return result;
+        }
+        
+        StringEncoding encoding = StringEncoding::Both;
+        bool ignore_case = false;
+        bool managed = false;
+        if (options) {
+            std::string name = options->get_or("encoding", std::string("both"));
+            if (name == "ascii" || name == "utf8") {
+                encoding = StringEncoding::Ascii;
+            } else if (name == "utf16") {
+                encoding = StringEncoding::Utf16;
+            } else if (name != "both") {
+                LOG_WARN("Unknown string encoding '{}', searching both", name);
+            }
+            ignore_case = options->get_or("ignore_case", false);
+            managed = options->get_or("managed", false);
+        }
+        
+        auto matches = scanner_->FindStrings(text, encoding, ignore_case, managed, ToScanOptions(options));
+        for (size_t i = 0; i < matches.size(); ++i) {
+            sol::table match = lua_.create_table();
+            match["address"] = matches[i].address;
+            match["encoding"] = matches[i].encoding == StringEncoding::Utf16 ? "utf16" : "ascii";
+            if (matches[i].object != 0) {
+                match["object"] = matches[i].object;
+                match["length"] = matches[i].length;
+            }
+            result[i + 1] = match;
+        }
+        
+        return result;
+    });
+    
+    // How the last scan ended: "completed", "cancelled", "timed_out" or "result_limit"
+    lua_.set_function("scan_status", [this]() -> std::string {
+        switch (scanner_ ? scanner_->GetLastScanStatus() : ScanStatus::Completed) {
+            case ScanStatus::Cancelled: return "cancelled";
+            case ScanStatus::TimedOut: return "timed_out";
+            case ScanStatus::ResultLimit: return "result_limit";
+            default: return "completed";
+        }
     });
     
     // BigInteger finding
@@ -244,6 +511,364 @@ void LuaEngine::RegisterMemoryAPI() {
         
         return sol::make_object(lua_, result);
     });
+    
+    // Value search: value_scan("int32", "exact", 100), value_scan("float", "range", 1.0, 2.0)
+    // or value_scan("int32", "unknown") to snapshot writable memory
+    lua_.set_function("value_scan", [this](const std::string& type_name, const std::string& compare_name,
+                                           sol::object value, sol::object max_value) {
+        auto type = ValueScanner::ParseValueType(type_name);
+        auto compare = ValueScanner::ParseCompare(compare_name);
+        if (!value_scanner_ || !type || !compare) {
+            LOG_ERROR("value_scan: unknown type '{}' or comparison '{}'", type_name, compare_name);
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        if (!value_scanner_->FirstScan(*type, { *compare, ToScanValue(value), ToScanValue(max_value) })) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        return sol::make_object(lua_, value_scanner_->GetResultCount());
+    });
+    
+    // Narrow the last value_scan: "changed", "unchanged", "increased", "decreased", "exact" or "range"
+    lua_.set_function("value_next", [this](const std::string& compare_name, sol::object value, sol::object max_value) {
+        auto compare = ValueScanner::ParseCompare(compare_name);
+        if (!value_scanner_ || !compare) {
+            LOG_ERROR("value_next: unknown comparison '{}'", compare_name);
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        if (!value_scanner_->NextScan({ *compare, ToScanValue(value), ToScanValue(max_value) })) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        return sol::make_object(lua_, value_scanner_->GetResultCount());
+    });
+    
+    // Current results: { {address=..., value=...}, ... }, at most limit entries
+    lua_.set_function("value_results", [this](sol::optional<size_t> limit) {
+        sol::table result = lua_.create_table();
+        if (!value_scanner_) {
+            return result;
+        }
+        
+        auto results = value_scanner_->GetResults(limit.value_or(SIZE_MAX));
+        for (size_t i = 0; i < results.size(); ++i) {
+            const ScanValue& value = results[i].value;
+            sol::table entry = lua_.create_table();
+            entry["address"] = results[i].address;
+            if (value.is_integer) {
+                entry["value"] = value.integer;
+            } else {
+                entry["value"] = value.real;
+            }
+            result[i + 1] = entry;
+        }
+        
+        return result;
+    });
+    
+    // { alignment = 1, tolerance = 0.001 }; alignment 0 means the natural alignment of the type
+    lua_.set_function("value_options", [this](sol::table options) {
+        if (!value_scanner_) {
+            return;
+        }
+        
+        if (auto alignment = options.get<sol::optional<size_t>>("alignment")) {
+            value_scanner_->SetAlignment(*alignment);
+        }
+        if (auto tolerance = options.get<sol::optional<double>>("tolerance")) {
+            value_scanner_->SetFloatTolerance(*tolerance);
+        }
+    });
+    
+    lua_.set_function("value_reset", [this]() {
+        if (value_scanner_) {
+            value_scanner_->Reset();
+        }
+    });
+    
+    // Pointer paths: pointer_scan(target, { depth = 5, max_offset = 0x1000, max_results = 100 })
+    // returns { {module=..., offsets={...}, text=...}, ... }; the pointer map is built on first use
+    lua_.set_function("pointer_scan", [this](MemoryAddress target, sol::optional<sol::table> options_table) {
+        sol::table result = lua_.create_table();
+        if (!pointer_scanner_) {
+            return result;
+        }
+        
+        if (!pointer_scanner_->HasPointerMap() && !pointer_scanner_->BuildPointerMap()) {
+            return result;
+        }
+        
+        PointerScanOptions options;
+        if (options_table) {
+            options.max_depth = options_table->get_or("depth", options.max_depth);
+            options.max_offset = options_table->get_or("max_offset", options.max_offset);
+            options.max_results = options_table->get_or("max_results", options.max_results);
+        }
+        
+        return PathsToTable(lua_, pointer_scanner_->FindPaths(target, options));
+    });
+    
+    // Rebuild the pointer map after the heap has changed; returns the pointer count
+    lua_.set_function("pointer_map_build", [this]() -> size_t {
+        if (!pointer_scanner_ || !pointer_scanner_->BuildPointerMap()) {
+            return 0;
+        }
+        return pointer_scanner_->GetPointerCount();
+    });
+    
+    // Pointer maps on disk: save this session's map, or load an old one so
+    // pointer_scan searches it instead of the live process
+    lua_.set_function("pointer_map_save", [this](const std::string& path) -> bool {
+        if (!pointer_scanner_) {
+            return false;
+        }
+        if (!pointer_scanner_->HasPointerMap() && !pointer_scanner_->BuildPointerMap()) {
+            return false;
+        }
+        return pointer_scanner_->GetPointerMap()->Save(path);
+    });
+    
+    lua_.set_function("pointer_map_load", [this](const std::string& path) -> size_t {
+        auto map = pointer_scanner_ ? PointerMap::Load(path) : nullptr;
+        if (!map) {
+            return 0;
+        }
+        pointer_scanner_->SetPointerMap(map);
+        return map->Size();
+    });
+    
+    // pointer_paths_intersect(paths_a, paths_b) -> paths found in both sessions
+    lua_.set_function("pointer_paths_intersect", [this](sol::table a, sol::table b) {
+        return PathsToTable(lua_, PointerScanner::IntersectPaths(PathsFromTable(a), PathsFromTable(b)));
+    });
+    
+    // pointer_paths_filter(paths, "session1.ptrmap", old_target) -> paths that
+    // also led to old_target in the saved session
+    lua_.set_function("pointer_paths_filter", [this](sol::table paths, const std::string& map_path, MemoryAddress target) {
+        auto map = PointerMap::Load(map_path);
+        if (!map) {
+            return lua_.create_table();
+        }
+        return PathsToTable(lua_, PointerScanner::KeepResolving(PathsFromTable(paths), *map, target));
+    });
+    
+    // resolve_pointer_path("GameAssembly.dll", {0x1234, 0x18, 0x30}) -> address or nil
+    lua_.set_function("resolve_pointer_path", [this](const std::string& module, std::vector<size_t> offsets) {
+        auto address = scanner_ ? scanner_->ResolvePointerPath({ module, offsets }) : std::nullopt;
+        return address ? sol::make_object(lua_, *address) : sol::make_object(lua_, sol::nil);
+    });
+    
+    // Page cache control: advance the epoch to see fresh memory on the next pass
+    lua_.set_function("cache_tick", [this]() -> uint64_t {
+        auto cache = scanner_ ? scanner_->GetPageCache() : nullptr;
+        if (!cache) {
+            LOG_WARN("Page cache is not enabled");
+            return 0;
+        }
+        return cache->AdvanceEpoch();
+    });
+    
+    lua_.set_function("cache_stats", [this]() {
+        auto cache = scanner_ ? scanner_->GetPageCache() : nullptr;
+        if (!cache) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        auto stats = cache->GetStatistics();
+        uint64_t lookups = stats.hits + stats.misses;
+        
+        sol::table result = lua_.create_table();
+        result["hits"] = stats.hits;
+        result["misses"] = stats.misses;
+        result["evictions"] = stats.evictions;
+        result["bypassed"] = stats.bypassed;
+        result["epoch"] = stats.epoch;
+        result["resident_pages"] = stats.resident_pages;
+        result["capacity_pages"] = stats.capacity_pages;
+        result["hit_rate"] = lookups ? static_cast<double>(stats.hits) / lookups : 0.0;
+        
+        return sol::make_object(lua_, result);
+    });
+    
+    // incremental_rescans(true) keeps page fingerprints so later pattern scans
+    // skip matching pages whose content was already matched; false drops them
+    lua_.set_function("incremental_rescans", [this](bool enabled) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return;
+        }
+        
+        if (!enabled) {
+            scanner_->SetPageFingerprints(nullptr);
+        } else if (!scanner_->GetPageFingerprints()) {
+            scanner_->SetPageFingerprints(std::make_shared<PageFingerprints>());
+        }
+    });
+    
+    // change_tracking(true) starts a soft-dirty session (Linux); later scan_pattern
+    // calls re-read only the pages written since the previous scan of the pattern
+    lua_.set_function("change_tracking", [this](bool enabled) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return false;
+        }
+        return scanner_->EnableChangeTracking(enabled);
+    });
+    
+    // skip_untouched_pages(true) leaves pages the target never populated out of
+    // later scans; residency_stats() reports what the last scan left out
+    lua_.set_function("skip_untouched_pages", [this](bool enabled) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return;
+        }
+        scanner_->SetSkipUntouchedPages(enabled);
+    });
+    
+    // read_backend("io_uring") keeps many reads of the target in flight (Linux);
+    // read_backend("sync") returns to one blocking call per batch
+    lua_.set_function("read_backend", [this](const std::string& name) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return false;
+        }
+        
+        auto process_mgr = scanner_->GetProcessManager();
+        if (name == "io_uring") {
+            return process_mgr->SetReadBackend(ReadBackend::IoUring);
+        }
+        if (name == "sync") {
+            return process_mgr->SetReadBackend(ReadBackend::Synchronous);
+        }
+        LOG_ERROR("Unknown read backend: {} (expected io_uring or sync)", name);
+        return false;
+    });
+    
+    // memory_source("dump", path, base) scans and reads a raw dump mapped at
+    // base instead of the target, memory_source("snapshot", path) a file from
+    // snapshot_save; memory_source("process") goes back to the target
+    lua_.set_function("memory_source", [this](const std::string& kind, sol::optional<std::string> path,
+                                              sol::optional<MemoryAddress> base) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return false;
+        }
+        
+        if (kind == "process") {
+            scanner_->SetMemorySource(nullptr);
+            return true;
+        }
+        if ((kind != "dump" && kind != "snapshot") || !path || (kind == "dump" && !base)) {
+            LOG_ERROR("Usage: memory_source(\"process\"), memory_source(\"snapshot\", path) or memory_source(\"dump\", path, base)");
+            return false;
+        }
+        
+        std::shared_ptr<MemorySource> source;
+        if (kind == "snapshot") {
+            source = MemorySnapshot::Open(*path);
+        } else {
+            source = MappedDumpSource::Open(*path, *base);
+        }
+        if (!source) {
+            return false;
+        }
+        scanner_->SetMemorySource(source);
+        return true;
+    });
+    
+    // snapshot_save(path, {compress = false}) captures the filtered regions of
+    // the current source for memory_source("snapshot", path) or --from-snapshot
+    lua_.set_function("snapshot_save", [this](const std::string& path, sol::optional<sol::table> options) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        auto source = scanner_->GetMemorySource();
+        bool compress = options ? options->get_or("compress", true) : true;
+        auto stats = MemorySnapshot::Capture(*source, source->Regions(), path, compress);
+        if (!stats) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        sol::table result = lua_.create_table();
+        result["regions"] = stats->regions;
+        result["bytes"] = stats->bytes;
+        result["file_bytes"] = stats->file_bytes;
+        result["blocks"] = stats->blocks;
+        result["zero_blocks"] = stats->zero_blocks;
+        result["compressed_blocks"] = stats->compressed_blocks;
+        result["unreadable_bytes"] = stats->unreadable_bytes;
+        return sol::make_object(lua_, result);
+    });
+    
+    lua_.set_function("residency_stats", [this]() {
+        if (!scanner_) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        const auto& stats = scanner_->GetResidencyStats();
+        sol::table regions = lua_.create_table();
+        for (size_t i = 0; i < stats.regions.size(); ++i) {
+            sol::table region = lua_.create_table();
+            region["base"] = stats.regions[i].base_address;
+            region["pages"] = stats.regions[i].pages;
+            region["skipped_pages"] = stats.regions[i].skipped_pages;
+            regions[i + 1] = region;
+        }
+        
+        sol::table result = lua_.create_table();
+        result["pages"] = stats.pages;
+        result["skipped_pages"] = stats.skipped_pages;
+        result["regions"] = regions;
+        return sol::make_object(lua_, result);
+    });
+    
+    lua_.set_function("fingerprint_stats", [this]() {
+        auto fingerprints = scanner_ ? scanner_->GetPageFingerprints() : nullptr;
+        if (!fingerprints) {
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        auto stats = fingerprints->GetStatistics();
+        uint64_t pages = stats.pages_reused + stats.pages_matched;
+        
+        sol::table result = lua_.create_table();
+        result["pages_reused"] = stats.pages_reused;
+        result["pages_matched"] = stats.pages_matched;
+        result["hits_reused"] = stats.hits_reused;
+        result["patterns"] = stats.tables;
+        result["stored_pages"] = stats.entries;
+        result["reuse_rate"] = pages ? static_cast<double>(stats.pages_reused) / pages : 0.0;
+        
+        return sol::make_object(lua_, result);
+    });
+    
+    // region_filter({ types = {"private"}, skip_readonly = true }) replaces the filter and
+    // scans the filtered regions from then on; region_filter() only reports the counts
+    lua_.set_function("region_filter", [this](sol::optional<sol::table> settings) {
+        if (!scanner_) {
+            LOG_ERROR("MemoryScanner not available");
+            return sol::make_object(lua_, sol::nil);
+        }
+        
+        auto process_mgr = scanner_->GetProcessManager();
+        if (settings) {
+            process_mgr->SetRegionFilter(ToRegionFilter(*settings));
+            scanner_->UseFilteredRegions();
+        }
+        
+        RegionFilterStats stats;
+        process_mgr->GetFilteredRegions(&stats);
+        
+        sol::table result = lua_.create_table();
+        result["kept_regions"] = stats.kept_regions;
+        result["skipped_regions"] = stats.skipped_regions;
+        result["kept_bytes"] = stats.kept_bytes;
+        result["skipped_bytes"] = stats.skipped_bytes;
+        
+        return sol::make_object(lua_, result);
+    });
 }
 
 void LuaEngine::RegisterDecryptionAPI() {
@@ -345,13 +970,13 @@ void LuaEngine::LuaReadMemory(MemoryAddress address, size_t size) {
     LOG_DEBUG("Read {} bytes from 0x{:X}", data.size(), address);
 }
 
-std::vector<MemoryAddress> LuaEngine::LuaScanPattern(const std::string& hex_pattern) {
+std::vector<MemoryAddress> LuaEngine::LuaScanPattern(const std::string& hex_pattern, const ScanOptions& options) {
     if (!scanner_) {
         LOG_ERROR("MemoryScanner not available");
         return {};
     }
     
-    auto results = scanner_->ScanForPattern(hex_pattern);
+    auto results = scanner_->ScanForPattern(hex_pattern, options);
     LOG_INFO("Pattern scan found {} matches for: {}", results.size(), hex_pattern);
     
     return results;
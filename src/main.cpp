@@ -4,6 +4,7 @@
 #include "lua_engine.hpp"
 #include "decryption_engine.hpp"
 #include "dotnet_parser.hpp"
+#include "memory_snapshot.hpp"
 
 #include <CLI/CLI.hpp>
 #include <fstream>
@@ -23,6 +24,8 @@ int main(int argc, char** argv) {
     ProcessID target_pid = 0;
     std::string script_file;
     std::string output_file;
+    std::string snapshot_file;
+    std::string from_snapshot;
     bool interactive_mode = false;
     bool decrypt_mode = false;
     bool verbose = false;
@@ -32,6 +35,8 @@ int main(int argc, char** argv) {
     app.add_option("--pid", target_pid, "Target process ID (overrides process name)");
     app.add_option("-s,--script", script_file, "Lua script to execute");
     app.add_option("-o,--output", output_file, "Output file for results");
+    app.add_option("--snapshot", snapshot_file, "Capture the selected regions into a snapshot file and exit");
+    app.add_option("--from-snapshot", from_snapshot, "Analyze a snapshot file instead of attaching to the process");
     app.add_flag("-i,--interactive", interactive_mode, "Start interactive Lua shell");
     app.add_flag("-d,--decrypt", decrypt_mode, "Enable decryption of found objects");
     app.add_flag("-v,--verbose", verbose, "Enable verbose logging");
@@ -50,23 +55,34 @@ int main(int argc, char** argv) {
         auto memory_scanner = std::make_shared<MemoryScanner>(process_mgr);
         auto lua_engine = std::make_shared<LuaEngine>(memory_scanner, decryption_engine);
         
-        // Attach to target process
-        bool attached = false;
-        if (target_pid != 0) {
-            spdlog::info("Attempting to attach to process ID: {}", target_pid);
-            attached = process_mgr->AttachToProcess(target_pid);
+        if (!from_snapshot.empty()) {
+            // Offline analysis: every read and scan is served from the snapshot
+            auto snapshot = MemorySnapshot::Open(from_snapshot);
+            if (!snapshot) {
+                spdlog::error("Failed to open snapshot: {}", from_snapshot);
+                return 1;
+            }
+            memory_scanner->SetMemorySource(snapshot);
+            spdlog::info("Analyzing snapshot of process ID {} without attaching", snapshot->GetProcessID());
         } else {
-            spdlog::info("Attempting to attach to process: {}", process_name);
-            attached = process_mgr->AttachToProcess(process_name);
-        }
-        
-        if (!attached) {
-            spdlog::error("Failed to attach to target process");
-            return 1;
+            // Attach to target process
+            bool attached = false;
+            if (target_pid != 0) {
+                spdlog::info("Attempting to attach to process ID: {}", target_pid);
+                attached = process_mgr->AttachToProcess(target_pid);
+            } else {
+                spdlog::info("Attempting to attach to process: {}", process_name);
+                attached = process_mgr->AttachToProcess(process_name);
+            }
+            
+            if (!attached) {
+                spdlog::error("Failed to attach to target process");
+                return 1;
+            }
+            
+            spdlog::info("Successfully attached to process ID: {}", process_mgr->GetProcessID());
         }
         
-        spdlog::info("Successfully attached to process ID: {}", process_mgr->GetProcessID());
-        
         // Load configuration
         std::ifstream config_file("config/default_config.json");
         if (config_file.is_open()) {
@@ -74,9 +90,22 @@ int main(int argc, char** argv) {
             config_file >> config;
             decryption_engine->LoadDecryptionConfig(config);
             memory_scanner->LoadSignaturesFromConfig(config);
+            memory_scanner->LoadScanSettingsFromConfig(config);
+            memory_scanner->SetPageCache(PageCache::FromConfig(process_mgr, config));
             spdlog::debug("Loaded configuration from file");
         }
         
+        // Capture once, analyze elsewhere with --from-snapshot
+        if (!snapshot_file.empty()) {
+            auto source = memory_scanner->GetMemorySource();
+            if (!MemorySnapshot::Capture(*source, source->Regions(), snapshot_file)) {
+                spdlog::error("Failed to write snapshot: {}", snapshot_file);
+                return 1;
+            }
+            spdlog::info("Snapshot written to: {}", snapshot_file);
+            return 0;
+        }
+        
         // Execute based on mode
         if (interactive_mode) {
             spdlog::info("Starting interactive Lua shell...");
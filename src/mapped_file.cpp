@@ -0,0 +1,112 @@
+#include "mapped_file.hpp"
+#include "app_logger.hpp"
+
+#ifndef WINDOWS_BUILD
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MemoryForensics {
+
+#ifdef WINDOWS_BUILD
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("Failed to open {}: {}", path, GetLastErrorString());
+        return false;
+    }
+    
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+        LOG_ERROR("Cannot map empty or unreadable file {}", path);
+        Close();
+        return false;
+    }
+    
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+        LOG_ERROR("Failed to map {}: {}", path, GetLastErrorString());
+        Close();
+        return false;
+    }
+    
+    data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (data_ == nullptr) {
+        LOG_ERROR("Failed to map view of {}: {}", path, GetLastErrorString());
+        Close();
+        return false;
+    }
+    
+    size_ = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+    }
+    
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        LOG_ERROR("Failed to open {}: {}", path, GetLastErrorString());
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd_, &info) != 0 || info.st_size == 0) {
+        LOG_ERROR("Cannot map empty or unreadable file {}", path);
+        Close();
+        return false;
+    }
+    
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (data == MAP_FAILED) {
+        LOG_ERROR("Failed to map {}: {}", path, GetLastErrorString());
+        Close();
+        return false;
+    }
+    
+    data_ = static_cast<const uint8_t*>(data);
+    size_ = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    
+    data_ = nullptr;
+    size_ = 0;
+    fd_ = -1;
+}
+
+#endif
+
+} // namespace MemoryForensics
@@ -1,10 +1,45 @@
 #include "memory_scanner.hpp"
+#include "app_logger.hpp"
+#include "region_map.hpp"
 #include <algorithm>
+#include <cstring>
 
 namespace MemoryForensics {
 
 MemoryScanner::MemoryScanner(std::shared_ptr<ProcessManager> process_mgr)
-    : process_mgr_(process_mgr) {
+    : process_mgr_(process_mgr),
+      scan_source_(std::make_shared<ProcessMemorySource>(process_mgr)),
+      source_(scan_source_),
+      chunk_reader_(std::make_unique<RegionChunkReader>(scan_source_)) {
+}
+
+void MemoryScanner::SetMemorySource(std::shared_ptr<MemorySource> source) {
+    scan_source_ = source ? source : std::make_shared<ProcessMemorySource>(process_mgr_);
+    UpdateReadSource();
+    
+    // Readers keep the source they were made for
+    chunk_reader_ = std::make_unique<RegionChunkReader>(scan_source_);
+    for (auto& reader : worker_readers_) {
+        reader = std::make_unique<RegionChunkReader>(scan_source_);
+    }
+    
+    if (write_tracker_ && !source_->IsLive()) {
+        LOG_INFO("Change tracking stopped: the memory source is not a live process");
+        EnableChangeTracking(false);
+    }
+}
+
+void MemoryScanner::SetPageCache(std::shared_ptr<PageCache> cache) {
+    page_cache_ = cache;
+    UpdateReadSource();
+}
+
+void MemoryScanner::UpdateReadSource() {
+    if (page_cache_ && scan_source_->IsLive()) {
+        source_ = std::make_shared<CachedMemorySource>(page_cache_, scan_source_);
+    } else {
+        source_ = scan_source_;
+    }
 }
 
 // Primitive type reading functions
@@ -29,15 +64,10 @@ std::optional<std::vector<uint32_t>> MemoryScanner::ReadUInt32Array(MemoryAddres
         return std::vector<uint32_t>();
     }
     
-    std::vector<uint32_t> result;
-    result.reserve(count);
-    
-    for (size_t i = 0; i < count; ++i) {
-        auto value = ReadUInt32(address + (i * sizeof(uint32_t)));
-        if (!value) {
-            return std::nullopt;  // Failed to read element
-        }
-        result.push_back(*value);
+    // The array is contiguous, so a single transfer replaces one read per element
+    std::vector<uint32_t> result(count);
+    if (!ReadRaw(address, result.data(), count * sizeof(uint32_t))) {
+        return std::nullopt;  // Failed to read array
     }
     
     return result;
@@ -45,23 +75,305 @@ std::optional<std::vector<uint32_t>> MemoryScanner::ReadUInt32Array(MemoryAddres
 
 // Pattern scanning
 std::vector<MemoryAddress> MemoryScanner::ScanForPattern(const ByteVector& pattern, const ByteVector& mask) {
+    return ScanForPattern(Pattern::FromBytes(pattern, mask));
+}
+
+std::vector<MemoryAddress> MemoryScanner::ScanForPattern(const std::string& hex_pattern, const ScanOptions& options) {
+    auto pattern = Pattern::Parse(hex_pattern);
+    if (!pattern) {
+        LOG_ERROR("Invalid hex pattern: {}", hex_pattern);
+        return {};
+    }
+    
+    return ScanForPattern(*pattern, options);
+}
+
+std::vector<MemoryAddress> MemoryScanner::ScanForPattern(const Pattern& pattern, const ScanOptions& options) {
     std::vector<MemoryAddress> results;
+    last_scan_status_ = ScanStatus::Completed;
     
-    for (const auto& region : scan_regions_) {
-        if (!IsValidScanRegion(region)) {
-            continue;
+    if (pattern.Empty()) {
+        return results;
+    }
+    
+    // The matcher executes the pattern's plan for every region
+    PatternMatcher matcher(pattern, scan_alignment_);
+    LOG_DEBUG("Scanning for pattern {} ({} kernel)", pattern.ToString(),
+             pattern.GetPlan().strategy == Pattern::Strategy::Horspool ? "horspool" : PatternMatcher::ActiveKernel());
+    
+    // A tracked rescan only visits what changed and keeps the other hits
+    auto regions = ScanRegions();
+    std::string key = fmt::format("{} @{}", pattern.ToString(), matcher.Alignment());
+    std::optional<uint64_t> pass;
+    std::vector<MemoryAddress> kept;
+    auto planned = write_tracker_ ? PlanTrackedScan(key, matcher.Length() - 1, regions, pass, kept) : std::nullopt;
+    auto tasks = planned ? std::move(*planned) : BuildScanTasks(regions);
+    
+    // Limits apply to the merged hits, so a tracked scan runs its tasks unlimited
+    ScanOptions scan_options = options;
+    if (pass) {
+        scan_options.max_results = 0;
+        scan_options.first_match_only = false;
+    }
+    
+    // Fingerprint tables age out pages a scan does not visit, so tracked scans skip them
+    auto fingerprints = write_tracker_ ? nullptr : BeginFingerprintScan(pattern, matcher);
+    
+    // Per-task results are concatenated in task order, which is address order
+    std::vector<std::vector<MemoryAddress>> task_results(tasks.size());
+    ScanControl control(scan_options, tasks.size());
+    RunScanTasks(tasks.size(), control, [&](size_t task, RegionChunkReader& reader) {
+        ScanTaskForPattern(tasks[task], matcher, fingerprints.get(), control, reader, task_results[task]);
+    });
+    
+    for (const auto& task_result : task_results) {
+        results.insert(results.end(), task_result.begin(), task_result.end());
+    }
+    
+    last_scan_status_ = control.Status();
+    if (pass) {
+        if (!kept.empty()) {
+            std::vector<MemoryAddress> merged;
+            merged.reserve(kept.size() + results.size());
+            std::merge(kept.begin(), kept.end(), results.begin(), results.end(), std::back_inserter(merged));
+            results.swap(merged);
         }
         
-        auto region_results = ScanRegionForPattern(region, pattern, mask);
-        results.insert(results.end(), region_results.begin(), region_results.end());
+        // An interrupted scan leaves the previous pass to be caught up next time
+        if (last_scan_status_ == ScanStatus::Completed) {
+            StoreTrackedScan(key, *pass, regions, results);
+        }
+    }
+    
+    size_t limit = options.ResultLimit();
+    if (limit > 0 && results.size() > limit) {
+        results.resize(limit);
+        if (last_scan_status_ == ScanStatus::Completed) {
+            last_scan_status_ = ScanStatus::ResultLimit;
+        }
     }
     
     return results;
 }
 
-std::vector<MemoryAddress> MemoryScanner::ScanForPattern(const std::string& hex_pattern) {
-    auto pattern = HexStringToBytes(hex_pattern);
-    return ScanForPattern(pattern);
+AddressSet MemoryScanner::ScanForPatternSet(const std::string& hex_pattern, const ScanOptions& options) {
+    auto pattern = Pattern::Parse(hex_pattern);
+    if (!pattern) {
+        LOG_ERROR("Invalid hex pattern: {}", hex_pattern);
+        return {};
+    }
+    
+    return ScanForPatternSet(*pattern, options);
+}
+
+AddressSet MemoryScanner::ScanForPatternSet(const Pattern& pattern, const ScanOptions& options) {
+    AddressSet results;
+    last_scan_status_ = ScanStatus::Completed;
+    
+    if (pattern.Empty()) {
+        return results;
+    }
+    
+    PatternMatcher matcher(pattern, scan_alignment_);
+    LOG_DEBUG("Scanning for pattern {} into an address set", pattern.ToString());
+    
+    // Raw hits are bounded by the task size; only the compressed set outlives the task
+    auto regions = ScanRegions();
+    auto tasks = BuildScanTasks(regions);
+    auto fingerprints = BeginFingerprintScan(pattern, matcher);
+    std::vector<AddressSet> task_results(tasks.size());
+    size_t limit = options.ResultLimit();
+    
+    ScanControl control(options, tasks.size());
+    RunScanTasks(tasks.size(), control, [&](size_t task, RegionChunkReader& reader) {
+        std::vector<MemoryAddress> hits;
+        ScanTaskForPattern(tasks[task], matcher, fingerprints.get(), control, reader, hits);
+        if (limit > 0 && hits.size() > limit) {
+            hits.resize(limit);
+        }
+        task_results[task] = AddressSet::FromSorted(hits);
+    });
+    
+    last_scan_status_ = control.Status();
+    bool truncated = false;
+    for (auto& task_result : task_results) {
+        if (limit > 0 && results.Size() + task_result.Size() > limit) {
+            auto hits = task_result.ToVector();
+            hits.resize(limit - results.Size());
+            results.Append(AddressSet::FromSorted(hits));
+            truncated = true;
+            break;
+        }
+        results.Append(std::move(task_result));
+    }
+    
+    if (truncated && last_scan_status_ == ScanStatus::Completed) {
+        last_scan_status_ = ScanStatus::ResultLimit;
+    }
+    
+    LOG_DEBUG("Pattern set holds {} addresses in {} bytes", results.Size(), results.MemoryUsage());
+    return results;
+}
+
+std::vector<SignatureHit> MemoryScanner::ScanForSignatures(const ScanOptions& options) {
+    std::vector<SignatureHit> hits;
+    last_scan_status_ = ScanStatus::Completed;
+    
+    auto matcher = CompileSignatures();
+    if (matcher->Count() == 0) {
+        LOG_WARN("No signatures loaded");
+        return hits;
+    }
+    
+    auto regions = ScanRegions();
+    auto tasks = BuildScanTasks(regions);
+    std::vector<std::vector<SignatureHit>> task_hits(tasks.size());
+    
+    ScanControl control(options, tasks.size());
+    RunScanTasks(tasks.size(), control, [&](size_t task, RegionChunkReader& reader) {
+        ScanTaskForSignatures(tasks[task], *matcher, control, reader, task_hits[task]);
+    });
+    
+    for (auto& task_hit : task_hits) {
+        hits.insert(hits.end(), std::make_move_iterator(task_hit.begin()), std::make_move_iterator(task_hit.end()));
+    }
+    
+    std::sort(hits.begin(), hits.end(), [](const SignatureHit& a, const SignatureHit& b) {
+        return a.address != b.address ? a.address < b.address : a.name < b.name;
+    });
+    
+    last_scan_status_ = control.Status();
+    size_t limit = options.ResultLimit();
+    if (limit > 0 && hits.size() > limit) {
+        hits.resize(limit);
+        if (last_scan_status_ == ScanStatus::Completed) {
+            last_scan_status_ = ScanStatus::ResultLimit;
+        }
+    }
+    
+    LOG_INFO("Signature scan found {} matches for {} signatures", hits.size(), matcher->Count());
+    return hits;
+}
+
+std::vector<StringMatch> MemoryScanner::FindStrings(const std::string& text, StringEncoding encoding,
+                                                    bool case_insensitive, bool managed_only,
+                                                    const ScanOptions& options) {
+    std::vector<StringMatch> matches;
+    last_scan_status_ = ScanStatus::Completed;
+    
+    if (text.empty()) {
+        return matches;
+    }
+    
+    // Managed strings are always UTF-16
+    std::vector<StringMatcher> matchers;
+    if (encoding != StringEncoding::Utf16 && !managed_only) {
+        matchers.emplace_back(text, StringEncoding::Ascii, case_insensitive);
+    }
+    if (encoding != StringEncoding::Ascii || managed_only) {
+        matchers.emplace_back(text, StringEncoding::Utf16, case_insensitive);
+    }
+    
+    auto region_map = managed_only ? source_->GetRegionMap() : nullptr;
+    
+    auto regions = ScanRegions();
+    auto tasks = BuildScanTasks(regions);
+    std::vector<std::vector<StringMatch>> task_matches(tasks.size());
+    
+    ScanControl control(options, tasks.size());
+    RunScanTasks(tasks.size(), control, [&](size_t task, RegionChunkReader& reader) {
+        ScanTaskForStrings(tasks[task], matchers, managed_only, region_map.get(), control, reader, task_matches[task]);
+    });
+    
+    for (const auto& task_match : task_matches) {
+        matches.insert(matches.end(), task_match.begin(), task_match.end());
+    }
+    
+    last_scan_status_ = control.Status();
+    size_t limit = options.ResultLimit();
+    if (limit > 0 && matches.size() > limit) {
+        matches.resize(limit);
+        if (last_scan_status_ == ScanStatus::Completed) {
+            last_scan_status_ = ScanStatus::ResultLimit;
+        }
+    }
+    
+    LOG_INFO("String search found {} matches for \"{}\"", matches.size(), text);
+    return matches;
+}
+
+size_t MemoryScanner::ScanForPattern(const Pattern& pattern, const MatchSink& sink, const ScanOptions& options) {
+    last_scan_status_ = ScanStatus::Completed;
+    
+    auto cursor = OpenPatternCursor(pattern, options);
+    if (!cursor) {
+        return 0;
+    }
+    
+    std::vector<MemoryAddress> batch;
+    while (cursor->Next(batch)) {
+        if (!sink(batch)) {
+            cursor->Cancel();
+            break;
+        }
+    }
+    
+    last_scan_status_ = cursor->Status();
+    return cursor->Delivered();
+}
+
+size_t MemoryScanner::ScanForSignatures(const SignatureSink& sink, const ScanOptions& options) {
+    last_scan_status_ = ScanStatus::Completed;
+    
+    auto cursor = OpenSignatureCursor(options);
+    if (!cursor) {
+        return 0;
+    }
+    
+    std::vector<SignatureHit> batch;
+    while (cursor->Next(batch)) {
+        if (!sink(batch)) {
+            cursor->Cancel();
+            break;
+        }
+    }
+    
+    last_scan_status_ = cursor->Status();
+    return cursor->Delivered();
+}
+
+std::unique_ptr<MemoryScanner::PatternCursor> MemoryScanner::OpenPatternCursor(const Pattern& pattern, const ScanOptions& options) {
+    if (pattern.Empty()) {
+        return nullptr;
+    }
+    
+    auto matcher = std::make_shared<PatternMatcher>(pattern, scan_alignment_);
+    auto fingerprints = BeginFingerprintScan(pattern, *matcher);
+    auto kernel = [this, matcher, fingerprints](const ScanTask& task, ScanControl& control,
+                                                RegionChunkReader& reader, std::vector<MemoryAddress>& hits) {
+        ScanTaskForPattern(task, *matcher, fingerprints.get(), control, reader, hits);
+    };
+    
+    return std::unique_ptr<PatternCursor>(new PatternCursor(*this, kernel, options));
+}
+
+std::unique_ptr<MemoryScanner::SignatureCursor> MemoryScanner::OpenSignatureCursor(const ScanOptions& options) {
+    auto matcher = CompileSignatures();
+    if (matcher->Count() == 0) {
+        LOG_WARN("No signatures loaded");
+        return nullptr;
+    }
+    
+    // Hits are reported as each signature ends, so restore address order per task
+    auto kernel = [this, matcher](const ScanTask& task, ScanControl& control,
+                                  RegionChunkReader& reader, std::vector<SignatureHit>& hits) {
+        ScanTaskForSignatures(task, *matcher, control, reader, hits);
+        std::sort(hits.begin(), hits.end(), [](const SignatureHit& a, const SignatureHit& b) {
+            return a.address != b.address ? a.address < b.address : a.name < b.name;
+        });
+    };
+    
+    return std::unique_ptr<SignatureCursor>(new SignatureCursor(*this, kernel, options));
 }
 
 // Specific structure scanning
@@ -78,12 +390,20 @@ std::vector<EncryptedBigInteger> MemoryScanner::FindEncryptedBigIntegers() {
 // Memory reading utilities
 ByteVector MemoryScanner::ReadBytes(MemoryAddress address, size_t size) {
     ByteVector buffer(size);
-    if (process_mgr_->ReadMemory(address, buffer.data(), size)) {
+    if (ReadRaw(address, buffer.data(), size)) {
         return buffer;
     }
     return {};
 }
 
+bool MemoryScanner::ReadInto(MemoryAddress address, Span<uint8_t> buffer) {
+    return ReadRaw(address, buffer.data(), buffer.size());
+}
+
+size_t MemoryScanner::ReadBatch(std::vector<ReadRequest>& requests) {
+    return source_->ReadBatch(requests);
+}
+
 std::string MemoryScanner::ReadString(MemoryAddress address, size_t max_length) {
     ByteVector buffer = ReadBytes(address, max_length);
     if (buffer.empty()) {
@@ -120,17 +440,117 @@ std::vector<MemoryAddress> MemoryScanner::FollowPointerChain(MemoryAddress base,
     return chain;
 }
 
+std::optional<MemoryAddress> MemoryScanner::ResolvePointerPath(const PointerPath& path) {
+    if (path.offsets.empty()) {
+        return std::nullopt;
+    }
+    
+    auto base = source_->ModuleBase(path.module);
+    if (!base) {
+        return std::nullopt;
+    }
+    
+    auto chain = FollowPointerChain(*base, path.offsets);
+    if (chain.size() != path.offsets.size()) {
+        LOG_DEBUG("Pointer path {} broke after {} links", path.ToString(), chain.size());
+        return std::nullopt;
+    }
+    
+    return chain.back();
+}
+
 // Signature management
 void MemoryScanner::AddSignature(const std::string& name, const ByteVector& pattern) {
-    signatures_[name] = pattern;
+    AddSignature(name, Pattern::FromBytes(pattern));
+}
+
+void MemoryScanner::AddSignature(const std::string& name, const Pattern& pattern) {
+    rules_.erase(name);
+    signatures_[name] = Signature{ name, pattern };
+}
+
+void MemoryScanner::AddRule(const Rule& rule) {
+    signatures_.erase(rule.Name());
+    rules_.insert_or_assign(rule.Name(), rule);
+}
+
+bool MemoryScanner::AddRule(const std::string& name, const std::string& text) {
+    auto rule = Rule::Parse(name, text);
+    if (!rule) {
+        return false;
+    }
+    
+    AddRule(*rule);
+    return true;
+}
+
+std::shared_ptr<const MemoryScanner::CompiledSignatures> MemoryScanner::CompileSignatures() const {
+    std::vector<Signature> signatures;
+    signatures.reserve(signatures_.size());
+    for (const auto& [name, signature] : signatures_) {
+        signatures.push_back(signature);
+    }
+    
+    std::vector<Rule> rules;
+    rules.reserve(rules_.size());
+    for (const auto& [name, rule] : rules_) {
+        rules.push_back(rule);
+    }
+    
+    return std::make_shared<const CompiledSignatures>(signatures, rules, scan_alignment_);
+}
+
+void MemoryScanner::LoadScanSettingsFromConfig(const nlohmann::json& config) {
+    process_mgr_->SetRegionFilter(RegionFilter::FromConfig(config));
+    
+    if (config.contains("memory_scanning") && config["memory_scanning"].contains("scan_alignment")) {
+        SetScanAlignment(config["memory_scanning"]["scan_alignment"].get<size_t>());
+    }
+    
+    if (config.contains("performance")) {
+        const auto& performance = config["performance"];
+        bool multithreading = performance.value("enable_multithreading", false);
+        SetWorkerThreads(multithreading ? performance.value("max_worker_threads", size_t{0}) : 1);
+        
+        if (performance.value("incremental_rescans", false)) {
+            SetPageFingerprints(std::make_shared<PageFingerprints>());
+        }
+        
+        if (performance.value("change_tracking", false)) {
+            EnableChangeTracking(true);
+        }
+        
+        SetSkipUntouchedPages(performance.value("skip_untouched_pages", false));
+        
+        std::string backend = performance.value("read_backend", std::string("sync"));
+        if (backend == "io_uring") {
+            process_mgr_->SetReadBackend(ReadBackend::IoUring);
+        } else if (backend != "sync") {
+            LOG_WARN("Unknown read backend '{}'; using synchronous reads", backend);
+        }
+        
+        if (performance.value("scan_progress_updates", false)) {
+            EnableProgressCallback([](float progress) {
+                LOG_DEBUG("Scan progress: {:.0f}%", progress * 100.0f);
+            });
+        }
+    }
 }
 
 void MemoryScanner::LoadSignaturesFromConfig(const nlohmann::json& config) {
     if (config.contains("memory_scanning") && config["memory_scanning"].contains("signatures")) {
         for (const auto& [name, sig_config] : config["memory_scanning"]["signatures"].items()) {
             if (sig_config.contains("pattern")) {
-                auto pattern = HexStringToBytes(sig_config["pattern"]);
-                AddSignature(name, pattern);
+                auto pattern = Pattern::Parse(sig_config["pattern"].get<std::string>());
+                if (!pattern) {
+                    LOG_WARN("Skipping signature '{}' with invalid pattern", name);
+                    continue;
+                }
+                AddSignature(name, *pattern);
+            } else if (sig_config.contains("rule")) {
+                if (!AddRule(name, sig_config["rule"].get<std::string>())) {
+                    LOG_WARN("Skipping signature '{}' with invalid rule", name);
+                }
             }
         }
     }
@@ -138,7 +558,11 @@ void MemoryScanner::LoadSignaturesFromConfig(const nlohmann::json& config) {
 
 // Scanning configuration
 void MemoryScanner::SetScanRegions(const std::vector<MemoryRegion>& regions) {
-    scan_regions_ = regions;
+    scan_regions_ = process_mgr_->FilterRegions(regions, &scan_filter_stats_);
+    explicit_regions_ = true;
+    
+    LOG_DEBUG("Scan regions set: {} kept, {} skipped ({} bytes)", scan_filter_stats_.kept_regions,
+              scan_filter_stats_.skipped_regions, scan_filter_stats_.skipped_bytes);
 }
 
 void MemoryScanner::SetScanRange(MemoryAddress start, MemoryAddress end) {
@@ -148,52 +572,548 @@ void MemoryScanner::SetScanRange(MemoryAddress start, MemoryAddress end) {
     region.size = end - start;
     region.protection = PAGE_READWRITE;
     scan_regions_.push_back(region);
+    
+    scan_filter_stats_ = { 1, 0, region.size, 0 };
+    explicit_regions_ = true;
+}
+
+void MemoryScanner::UseFilteredRegions() {
+    scan_regions_.clear();
+    explicit_regions_ = false;
+}
+
+void MemoryScanner::SetSkipUntouchedPages(bool enabled) {
+#ifdef WINDOWS_BUILD
+    if (enabled) {
+        LOG_WARN("Skipping untouched pages also skips pages trimmed to the pagefile; scans may miss live data");
+    }
+#endif
+    skip_untouched_pages_ = enabled;
+}
+
+std::vector<MemoryRegion> MemoryScanner::ScanRegions() {
+    auto regions = explicit_regions_ ? scan_regions_ : source_->Regions(&scan_filter_stats_);
+    if (skip_untouched_pages_ && source_->IsLive()) {
+        return DropUntouchedPages(regions);
+    }
+    return regions;
+}
+
+std::vector<MemoryRegion> MemoryScanner::DropUntouchedPages(const std::vector<MemoryRegion>& regions) {
+    residency_stats_ = {};
+    
+    // Unpopulated pages of file mappings still read back file data
+    auto prunable = [](const MemoryRegion& region) {
+        return region.type == MEM_PRIVATE && region.base_address % REMOTE_PAGE_SIZE == 0;
+    };
+    
+    std::vector<MemoryRegion> queried;
+    std::copy_if(regions.begin(), regions.end(), std::back_inserter(queried), prunable);
+    if (queried.empty()) {
+        return regions;
+    }
+    
+    auto resident = process_mgr_->QueryResidentPages(queried);
+    if (!resident) {
+        return regions;
+    }
+    
+    // Runs may join across adjacent regions, so each is clipped to the region it serves
+    std::sort(resident->begin(), resident->end());
+    std::vector<MemoryRegion> kept;
+    kept.reserve(regions.size());
+    for (const auto& region : regions) {
+        if (!prunable(region)) {
+            kept.push_back(region);
+            continue;
+        }
+        
+        MemoryAddress region_end = region.base_address + region.size;
+        auto run = std::partition_point(resident->begin(), resident->end(), [&](const auto& r) {
+            return r.second <= region.base_address;
+        });
+        
+        size_t resident_bytes = 0;
+        for (; run != resident->end() && run->first < region_end; ++run) {
+            MemoryRegion piece = region;
+            piece.base_address = std::max(run->first, region.base_address);
+            piece.size = static_cast<size_t>(std::min<MemoryAddress>(run->second, region_end) - piece.base_address);
+            resident_bytes += piece.size;
+            kept.push_back(piece);
+        }
+        
+        size_t pages = (region.size + REMOTE_PAGE_SIZE - 1) / REMOTE_PAGE_SIZE;
+        size_t skipped = pages - (resident_bytes + REMOTE_PAGE_SIZE - 1) / REMOTE_PAGE_SIZE;
+        residency_stats_.regions.push_back({ region.base_address, pages, skipped });
+        residency_stats_.pages += pages;
+        residency_stats_.skipped_pages += skipped;
+    }
+    
+    LOG_DEBUG("Skipping {} of {} pages never touched by the target", residency_stats_.skipped_pages, residency_stats_.pages);
+    return kept;
 }
 
 void MemoryScanner::EnableProgressCallback(std::function<void(float)> callback) {
     progress_callback_ = callback;
 }
 
+void MemoryScanner::SetWorkerThreads(size_t count) {
+    if (count == 0) {
+        count = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    }
+    
+    thread_pool_.reset();
+    worker_readers_.clear();
+    
+    if (count > 1) {
+        thread_pool_ = std::make_unique<ThreadPool>(count);
+        for (size_t i = 0; i < count; ++i) {
+            worker_readers_.push_back(std::make_unique<RegionChunkReader>(scan_source_));
+        }
+    }
+    
+    LOG_INFO("Pattern scans will use {} worker thread(s)", count);
+}
+
 // Private methods
+bool MemoryScanner::ReadRaw(MemoryAddress address, void* buffer, size_t size) {
+    return source_->ReadInto(address, { static_cast<uint8_t*>(buffer), size });
+}
+
 bool MemoryScanner::IsValidScanRegion(const MemoryRegion& region) {
     return region.size > 0 && region.base_address != 0;
 }
 
-std::vector<MemoryAddress> MemoryScanner::ScanRegionForPattern(const MemoryRegion& region,
-                                                              const ByteVector& pattern,
-                                                              const ByteVector& mask) {
-    std::vector<MemoryAddress> results;
+void MemoryScanner::SweepScanRegions(size_t value_size,
+                                     const std::function<void(size_t task_count)>& prepare,
+                                     const std::function<void(const SweepSpan& span)>& visitor,
+                                     const std::function<bool(const MemoryRegion& region)>& region_filter,
+                                     const ScanOptions& options) {
+    size_t overlap = std::max<size_t>(value_size, 1) - 1;
+    auto regions = ScanRegions();
+    auto tasks = BuildScanTasks(regions, region_filter);
+    prepare(tasks.size());
     
-    if (pattern.empty()) {
-        return results;
+    ScanControl control(options, tasks.size());
+    RunScanTasks(tasks.size(), control, [&](size_t task, RegionChunkReader& reader) {
+        const ScanTask& slice = tasks[task];
+        MemoryAddress region_end = slice.region->base_address + slice.region->size;
+        MemoryAddress read_end = std::min<MemoryAddress>(slice.end + overlap, region_end);
+        reader.Begin(slice.start, static_cast<size_t>(read_end - slice.start), overlap);
+        
+        // Starts below this were complete in an earlier span
+        MemoryAddress covered = slice.start;
+        RegionChunkReader::Span span;
+        while (!control.ShouldStop() && reader.Next(span)) {
+            if (span.size <= overlap) {
+                continue;
+            }
+            
+            MemoryAddress owned_begin = std::max(covered, span.address);
+            MemoryAddress owned_end = std::min<MemoryAddress>(span.address + span.size - overlap, slice.end);
+            if (owned_begin >= owned_end) {
+                continue;
+            }
+            
+            visitor({ task, slice.region->base_address, span.address, span.data, span.size, owned_begin, owned_end });
+            covered = owned_end;
+        }
+    });
+    
+    last_scan_status_ = control.Status();
+}
+
+std::vector<MemoryScanner::ScanTask> MemoryScanner::BuildScanTasks(const std::vector<MemoryRegion>& regions,
+                                                                    const std::function<bool(const MemoryRegion& region)>& region_filter) {
+    std::vector<ScanTask> tasks;
+    
+    // Large regions are split so idle workers have something to steal
+    for (const auto& region : regions) {
+        if (!IsValidScanRegion(region) || (region_filter && !region_filter(region))) {
+            continue;
+        }
+        
+        MemoryAddress region_end = region.base_address + region.size;
+        for (MemoryAddress start = region.base_address; start < region_end; start += SCAN_TASK_SIZE) {
+            tasks.push_back({ &region, start, std::min<MemoryAddress>(start + SCAN_TASK_SIZE, region_end) });
+        }
     }
     
-    auto region_data = ReadBytes(region.base_address, region.size);
-    if (region_data.empty()) {
-        return results;
+    return tasks;
+}
+
+void MemoryScanner::RunScanTasks(size_t task_count, ScanControl& control,
+                                 const std::function<void(size_t task, RegionChunkReader& reader)>& body) {
+    std::atomic<size_t> skipped_bytes{0};
+    
+    // Progress is always reported on the calling thread, so callbacks need no locking
+    const auto& progress = control.Options().progress ? control.Options().progress : progress_callback_;
+    auto last_report = std::chrono::steady_clock::now();
+    auto report = [&] {
+        if (progress && control.total_tasks > 0) {
+            progress(static_cast<float>(control.tasks_done.load(std::memory_order_relaxed)) / control.total_tasks);
+        }
+    };
+    
+    // Tasks that start after a stop are skipped but still counted as done
+    auto run = [&](size_t task, RegionChunkReader& reader) {
+        if (!control.ShouldStop()) {
+            body(task, reader);
+            skipped_bytes.fetch_add(reader.GetSkippedBytes(), std::memory_order_relaxed);
+        }
+        control.tasks_done.fetch_add(1, std::memory_order_relaxed);
+    };
+    
+    if (thread_pool_) {
+        thread_pool_->ParallelFor(task_count, [&](size_t task, size_t worker) {
+            run(task, *worker_readers_[worker]);
+        }, progress ? ThreadPool::WaitCallback(report) : ThreadPool::WaitCallback(), PROGRESS_INTERVAL);
+    } else {
+        for (size_t task = 0; task < task_count; ++task) {
+            run(task, *chunk_reader_);
+            
+            auto now = std::chrono::steady_clock::now();
+            if (progress && now - last_report >= PROGRESS_INTERVAL) {
+                report();
+                last_report = now;
+            }
+        }
     }
     
-    // Simple pattern matching (could be optimized with Boyer-Moore or similar)
-    for (size_t i = 0; i <= region_data.size() - pattern.size(); i += SCAN_ALIGNMENT) {
-        bool match = true;
+    report();
+    
+    if (skipped_bytes > 0) {
+        LOG_DEBUG("Skipped {} unreadable bytes across {} scan tasks", skipped_bytes.load(), task_count);
+    }
+    
+    switch (control.Status()) {
+        case ScanStatus::Cancelled:
+            LOG_INFO("Scan cancelled after {} of {} tasks", control.tasks_done.load(), control.total_tasks);
+            break;
+        case ScanStatus::TimedOut:
+            LOG_WARN("Scan deadline expired; results are partial");
+            break;
+        default:
+            break;
+    }
+}
+
+bool MemoryScanner::ScanControl::ShouldStop() {
+    if (stop_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    
+    if (options_.cancel && options_.cancel->IsCancelled()) {
+        Stop(ScanStatus::Cancelled);
+    } else if (options_.deadline && std::chrono::steady_clock::now() >= *options_.deadline) {
+        Stop(ScanStatus::TimedOut);
+    }
+    
+    return stop_.load(std::memory_order_relaxed);
+}
+
+void MemoryScanner::ScanControl::AddHits(size_t count) {
+    size_t limit = options_.ResultLimit();
+    if (limit > 0 && count > 0 && hits_.fetch_add(count, std::memory_order_relaxed) + count >= limit) {
+        Stop(ScanStatus::ResultLimit);
+    }
+}
+
+void MemoryScanner::ScanControl::Stop(ScanStatus status) {
+    // The first reason wins; later ones are consequences of stopping
+    ScanStatus expected = ScanStatus::Completed;
+    status_.compare_exchange_strong(expected, status, std::memory_order_relaxed);
+    stop_.store(true, std::memory_order_relaxed);
+}
+
+void MemoryScanner::ScanTaskForPattern(const ScanTask& task, const PatternMatcher& matcher, PageFingerprints::Table* fingerprints,
+                                       ScanControl& control, RegionChunkReader& reader, std::vector<MemoryAddress>& results) {
+    // Read past the task end so a match starting near it can complete
+    MemoryAddress region_end = task.region->base_address + task.region->size;
+    MemoryAddress read_end = std::min<MemoryAddress>(task.end + matcher.Length() - 1, region_end);
+    
+    // Stream the slice in chunks; the overlap lets matches span chunk boundaries
+    reader.Begin(task.start, static_cast<size_t>(read_end - task.start), matcher.Length() - 1);
+    
+    // Alignment is measured from the region base across spans
+    RegionChunkReader::Span span;
+    while (!control.ShouldStop() && reader.Next(span)) {
+        size_t before = results.size();
+        if (fingerprints) {
+            fingerprints->FindAll(matcher, span.data, span.size, span.address, task.region->base_address, results);
+        } else {
+            matcher.FindAll(span.data, span.size, span.address, task.region->base_address, results);
+        }
         
-        for (size_t j = 0; j < pattern.size(); ++j) {
-            if (!mask.empty() && mask[j] == 0) {
-                continue; // Skip masked bytes
+        // Hits in the overlap past the end are counted by the next task
+        size_t owned = std::lower_bound(results.begin() + before, results.end(), task.end) - (results.begin() + before);
+        control.AddHits(owned);
+    }
+    
+    // Matches starting past the end belong to the next task
+    while (!results.empty() && results.back() >= task.end) {
+        results.pop_back();
+    }
+}
+
+std::optional<std::vector<MemoryScanner::ScanTask>> MemoryScanner::PlanTrackedScan(const std::string& key, size_t lookbehind,
+                                                                                   const std::vector<MemoryRegion>& regions,
+                                                                                   std::optional<uint64_t>& pass,
+                                                                                   std::vector<MemoryAddress>& kept) {
+    pass = write_tracker_->Advance();
+    if (!pass) {
+        LOG_WARN("Change tracking disabled; scanning everything");
+        write_tracker_.reset();
+        tracked_scans_.clear();
+        return std::nullopt;
+    }
+    
+    auto it = tracked_scans_.find(key);
+    if (it == tracked_scans_.end()) {
+        return std::nullopt;
+    }
+    
+    auto written = write_tracker_->WrittenSince(it->second.pass);
+    if (!written) {
+        LOG_DEBUG("Tracked scan of {} is too old to update; scanning everything", key);
+        return std::nullopt;
+    }
+    
+    std::vector<WriteTracker::Range> current;
+    for (const auto& region : regions) {
+        if (IsValidScanRegion(region)) {
+            current.emplace_back(region.base_address, region.base_address + region.size);
+        }
+    }
+    
+    // Regions the last scan did not cover count as written
+    auto changed = WriteTracker::Union(*written, WriteTracker::Subtract(current, it->second.covered));
+    
+    // Starts up to lookbehind bytes before a changed byte may produce different hits
+    std::vector<ScanTask> tasks;
+    std::vector<WriteTracker::Range> rescanned;
+    size_t next = 0;
+    for (const auto& region : regions) {
+        if (!IsValidScanRegion(region)) {
+            continue;
+        }
+        
+        MemoryAddress region_end = region.base_address + region.size;
+        while (next < changed.size() && changed[next].second <= region.base_address) {
+            ++next;
+        }
+        
+        std::vector<WriteTracker::Range> pieces;
+        for (size_t k = next; k < changed.size() && changed[k].first < region_end; ++k) {
+            MemoryAddress start = std::max(region.base_address, changed[k].first - std::min<MemoryAddress>(lookbehind, changed[k].first));
+            MemoryAddress end = std::min(region_end, changed[k].second);
+            if (!pieces.empty() && start <= pieces.back().second) {
+                pieces.back().second = std::max(pieces.back().second, end);
+            } else {
+                pieces.emplace_back(start, end);
             }
+        }
+        
+        for (const auto& [piece_start, piece_end] : pieces) {
+            for (MemoryAddress start = piece_start; start < piece_end; start += SCAN_TASK_SIZE) {
+                tasks.push_back({ &region, start, std::min<MemoryAddress>(start + SCAN_TASK_SIZE, piece_end) });
+            }
+        }
+        rescanned.insert(rescanned.end(), pieces.begin(), pieces.end());
+    }
+    
+    // Earlier hits still inside the scan regions and outside every rescanned range
+    auto kept_ranges = WriteTracker::Subtract(current, rescanned);
+    size_t range = 0;
+    for (MemoryAddress hit : it->second.hits) {
+        while (range < kept_ranges.size() && kept_ranges[range].second <= hit) {
+            ++range;
+        }
+        if (range < kept_ranges.size() && kept_ranges[range].first <= hit) {
+            kept.push_back(hit);
+        }
+    }
+    
+    uint64_t bytes = 0;
+    for (const auto& [start, end] : rescanned) {
+        bytes += end - start;
+    }
+    LOG_DEBUG("Tracked scan of {}: rescanning {} bytes in {} ranges, keeping {} hits",
+              key, bytes, rescanned.size(), kept.size());
+    return tasks;
+}
+
+void MemoryScanner::StoreTrackedScan(const std::string& key, uint64_t pass, const std::vector<MemoryRegion>& regions,
+                                     const std::vector<MemoryAddress>& hits) {
+    TrackedScan& scan = tracked_scans_[key];
+    scan.pass = pass;
+    scan.hits = hits;
+    scan.last_used = ++tracked_scan_count_;
+    scan.covered.clear();
+    for (const auto& region : regions) {
+        if (IsValidScanRegion(region)) {
+            scan.covered.emplace_back(region.base_address, region.base_address + region.size);
+        }
+    }
+    
+    if (tracked_scans_.size() > MAX_TRACKED_SCANS) {
+        tracked_scans_.erase(std::min_element(tracked_scans_.begin(), tracked_scans_.end(), [](const auto& a, const auto& b) {
+            return a.second.last_used < b.second.last_used;
+        }));
+    }
+}
+
+bool MemoryScanner::EnableChangeTracking(bool enable) {
+    tracked_scans_.clear();
+    write_tracker_.reset();
+    if (!enable) {
+        return true;
+    }
+    
+    if (!source_->IsLive()) {
+        LOG_WARN("Change tracking needs a live process as the memory source");
+        return false;
+    }
+    
+    auto tracker = std::make_unique<WriteTracker>(process_mgr_);
+    if (!tracker->Start()) {
+        return false;
+    }
+    
+    write_tracker_ = std::move(tracker);
+    return true;
+}
+
+std::shared_ptr<PageFingerprints::Table> MemoryScanner::BeginFingerprintScan(const Pattern& pattern,
+                                                                           const PatternMatcher& matcher) {
+    // A hit may start at most one page before the page it ends in
+    if (!page_fingerprints_ || matcher.Length() - 1 > REMOTE_PAGE_SIZE) {
+        return nullptr;
+    }
+    
+    return page_fingerprints_->BeginScan(fmt::format("{} @{}", pattern.ToString(), matcher.Alignment()));
+}
+
+void MemoryScanner::ScanTaskForSignatures(const ScanTask& task, const CompiledSignatures& matcher, ScanControl& control,
+                                          RegionChunkReader& reader, std::vector<SignatureHit>& hits) {
+    MemoryAddress region_end = task.region->base_address + task.region->size;
+    MemoryAddress read_end = std::min<MemoryAddress>(task.end + matcher.MaxLength() - 1, region_end);
+    
+    reader.Begin(task.start, static_cast<size_t>(read_end - task.start), matcher.MaxLength() - 1);
+    
+    // Spans overlap, so skip matches that were already inside the previous span
+    MemoryAddress reported_until = 0;
+    RegionChunkReader::Span span;
+    while (!control.ShouldStop() && reader.Next(span)) {
+        size_t before = hits.size();
+        if (matcher.patterns.Count() > 0) {
+            matcher.patterns.FindAll(span.data, span.size, span.address, task.region->base_address, reported_until, hits);
+        }
+        if (matcher.rules.Count() > 0) {
+            matcher.rules.FindAll(span.data, span.size, span.address, task.region->base_address, reported_until,
+                                  span.address + span.size >= read_end, hits);
+        }
+        reported_until = span.address + span.size;
+        
+        control.AddHits(std::count_if(hits.begin() + before, hits.end(), [&](const SignatureHit& hit) {
+            return hit.address < task.end;
+        }));
+    }
+    
+    hits.erase(std::remove_if(hits.begin(), hits.end(), [&](const SignatureHit& hit) {
+        return hit.address >= task.end;
+    }), hits.end());
+}
+
+void MemoryScanner::ScanTaskForStrings(const ScanTask& task, const std::vector<StringMatcher>& matchers, bool managed_only,
+                                       const RegionMap* region_map, ScanControl& control,
+                                       RegionChunkReader& reader, std::vector<StringMatch>& matches) {
+    size_t longest = 0;
+    for (const auto& matcher : matchers) {
+        longest = std::max(longest, matcher.Length());
+    }
+    
+    MemoryAddress region_end = task.region->base_address + task.region->size;
+    MemoryAddress read_end = std::min<MemoryAddress>(task.end + longest - 1, region_end);
+    reader.Begin(task.start, static_cast<size_t>(read_end - task.start), longest - 1);
+    
+    MemoryAddress reported_until = 0;
+    std::vector<MemoryAddress> hits;
+    RegionChunkReader::Span span;
+    while (!control.ShouldStop() && reader.Next(span)) {
+        size_t before = matches.size();
+        
+        for (const auto& matcher : matchers) {
+            hits.clear();
+            matcher.FindAll(span.data, span.size, span.address, hits);
             
-            if (region_data[i + j] != pattern[j]) {
-                match = false;
-                break;
+            for (MemoryAddress address : hits) {
+                // A shorter text can lie wholly inside the overlap searched last time
+                if (address >= task.end || address + matcher.Length() <= reported_until) {
+                    continue;
+                }
+                
+                StringMatch match{ address, matcher.Encoding() };
+                if (managed_only) {
+                    // The header is usually in the span; near its start it has to be read
+                    uint8_t header[MANAGED_STRING_HEADER];
+                    size_t offset = static_cast<size_t>(address - span.address);
+                    if (offset >= sizeof(header)) {
+                        std::memcpy(header, span.data + offset - sizeof(header), sizeof(header));
+                    } else if (!ReadRaw(address - sizeof(header), header, sizeof(header))) {
+                        continue;
+                    }
+                    
+                    if (!MatchManagedStringHeader(header, matcher.CharCount(), region_map, match)) {
+                        continue;
+                    }
+                }
+                
+                matches.push_back(match);
             }
         }
         
-        if (match) {
-            results.push_back(region.base_address + i);
+        reported_until = span.address + span.size;
+        std::sort(matches.begin() + before, matches.end(), [](const StringMatch& a, const StringMatch& b) {
+            return a.address != b.address ? a.address < b.address : a.encoding < b.encoding;
+        });
+        control.AddHits(matches.size() - before);
+    }
+}
+
+bool MemoryScanner::MatchManagedStringHeader(const uint8_t* header, size_t char_count,
+                                             const RegionMap* region_map, StringMatch& match) const {
+    // Objects are 8-byte aligned and both layouts put the characters at +4 mod 8
+    if (match.address % 8 != 4) {
+        return false;
+    }
+    
+    int32_t length;
+    std::memcpy(&length, header + 16, sizeof(length));
+    if (length < static_cast<int64_t>(char_count) || length > MAX_MANAGED_STRING_LENGTH) {
+        return false;
+    }
+    
+    auto plausible = [&](MemoryAddress pointer) {
+        return pointer % 8 == 0 && pointer >= MIN_VALID_POINTER && pointer <= MAX_VALID_POINTER &&
+               (!region_map || region_map->Find(pointer) != RegionMap::npos);
+    };
+    
+    // CoreCLR first; a Mono sync pointer sits in the same slot but is usually null
+    MemoryAddress type_pointer;
+    std::memcpy(&type_pointer, header + 8, sizeof(type_pointer));
+    if (plausible(type_pointer)) {
+        match.object = match.address - 12;
+    } else {
+        std::memcpy(&type_pointer, header, sizeof(type_pointer));
+        if (!plausible(type_pointer)) {
+            return false;
         }
+        match.object = match.address - 20;
     }
     
-    return results;
+    match.length = static_cast<uint32_t>(length);
+    return true;
 }
 
 bool MemoryScanner::IsContainerStruct(MemoryAddress address) {
@@ -0,0 +1,385 @@
+#include "memory_snapshot.hpp"
+#include "app_logger.hpp"
+#include "block_codec.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+namespace MemoryForensics {
+
+namespace {
+
+bool IsZero(const uint8_t* data, size_t size) {
+    return size == 0 || (data[0] == 0 && std::memcmp(data, data + 1, size - 1) == 0);
+}
+
+// Last compressed block decoded on this thread, for reads smaller than a block
+struct DecodedBlock {
+    uint64_t snapshot = 0;
+    size_t block = 0;
+    ByteVector data;
+};
+
+thread_local DecodedBlock decoded_block;
+std::atomic<uint64_t> next_snapshot_id{1};
+
+} // namespace
+
+std::optional<MemorySnapshot::CaptureStats> MemorySnapshot::Capture(MemorySource& source,
+                                                                    const std::vector<MemoryRegion>& regions,
+                                                                    const std::string& path, bool compress) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("Failed to create {}", path);
+        return std::nullopt;
+    }
+    
+    std::vector<MemoryRegion> sorted = regions;
+    std::sort(sorted.begin(), sorted.end(), [](const MemoryRegion& a, const MemoryRegion& b) {
+        return a.base_address < b.base_address;
+    });
+    
+    // The header is rewritten once the table offsets are known
+    FileHeader header = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    CaptureStats stats;
+    std::string names;
+    std::vector<RegionRecord> region_records;
+    std::vector<BlockRecord> blocks;
+    ByteVector buffer(CAPTURE_BATCH_BLOCKS * BLOCK_SIZE);
+    ByteVector packed(BlockCodec::Bound(BLOCK_SIZE));
+    uint64_t offset = sizeof(FileHeader);
+    
+    for (const auto& region : sorted) {
+        // Overlapping input would make lookups ambiguous
+        if (region.size == 0 ||
+            (!region_records.empty() && region.base_address < region_records.back().base + region_records.back().size)) {
+            continue;
+        }
+        
+        region_records.push_back({ region.base_address, region.size, region.protection, region.type,
+                                   static_cast<uint32_t>(names.size()), static_cast<uint32_t>(region.name.size()),
+                                   blocks.size() });
+        names += region.name;
+        
+        for (size_t position = 0; position < region.size; position += buffer.size()) {
+            size_t batch = std::min(buffer.size(), region.size - position);
+            std::vector<ReadRequest> requests;
+            for (size_t start = 0; start < batch; start += BLOCK_SIZE) {
+                requests.push_back({ region.base_address + position + start, buffer.data() + start,
+                                     std::min(BLOCK_SIZE, batch - start) });
+            }
+            source.ReadBatch(requests);
+            
+            for (const auto& request : requests) {
+                auto* data = static_cast<uint8_t*>(request.buffer);
+                uint16_t missing = 0;
+                
+                // Keep the readable pages of a block that failed as a whole
+                if (!request.success) {
+                    std::vector<ReadRequest> pages;
+                    for (size_t page = 0; page < request.size; page += REMOTE_PAGE_SIZE) {
+                        pages.push_back({ request.address + page, data + page, std::min(REMOTE_PAGE_SIZE, request.size - page) });
+                    }
+                    source.ReadBatch(pages);
+                    
+                    for (size_t i = 0; i < pages.size(); ++i) {
+                        if (!pages[i].success) {
+                            std::memset(pages[i].buffer, 0, pages[i].size);
+                            missing |= static_cast<uint16_t>(1u << i);
+                            stats.unreadable_bytes += pages[i].size;
+                        }
+                    }
+                }
+                
+                BlockRecord record = { offset, 0, static_cast<uint8_t>(Encoding::Zero), 0, missing };
+                const uint8_t* stored = nullptr;
+                if (IsZero(data, request.size)) {
+                    ++stats.zero_blocks;
+                } else {
+                    // Compression has to save an eighth to be worth decoding
+                    size_t packed_size = compress ? BlockCodec::Compress(data, request.size, packed.data(), packed.size()) : 0;
+                    if (packed_size > 0 && packed_size < request.size - request.size / 8) {
+                        record.encoding = static_cast<uint8_t>(Encoding::Compressed);
+                        record.stored_size = static_cast<uint32_t>(packed_size);
+                        stored = packed.data();
+                        ++stats.compressed_blocks;
+                    } else {
+                        record.encoding = static_cast<uint8_t>(Encoding::Raw);
+                        record.stored_size = static_cast<uint32_t>(request.size);
+                        stored = data;
+                    }
+                }
+                
+                out.write(reinterpret_cast<const char*>(stored), record.stored_size);
+                offset += record.stored_size;
+                blocks.push_back(record);
+            }
+        }
+        
+        ++stats.regions;
+        stats.bytes += region.size;
+    }
+    
+    std::vector<ModuleRecord> module_records;
+    for (const auto& module : source.Modules()) {
+        module_records.push_back({ module.base, module.size, static_cast<uint32_t>(names.size()),
+                                   static_cast<uint32_t>(module.name.size()) });
+        names += module.name;
+    }
+    
+    static const char padding[8] = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.block_size = static_cast<uint32_t>(BLOCK_SIZE);
+    header.region_count = static_cast<uint32_t>(region_records.size());
+    header.module_count = static_cast<uint32_t>(module_records.size());
+    header.block_count = blocks.size();
+    header.regions_offset = FileLayout::AlignUp(offset);
+    header.modules_offset = header.regions_offset + region_records.size() * sizeof(RegionRecord);
+    header.names_offset = header.modules_offset + module_records.size() * sizeof(ModuleRecord);
+    header.names_size = names.size();
+    header.blocks_offset = FileLayout::AlignUp(header.names_offset + names.size());
+    
+    if (auto* process = dynamic_cast<ProcessMemorySource*>(&source)) {
+        header.process_id = process->GetProcessManager()->GetProcessID();
+    } else if (auto* snapshot = dynamic_cast<MemorySnapshot*>(&source)) {
+        header.process_id = snapshot->GetProcessID();
+    }
+    
+    out.write(padding, header.regions_offset - offset);
+    out.write(reinterpret_cast<const char*>(region_records.data()), region_records.size() * sizeof(RegionRecord));
+    out.write(reinterpret_cast<const char*>(module_records.data()), module_records.size() * sizeof(ModuleRecord));
+    out.write(names.data(), names.size());
+    out.write(padding, header.blocks_offset - (header.names_offset + names.size()));
+    out.write(reinterpret_cast<const char*>(blocks.data()), blocks.size() * sizeof(BlockRecord));
+    stats.file_bytes = header.blocks_offset + blocks.size() * sizeof(BlockRecord);
+    
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    if (!out) {
+        LOG_ERROR("Failed to write snapshot {}", path);
+        return std::nullopt;
+    }
+    
+    stats.blocks = blocks.size();
+    LOG_INFO("Captured {} regions ({} MB) into {}: {} MB on disk, {} zero and {} compressed of {} blocks, {} KB unreadable",
+             stats.regions, stats.bytes / (1024 * 1024), path, stats.file_bytes / (1024 * 1024), stats.zero_blocks,
+             stats.compressed_blocks, stats.blocks, stats.unreadable_bytes / 1024);
+    return stats;
+}
+
+std::shared_ptr<MemorySnapshot> MemorySnapshot::Open(const std::string& path) {
+    auto snapshot = std::make_shared<MemorySnapshot>();
+    if (!snapshot->file_.Open(path)) {
+        return nullptr;
+    }
+    
+    const uint8_t* data = snapshot->file_.Data();
+    uint64_t size = snapshot->file_.Size();
+    
+    FileHeader header;
+    if (size < sizeof(header)) {
+        LOG_ERROR("{} is too small to be a snapshot", path);
+        return nullptr;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION ||
+        header.block_size != BLOCK_SIZE) {
+        LOG_ERROR("{} is not a version {} snapshot", path, FILE_VERSION);
+        return nullptr;
+    }
+    
+    // Every table has to lie inside the file
+    if (!FileLayout::FitsInFile(header.regions_offset, header.region_count, sizeof(RegionRecord), size) ||
+        !FileLayout::FitsInFile(header.modules_offset, header.module_count, sizeof(ModuleRecord), size) ||
+        !FileLayout::FitsInFile(header.names_offset, header.names_size, 1, size) ||
+        !FileLayout::FitsInFile(header.blocks_offset, header.block_count, sizeof(BlockRecord), size) ||
+        header.regions_offset % 8 != 0 || header.modules_offset % 8 != 0 || header.blocks_offset % 8 != 0) {
+        LOG_ERROR("Snapshot {} is truncated or corrupt", path);
+        return nullptr;
+    }
+    
+    const char* names = reinterpret_cast<const char*>(data + header.names_offset);
+    snapshot->region_records_ = reinterpret_cast<const RegionRecord*>(data + header.regions_offset);
+    snapshot->blocks_ = reinterpret_cast<const BlockRecord*>(data + header.blocks_offset);
+    
+    // Reads trust the index from here on, so each region's blocks are checked once
+    uint64_t next_block = 0;
+    for (uint32_t i = 0; i < header.region_count; ++i) {
+        const RegionRecord& record = snapshot->region_records_[i];
+        uint64_t block_count = record.size / BLOCK_SIZE + (record.size % BLOCK_SIZE != 0 ? 1 : 0);
+        bool valid = record.size > 0 && record.base + record.size > record.base &&
+                     uint64_t{record.name_offset} + record.name_length <= header.names_size &&
+                     record.first_block == next_block && block_count <= header.block_count - next_block &&
+                     (snapshot->regions_.empty() ||
+                      record.base >= snapshot->regions_.back().base_address + snapshot->regions_.back().size);
+        
+        for (uint64_t b = 0; valid && b < block_count; ++b) {
+            const BlockRecord& block = snapshot->blocks_[record.first_block + b];
+            uint64_t length = std::min<uint64_t>(BLOCK_SIZE, record.size - b * BLOCK_SIZE);
+            auto encoding = static_cast<Encoding>(block.encoding);
+            valid = FileLayout::FitsInFile(block.offset, block.stored_size, 1, size) &&
+                    (encoding == Encoding::Zero ? block.stored_size == 0 :
+                     encoding == Encoding::Raw ? block.stored_size == length :
+                     encoding == Encoding::Compressed);
+        }
+        
+        if (!valid) {
+            LOG_ERROR("Snapshot {} has a corrupt region table or page index", path);
+            return nullptr;
+        }
+        
+        snapshot->regions_.push_back({ static_cast<MemoryAddress>(record.base), static_cast<size_t>(record.size),
+                                       record.protection, std::string(names + record.name_offset, record.name_length),
+                                       record.type });
+        next_block += block_count;
+    }
+    
+    for (uint32_t i = 0; i < header.module_count; ++i) {
+        ModuleRecord record;
+        std::memcpy(&record, data + header.modules_offset + i * sizeof(ModuleRecord), sizeof(record));
+        if (uint64_t{record.name_offset} + record.name_length > header.names_size) {
+            LOG_ERROR("Snapshot {} has a corrupt module table", path);
+            return nullptr;
+        }
+        snapshot->modules_.push_back({ static_cast<MemoryAddress>(record.base), static_cast<size_t>(record.size),
+                                       std::string(names + record.name_offset, record.name_length) });
+    }
+    
+    snapshot->id_ = next_snapshot_id.fetch_add(1);
+    snapshot->process_id_ = static_cast<ProcessID>(header.process_id);
+    snapshot->region_map_ = snapshot->MemorySource::GetRegionMap();
+    
+    LOG_INFO("Mapped snapshot {} of process {} ({} regions, {} MB, {} modules)", path, snapshot->process_id_,
+             snapshot->regions_.size(), snapshot->CapturedBytes() / (1024 * 1024), snapshot->modules_.size());
+    return snapshot;
+}
+
+bool MemorySnapshot::ReadInto(MemoryAddress address, Span<uint8_t> buffer) {
+    // Reads may run across adjacent regions, as they do in the process
+    size_t done = 0;
+    while (done < buffer.size()) {
+        MemoryAddress at = address + done;
+        size_t index = FindRegion(at);
+        if (index == regions_.size()) {
+            return false;
+        }
+        
+        const MemoryRegion& region = regions_[index];
+        size_t region_offset = static_cast<size_t>(at - region.base_address);
+        size_t block_offset = region_offset % BLOCK_SIZE;
+        size_t block_size = std::min(BLOCK_SIZE, region.size - (region_offset - block_offset));
+        size_t count = std::min(block_size - block_offset, buffer.size() - done);
+        
+        size_t block = static_cast<size_t>(region_records_[index].first_block) + region_offset / BLOCK_SIZE;
+        if (!ReadBlock(block, block_size, block_offset, buffer.data() + done, count)) {
+            return false;
+        }
+        done += count;
+    }
+    return true;
+}
+
+Span<const uint8_t> MemorySnapshot::Map(MemoryAddress address, size_t size) {
+    size_t index = FindRegion(address);
+    if (size == 0 || index == regions_.size()) {
+        return {};
+    }
+    
+    const MemoryRegion& region = regions_[index];
+    size_t region_offset = static_cast<size_t>(address - region.base_address);
+    if (size > region.size - region_offset) {
+        return {};
+    }
+    
+    // Only raw, fully readable blocks stored back to back form one span
+    size_t first = static_cast<size_t>(region_records_[index].first_block) + region_offset / BLOCK_SIZE;
+    size_t last = static_cast<size_t>(region_records_[index].first_block) + (region_offset + size - 1) / BLOCK_SIZE;
+    for (size_t block = first; block <= last; ++block) {
+        const BlockRecord& record = blocks_[block];
+        if (static_cast<Encoding>(record.encoding) != Encoding::Raw || record.missing_pages != 0 ||
+            (block > first && record.offset != blocks_[block - 1].offset + blocks_[block - 1].stored_size)) {
+            return {};
+        }
+    }
+    
+    return { file_.Data() + blocks_[first].offset + region_offset % BLOCK_SIZE, size };
+}
+
+std::vector<MemoryRegion> MemorySnapshot::Regions(RegionFilterStats* stats) {
+    if (stats) {
+        *stats = {};
+        stats->kept_regions = regions_.size();
+        stats->kept_bytes = CapturedBytes();
+    }
+    return regions_;
+}
+
+uint64_t MemorySnapshot::CapturedBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& region : regions_) {
+        bytes += region.size;
+    }
+    return bytes;
+}
+
+size_t MemorySnapshot::FindRegion(MemoryAddress address) const {
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), address,
+                               [](MemoryAddress value, const MemoryRegion& region) { return value < region.base_address; });
+    if (it == regions_.begin() || address - (it - 1)->base_address >= (it - 1)->size) {
+        return regions_.size();
+    }
+    return static_cast<size_t>(it - 1 - regions_.begin());
+}
+
+bool MemorySnapshot::ReadBlock(size_t block, size_t block_size, size_t offset, uint8_t* output, size_t size) const {
+    const BlockRecord& record = blocks_[block];
+    
+    if (record.missing_pages != 0) {
+        size_t first_page = offset / REMOTE_PAGE_SIZE;
+        size_t last_page = (offset + size - 1) / REMOTE_PAGE_SIZE;
+        uint32_t pages = ((1u << (last_page + 1)) - 1) & ~((1u << first_page) - 1);
+        if ((record.missing_pages & pages) != 0) {
+            return false;
+        }
+    }
+    
+    const uint8_t* stored = file_.Data() + record.offset;
+    switch (static_cast<Encoding>(record.encoding)) {
+    case Encoding::Zero:
+        std::memset(output, 0, size);
+        return true;
+    
+    case Encoding::Raw:
+        std::memcpy(output, stored + offset, size);
+        return true;
+    
+    case Encoding::Compressed:
+        // Whole blocks decode straight into the caller's buffer
+        if (offset == 0 && size == block_size) {
+            return BlockCodec::Decompress(stored, record.stored_size, output, block_size);
+        }
+        
+        if (decoded_block.snapshot != id_ || decoded_block.block != block) {
+            decoded_block.data.resize(BLOCK_SIZE);
+            if (!BlockCodec::Decompress(stored, record.stored_size, decoded_block.data.data(), block_size)) {
+                decoded_block.snapshot = 0;
+                LOG_DEBUG("Snapshot block {} does not decode", block);
+                return false;
+            }
+            decoded_block.snapshot = id_;
+            decoded_block.block = block;
+        }
+        std::memcpy(output, decoded_block.data.data() + offset, size);
+        return true;
+    }
+    
+    return false;
+}
+
+} // namespace MemoryForensics
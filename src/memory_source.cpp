@@ -0,0 +1,141 @@
+#include "memory_source.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MemoryForensics {
+
+size_t MemorySource::ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    size_t succeeded = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto& request = requests[i];
+        request.success = request.buffer != nullptr &&
+                          ReadInto(request.address, { static_cast<uint8_t*>(request.buffer), request.size });
+        succeeded += request.success ? 1 : 0;
+        if (on_complete) {
+            on_complete(i);
+        }
+    }
+    return succeeded;
+}
+
+Span<const uint8_t> MemorySource::Map(MemoryAddress address, size_t size) {
+    (void)address;
+    (void)size;
+    return {};
+}
+
+std::shared_ptr<const RegionMap> MemorySource::GetRegionMap() {
+    std::vector<RegionMap::Entry> entries;
+    for (const auto& region : Regions()) {
+        entries.push_back({ region.base_address, region.size, region.protection, region.type });
+    }
+    return std::make_shared<const RegionMap>(std::move(entries));
+}
+
+std::optional<MemoryAddress> MemorySource::ModuleBase(const std::string& name) {
+    auto modules = Modules();
+    for (const auto& module : modules) {
+        if (module.name == name) {
+            return module.base;
+        }
+    }
+    
+    // Windows module names are case-insensitive
+    for (const auto& module : modules) {
+        if (EqualsIgnoreCase(module.name, name)) {
+            return module.base;
+        }
+    }
+    return std::nullopt;
+}
+
+// ProcessMemorySource
+bool ProcessMemorySource::ReadInto(MemoryAddress address, Span<uint8_t> buffer) {
+    return process_mgr_->ReadMemory(address, buffer.data(), buffer.size());
+}
+
+size_t ProcessMemorySource::ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    return process_mgr_->ReadMemoryBatch(requests, on_complete);
+}
+
+std::vector<MemoryRegion> ProcessMemorySource::Regions(RegionFilterStats* stats) {
+    return process_mgr_->GetFilteredRegions(stats);
+}
+
+std::shared_ptr<const RegionMap> ProcessMemorySource::GetRegionMap() {
+    return process_mgr_->GetRegionMap();
+}
+
+std::vector<ModuleInfo> ProcessMemorySource::Modules() {
+    std::vector<ModuleInfo> modules;
+    for (const auto& module : process_mgr_->GetLoadedModules()) {
+        modules.push_back({ reinterpret_cast<MemoryAddress>(module.modBaseAddr), module.modBaseSize, module.szModule });
+    }
+    return modules;
+}
+
+std::optional<MemoryAddress> ProcessMemorySource::ModuleBase(const std::string& name) {
+    return process_mgr_->GetModuleBaseAddress(name);
+}
+
+// CachedMemorySource
+bool CachedMemorySource::ReadInto(MemoryAddress address, Span<uint8_t> buffer) {
+    return cache_->ReadMemory(address, buffer.data(), buffer.size());
+}
+
+size_t CachedMemorySource::ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    // The cache fetches its missing pages in one go, so everything finishes together
+    size_t succeeded = cache_->ReadMemoryBatch(requests);
+    if (on_complete) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            on_complete(i);
+        }
+    }
+    return succeeded;
+}
+
+// MappedDumpSource
+std::shared_ptr<MappedDumpSource> MappedDumpSource::Open(const std::string& path, MemoryAddress base_address) {
+    auto source = std::make_shared<MappedDumpSource>();
+    if (!source->file_.Open(path)) {
+        return nullptr;
+    }
+    
+    source->base_address_ = base_address;
+    source->name_ = path;
+    source->region_map_ = source->MemorySource::GetRegionMap();
+    LOG_INFO("Mapped dump {} at 0x{:X} ({} bytes)", path, base_address, source->file_.Size());
+    return source;
+}
+
+bool MappedDumpSource::ReadInto(MemoryAddress address, Span<uint8_t> buffer) {
+    auto bytes = Map(address, buffer.size());
+    if (bytes.empty() && !buffer.empty()) {
+        return false;
+    }
+    
+    std::memcpy(buffer.data(), bytes.data(), buffer.size());
+    return true;
+}
+
+Span<const uint8_t> MappedDumpSource::Map(MemoryAddress address, size_t size) {
+    // Offsets are checked without forming address + size, which may wrap
+    if (address < base_address_ || address - base_address_ > file_.Size() ||
+        size > file_.Size() - (address - base_address_)) {
+        return {};
+    }
+    return { file_.Data() + (address - base_address_), size };
+}
+
+std::vector<MemoryRegion> MappedDumpSource::Regions(RegionFilterStats* stats) {
+    if (stats) {
+        *stats = {};
+        stats->kept_regions = 1;
+        stats->kept_bytes = file_.Size();
+    }
+    MemoryRegion region{ base_address_, file_.Size(), PAGE_READWRITE, name_, MEM_PRIVATE };
+    return { region };
+}
+
+} // namespace MemoryForensics
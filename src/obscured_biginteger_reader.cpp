@@ -1,15 +1,20 @@
 #include "obscured_biginteger_reader.hpp"
 #include <algorithm>
+#include <cstring>
 
 namespace MemoryForensics {
 
+ObscuredBigIntegerReader::ObscuredBigIntegerReader(std::shared_ptr<MemorySource> source)
+    : source_(source), bigint_reader_(std::make_shared<DotNetBigIntegerReader>(source)) {
+}
+
 ObscuredBigIntegerReader::ObscuredBigIntegerReader(std::shared_ptr<MemoryScanner> scanner)
-    : scanner_(scanner), bigint_reader_(std::make_shared<DotNetBigIntegerReader>(scanner)) {
+    : ObscuredBigIntegerReader(scanner ? scanner->GetReadSource() : nullptr) {
 }
 
 std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigInteger(MemoryAddress base_address) {
-    if (!scanner_) {
-        LOG_ERROR("MemoryScanner is null");
+    if (!source_) {
+        LOG_ERROR("Memory source is null");
         return std::nullopt;
     }
     
@@ -19,49 +24,82 @@ std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigI
     }
     
     ObscuredBigIntegerData result;
-    MemoryAddress current_offset = base_address;
     
-    // Read hiddenValue (SerializableBigInteger)
-    auto hidden_value = ReadSerializableBigInteger(current_offset, "hiddenValue");
-    if (!hidden_value) {
-        return std::nullopt;
+    // hiddenValue and fakeValue (SerializableBigInteger) followed by currentCryptoKey (uint32),
+    // fakeValueActive (bool) and inited (bool). Value stride is an approximation, as in the verbose reader.
+    const MemoryAddress value_addresses[2] = { base_address, base_address + sizeof(SerializableBigInteger) };
+    const char* value_names[2] = { "hiddenValue", "fakeValue" };
+    const MemoryAddress trailer_address = base_address + 2 * sizeof(SerializableBigInteger);
+    
+    // First round trip: both value headers plus the trailing key and flags
+    uint8_t headers[2][DotNetBigIntegerReader::HEADER_SIZE];
+    uint8_t trailer[sizeof(uint32_t) + 2 * sizeof(bool)];
+    std::vector<ReadRequest> requests = {
+        { value_addresses[0], headers[0], sizeof(headers[0]) },
+        { value_addresses[1], headers[1], sizeof(headers[1]) },
+        { trailer_address, trailer, sizeof(trailer) }
+    };
+    source_->ReadBatch(requests);
+    
+    for (int v = 0; v < 2; ++v) {
+        if (!requests[v].success) {
+            LOG_ERROR("Failed to read {} at 0x{:X}", value_names[v], value_addresses[v]);
+            return std::nullopt;
+        }
     }
-    result.hidden_value = *hidden_value;
-    current_offset += sizeof(SerializableBigInteger); // This is an approximation
     
-    // Read fakeValue (SerializableBigInteger)
-    auto fake_value = ReadSerializableBigInteger(current_offset, "fakeValue");
-    if (!fake_value) {
+    if (!requests[2].success) {
+        LOG_ERROR("Failed to read currentCryptoKey at 0x{:X}", trailer_address);
         return std::nullopt;
     }
-    result.fake_value = *fake_value;
-    current_offset += sizeof(SerializableBigInteger);
     
-    // Read currentCryptoKey (uint32)
-    auto crypto_key = scanner_->ReadUInt32(current_offset);
-    if (!crypto_key) {
-        LOG_ERROR("Failed to read currentCryptoKey at 0x{:X}", current_offset);
-        return std::nullopt;
+    // Second round trip: the bits arrays of both values
+    BigIntegerContents contents[2];
+    std::vector<uint32_t> probes[2];
+    std::vector<ReadRequest> probe_requests;
+    std::vector<int> probe_owners;
+    
+    for (int v = 0; v < 2; ++v) {
+        MemoryAddress bits_ptr = 0;
+        std::memcpy(&contents[v].sign, headers[v], sizeof(int32_t));
+        std::memcpy(&bits_ptr, headers[v] + sizeof(int32_t), sizeof(MemoryAddress));
+        contents[v].bits_ptr = reinterpret_cast<uint32_t*>(bits_ptr);
+        contents[v].bits_length = 0;
+        
+        // If bits_ptr is null, that's valid (represents zero or small numbers)
+        if (bits_ptr == 0) {
+            continue;
+        }
+        
+        if (!IsValidPointer(bits_ptr)) {
+            LOG_WARN("Invalid bits pointer: 0x{:X}", bits_ptr);
+            return std::nullopt;
+        }
+        
+        probes[v].resize(DotNetBigIntegerReader::MAX_PROBE_LENGTH);
+        probe_requests.push_back({ bits_ptr, probes[v].data(), probes[v].size() * sizeof(uint32_t) });
+        probe_owners.push_back(v);
     }
-    result.current_crypto_key = *crypto_key;
-    current_offset += sizeof(uint32_t);
     
-    // Read fakeValueActive (bool)
-    auto fake_active = scanner_->ReadBool(current_offset);
-    if (!fake_active) {
-        LOG_ERROR("Failed to read fakeValueActive at 0x{:X}", current_offset);
-        return std::nullopt;
-    }
-    result.fake_value_active = *fake_active;
-    current_offset += sizeof(bool);
+    source_->ReadBatch(probe_requests);
     
-    // Read inited (bool)
-    auto inited = scanner_->ReadBool(current_offset);
-    if (!inited) {
-        LOG_ERROR("Failed to read inited at 0x{:X}", current_offset);
-        return std::nullopt;
+    for (size_t k = 0; k < probe_requests.size(); ++k) {
+        int v = probe_owners[k];
+        if (!probe_requests[k].success) {
+            LOG_ERROR("Failed to read bits array at 0x{:X}", probe_requests[k].address);
+            return std::nullopt;
+        }
+        
+        contents[v].bits_length = DotNetBigIntegerReader::DetermineBitsLength(probes[v], contents[v].sign);
+        contents[v].bits_data.assign(probes[v].begin(), probes[v].begin() + contents[v].bits_length);
     }
-    result.inited = *inited;
+    
+    result.hidden_value = BuildSerializableBigInteger(contents[0]);
+    result.fake_value = BuildSerializableBigInteger(contents[1]);
+    
+    std::memcpy(&result.current_crypto_key, trailer, sizeof(uint32_t));
+    result.fake_value_active = trailer[sizeof(uint32_t)] != 0;
+    result.inited = trailer[sizeof(uint32_t) + sizeof(bool)] != 0;
     
     result.is_valid = true;
     return result;
@@ -71,8 +109,8 @@ std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigI
     LOG_INFO("Reading ObscuredBigInteger at 0x{:X}", base_address);
     LOG_INDENT();
     
-    if (!scanner_) {
-        LOG_ERROR("MemoryScanner is null");
+    if (!source_) {
+        LOG_ERROR("Memory source is null");
         return std::nullopt;
     }
     
@@ -112,7 +150,7 @@ std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigI
     LOG_INFO("Reading currentCryptoKey...");
     {
         LOG_INDENT();
-        auto crypto_key = scanner_->ReadUInt32(current_offset);
+        auto crypto_key = source_->Read<uint32_t>(current_offset);
         if (!crypto_key) {
             LOG_ERROR("Failed to read currentCryptoKey at 0x{:X}", current_offset);
             return std::nullopt;
@@ -126,7 +164,7 @@ std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigI
     LOG_INFO("Reading fakeValueActive...");
     {
         LOG_INDENT();
-        auto fake_active = scanner_->ReadBool(current_offset);
+        auto fake_active = source_->Read<bool>(current_offset);
         if (!fake_active) {
             LOG_ERROR("Failed to read fakeValueActive at 0x{:X}", current_offset);
             return std::nullopt;
@@ -140,7 +178,7 @@ std::optional<ObscuredBigIntegerData> ObscuredBigIntegerReader::ReadObscuredBigI
     LOG_INFO("Reading inited...");
     {
         LOG_INDENT();
-        auto inited = scanner_->ReadBool(current_offset);
+        auto inited = source_->Read<bool>(current_offset);
         if (!inited) {
             LOG_ERROR("Failed to read inited at 0x{:X}", current_offset);
             return std::nullopt;
@@ -241,7 +279,7 @@ std::optional<BigIntegerContents> ObscuredBigIntegerReader::ReadBigIntegerConten
     MemoryAddress current_offset = address;
     
     // Read sign (int32)
-    auto sign = scanner_->ReadInt32(current_offset);
+    auto sign = source_->Read<int32_t>(current_offset);
     if (!sign) {
         LOG_ERROR("Failed to read sign at 0x{:X}", current_offset);
         return std::nullopt;
@@ -251,7 +289,7 @@ std::optional<BigIntegerContents> ObscuredBigIntegerReader::ReadBigIntegerConten
     current_offset += sizeof(int32_t);
     
     // Read bits pointer (uint32*)
-    auto bits_ptr = scanner_->ReadUInt64(current_offset);  // Assuming 64-bit pointers
+    auto bits_ptr = source_->Read<uint64_t>(current_offset);  // Assuming 64-bit pointers
     if (!bits_ptr) {
         LOG_ERROR("Failed to read bits pointer at 0x{:X}", current_offset);
         return std::nullopt;
@@ -274,38 +312,20 @@ std::optional<BigIntegerContents> ObscuredBigIntegerReader::ReadBigIntegerConten
     // Determine the length of the bits array by probing
     LOG_INDENT();
     MemoryAddress bits_address = reinterpret_cast<MemoryAddress>(result.bits_ptr);
-    const uint32_t max_probe_length = 32;
     
-    auto probe_array = scanner_->ReadUInt32Array(bits_address, max_probe_length);
+    auto probe_array = source_->ReadArray<uint32_t>(bits_address, DotNetBigIntegerReader::MAX_PROBE_LENGTH);
     if (!probe_array) {
         LOG_ERROR("Failed to read bits array at 0x{:X}", bits_address);
         return std::nullopt;
     }
     
     // Find actual length (last non-zero element)
-    uint32_t actual_length = 0;
-    for (int i = probe_array->size() - 1; i >= 0; --i) {
-        if ((*probe_array)[i] != 0) {
-            actual_length = i + 1;
-            break;
-        }
-    }
-    
-    if (actual_length == 0 && result.sign != 0) {
-        actual_length = 1;  // At least one element for non-zero numbers
-    }
-    
-    result.bits_length = actual_length;
+    result.bits_length = DotNetBigIntegerReader::DetermineBitsLength(*probe_array, result.sign);
     LogTypedValue("determined_bits_length", bits_address, result.bits_length);
     
-    // Read the actual bits data
+    // The actual bits data is a prefix of the probe
     if (result.bits_length > 0) {
-        auto bits_data = scanner_->ReadUInt32Array(bits_address, result.bits_length);
-        if (!bits_data) {
-            LOG_ERROR("Failed to read {} bits from 0x{:X}", result.bits_length, bits_address);
-            return std::nullopt;
-        }
-        result.bits_data = *bits_data;
+        result.bits_data.assign(probe_array->begin(), probe_array->begin() + result.bits_length);
         
         // Log each bit element
         for (uint32_t i = 0; i < result.bits_length; ++i) {
@@ -317,6 +337,25 @@ std::optional<BigIntegerContents> ObscuredBigIntegerReader::ReadBigIntegerConten
     return result;
 }
 
+SerializableBigInteger ObscuredBigIntegerReader::BuildSerializableBigInteger(const BigIntegerContents& contents) {
+    SerializableBigInteger result;
+    result.raw_contents = contents;
+    
+    // Both representations overlay the same memory; the BigInteger view additionally
+    // requires a valid bits pointer (a null pointer only makes sense in the raw view)
+    MemoryAddress bits_ptr = reinterpret_cast<MemoryAddress>(contents.bits_ptr);
+    if (IsValidBitsArray(bits_ptr, contents.bits_length)) {
+        result.bigint_value.sign = contents.sign;
+        result.bigint_value.bits_ptr = contents.bits_ptr;
+        result.bigint_value.bits_length = contents.bits_length;
+        result.bigint_value.bits_data = contents.bits_data;
+        result.bigint_value.is_valid = true;
+    }
+    
+    result.is_valid = true;
+    return result;
+}
+
 SerializableBigInteger ObscuredBigIntegerReader::DecryptSerializableBigInteger(const SerializableBigInteger& encrypted, 
                                                                              uint32_t key) {
     SerializableBigInteger result = encrypted;
@@ -0,0 +1,296 @@
+#include "page_cache.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MemoryForensics {
+
+namespace {
+
+// Part of a request that falls into one remote page
+struct PageSegment {
+    size_t request_index;
+    MemoryAddress page_address;
+    size_t page_offset;
+    size_t buffer_offset;
+    size_t length;
+};
+
+} // namespace
+
+PageCache::PageCache(std::shared_ptr<ProcessManager> process_mgr, size_t capacity_bytes)
+    : process_mgr_(process_mgr) {
+    pages_per_shard_ = std::max<size_t>(1, capacity_bytes / REMOTE_PAGE_SIZE / SHARD_COUNT);
+    LOG_DEBUG("Page cache initialized: {} pages in {} shards", pages_per_shard_ * SHARD_COUNT, SHARD_COUNT);
+}
+
+bool PageCache::ReadMemory(MemoryAddress address, void* buffer, size_t size) {
+    std::vector<ReadRequest> requests = { { address, buffer, size } };
+    return ReadMemoryBatch(requests) == 1;
+}
+
+size_t PageCache::ReadMemoryBatch(std::vector<ReadRequest>& requests) {
+    SyncWithProcess();
+    
+    std::vector<ReadRequest> direct_requests;
+    std::vector<size_t> direct_owners;
+    std::vector<PageSegment> pending;
+    std::vector<MemoryAddress> missing_pages;
+    std::vector<bool> failed(requests.size(), false);
+    
+    // First pass: serve every page segment that is already resident
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto& request = requests[i];
+        request.success = false;
+        
+        if (request.buffer == nullptr || request.size == 0) {
+            failed[i] = true;
+            continue;
+        }
+        
+        if (request.size > MAX_CACHED_READ) {
+            direct_requests.push_back({ request.address, request.buffer, request.size });
+            direct_owners.push_back(i);
+            continue;
+        }
+        
+        uint8_t* dest = static_cast<uint8_t*>(request.buffer);
+        size_t done = 0;
+        while (done < request.size) {
+            MemoryAddress address = request.address + done;
+            MemoryAddress page_address = address & ~static_cast<MemoryAddress>(REMOTE_PAGE_SIZE - 1);
+            size_t page_offset = static_cast<size_t>(address - page_address);
+            size_t length = std::min(REMOTE_PAGE_SIZE - page_offset, request.size - done);
+            
+            if (CopyFromPage(page_address, page_offset, dest + done, length)) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                pending.push_back({ i, page_address, page_offset, done, length });
+                missing_pages.push_back(page_address);
+            }
+            
+            done += length;
+        }
+    }
+    
+    // Second pass: fetch all missing pages with a single batched read
+    std::sort(missing_pages.begin(), missing_pages.end());
+    missing_pages.erase(std::unique(missing_pages.begin(), missing_pages.end()), missing_pages.end());
+    
+    std::vector<uint8_t> page_data(missing_pages.size() * REMOTE_PAGE_SIZE);
+    std::vector<ReadRequest> page_requests;
+    page_requests.reserve(missing_pages.size());
+    for (size_t p = 0; p < missing_pages.size(); ++p) {
+        page_requests.push_back({ missing_pages[p], page_data.data() + p * REMOTE_PAGE_SIZE, REMOTE_PAGE_SIZE });
+    }
+    
+    if (!page_requests.empty()) {
+        Generation fetched = CurrentGeneration();
+        process_mgr_->ReadMemoryBatch(page_requests);
+        
+        for (const auto& page_request : page_requests) {
+            if (page_request.success) {
+                InsertPage(page_request.address, static_cast<const uint8_t*>(page_request.buffer), fetched);
+            }
+        }
+    }
+    
+    for (const auto& segment : pending) {
+        auto it = std::lower_bound(missing_pages.begin(), missing_pages.end(), segment.page_address);
+        const auto& page_request = page_requests[std::distance(missing_pages.begin(), it)];
+        
+        if (!page_request.success) {
+            failed[segment.request_index] = true;
+            continue;
+        }
+        
+        std::memcpy(static_cast<uint8_t*>(requests[segment.request_index].buffer) + segment.buffer_offset,
+                    static_cast<const uint8_t*>(page_request.buffer) + segment.page_offset,
+                    segment.length);
+    }
+    
+    // Large reads bypass the cache entirely
+    if (!direct_requests.empty()) {
+        bypassed_.fetch_add(direct_requests.size(), std::memory_order_relaxed);
+        process_mgr_->ReadMemoryBatch(direct_requests);
+        
+        for (size_t k = 0; k < direct_requests.size(); ++k) {
+            failed[direct_owners[k]] = !direct_requests[k].success;
+        }
+    }
+    
+    size_t succeeded = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        requests[i].success = !failed[i];
+        if (requests[i].success) {
+            ++succeeded;
+        }
+    }
+    
+    return succeeded;
+}
+
+uint64_t PageCache::AdvanceEpoch() {
+    uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    LOG_DEBUG("Page cache advanced to epoch {}", epoch);
+    return epoch;
+}
+
+void PageCache::Invalidate(MemoryAddress address, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    
+    MemoryAddress page_address = address & ~static_cast<MemoryAddress>(REMOTE_PAGE_SIZE - 1);
+    MemoryAddress last_page = (address + (size - 1)) & ~static_cast<MemoryAddress>(REMOTE_PAGE_SIZE - 1);
+    for (;; page_address += REMOTE_PAGE_SIZE) {
+        Shard& shard = ShardFor(page_address);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        
+        shard.invalidations.fetch_add(1, std::memory_order_acq_rel);
+        auto it = shard.index.find(page_address);
+        if (it != shard.index.end()) {
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+        
+        if (page_address == last_page) {
+            break;
+        }
+    }
+}
+
+void PageCache::Clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.invalidations.fetch_add(1, std::memory_order_acq_rel);
+        shard.lru.clear();
+        shard.index.clear();
+    }
+}
+
+PageCache::Statistics PageCache::GetStatistics() const {
+    Statistics stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.bypassed = bypassed_.load(std::memory_order_relaxed);
+    stats.epoch = GetEpoch();
+    stats.capacity_pages = pages_per_shard_ * SHARD_COUNT;
+    
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.resident_pages += shard.lru.size();
+    }
+    
+    return stats;
+}
+
+void PageCache::ResetStatistics() {
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+    bypassed_ = 0;
+}
+
+std::shared_ptr<PageCache> PageCache::FromConfig(std::shared_ptr<ProcessManager> process_mgr,
+                                                 const nlohmann::json& config) {
+    size_t cache_size_mb = 0;
+    if (config.contains("performance") && config["performance"].contains("memory_cache_size_mb")) {
+        cache_size_mb = config["performance"]["memory_cache_size_mb"].get<size_t>();
+    }
+    
+    if (cache_size_mb == 0) {
+        LOG_DEBUG("Page cache disabled by configuration");
+        return nullptr;
+    }
+    
+    LOG_INFO("Enabling {} MB remote page cache", cache_size_mb);
+    auto cache = std::make_shared<PageCache>(process_mgr, cache_size_mb * 1024 * 1024);
+    
+    // Held weakly: the process manager may outlive the cache
+    std::weak_ptr<PageCache> weak_cache = cache;
+    process_mgr->AddWriteListener([weak_cache](MemoryAddress address, size_t size) {
+        if (auto written = weak_cache.lock()) {
+            written->Invalidate(address, size);
+        }
+    });
+    return cache;
+}
+
+PageCache::Shard& PageCache::ShardFor(MemoryAddress page_address) {
+    // Fibonacci hashing spreads consecutive pages across shards
+    uint64_t page_number = page_address / REMOTE_PAGE_SIZE;
+    return shards_[((page_number * 0x9E3779B97F4A7C15ULL) >> 32) % SHARD_COUNT];
+}
+
+bool PageCache::CopyFromPage(MemoryAddress page_address, size_t offset, uint8_t* dest, size_t length) {
+    Shard& shard = ShardFor(page_address);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    auto it = shard.index.find(page_address);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    
+    // Pages from an older epoch are invalid; drop them on sight
+    if (it->second->epoch != GetEpoch()) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        return false;
+    }
+    
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    std::memcpy(dest, it->second->data.data() + offset, length);
+    return true;
+}
+
+PageCache::Generation PageCache::CurrentGeneration() const {
+    Generation generation;
+    generation.epoch = GetEpoch();
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        generation.invalidations[i] = shards_[i].invalidations.load(std::memory_order_acquire);
+    }
+    return generation;
+}
+
+void PageCache::InsertPage(MemoryAddress page_address, const uint8_t* data, const Generation& fetched) {
+    Shard& shard = ShardFor(page_address);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    // The bytes may predate a tick or a write that happened during the fetch
+    size_t shard_index = static_cast<size_t>(&shard - shards_.data());
+    if (GetEpoch() != fetched.epoch ||
+        shard.invalidations.load(std::memory_order_acquire) != fetched.invalidations[shard_index]) {
+        return;
+    }
+    
+    auto it = shard.index.find(page_address);
+    if (it != shard.index.end()) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    } else {
+        if (shard.lru.size() >= pages_per_shard_) {
+            shard.index.erase(shard.lru.back().page_address);
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        shard.lru.push_front(Page{ page_address, 0, {} });
+        shard.index[page_address] = shard.lru.begin();
+    }
+    
+    Page& page = shard.lru.front();
+    page.epoch = fetched.epoch;
+    std::memcpy(page.data.data(), data, REMOTE_PAGE_SIZE);
+}
+
+void PageCache::SyncWithProcess() {
+    // Cached pages belong to one target; attaching elsewhere invalidates them
+    ProcessID pid = process_mgr_->GetProcessID();
+    if (cached_pid_.exchange(pid, std::memory_order_acq_rel) != pid) {
+        AdvanceEpoch();
+    }
+}
+
+} // namespace MemoryForensics
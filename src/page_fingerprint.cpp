@@ -0,0 +1,298 @@
+#include "page_fingerprint.hpp"
+#include "app_logger.hpp"
+#include "bit_utils.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PAGE_FINGERPRINT_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PAGE_FINGERPRINT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PAGE_FINGERPRINT_TARGET_AVX2
+#endif
+
+namespace MemoryForensics {
+
+namespace {
+
+constexpr size_t STRIPE = 64;
+constexpr size_t LANES = STRIPE / sizeof(uint64_t);
+
+constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+
+// Lane keys advance after every stripe, so swapping two stripes changes the hash
+constexpr uint64_t LANE_KEYS[LANES] = {
+    0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL, 0x1F67B3B7A4A44072ULL,
+    0x78E5C0CC4EE679CBULL, 0x2172FFCC7DD05A82ULL, 0x8E2443F7744608B8ULL, 0x4C263A81E69035E0ULL
+};
+constexpr uint64_t KEY_STEP = 0x5851F42D4C957F2DULL;
+
+// Each lane adds its input and the product of the keyed input's 32-bit halves
+using StripeKernel = void (*)(uint64_t* acc, uint64_t* keys, const uint8_t* data, size_t stripes);
+
+void StripesScalar(uint64_t* acc, uint64_t* keys, const uint8_t* data, size_t stripes) {
+    for (size_t s = 0; s < stripes; ++s, data += STRIPE) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            uint64_t value;
+            std::memcpy(&value, data + lane * sizeof(uint64_t), sizeof(value));
+            uint64_t keyed = value ^ keys[lane];
+            acc[lane] += value + (keyed & 0xFFFFFFFF) * (keyed >> 32);
+            keys[lane] += KEY_STEP;
+        }
+    }
+}
+
+#ifdef PAGE_FINGERPRINT_X86
+
+void StripesSse2(uint64_t* acc, uint64_t* keys, const uint8_t* data, size_t stripes) {
+    __m128i sums[LANES / 2];
+    __m128i lane_keys[LANES / 2];
+    for (size_t i = 0; i < LANES / 2; ++i) {
+        sums[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+        lane_keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys) + i);
+    }
+    
+    const __m128i step = _mm_set1_epi64x(static_cast<long long>(KEY_STEP));
+    for (size_t s = 0; s < stripes; ++s, data += STRIPE) {
+        for (size_t i = 0; i < LANES / 2; ++i) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i);
+            __m128i keyed = _mm_xor_si128(value, lane_keys[i]);
+            __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+            sums[i] = _mm_add_epi64(sums[i], _mm_add_epi64(value, product));
+            lane_keys[i] = _mm_add_epi64(lane_keys[i], step);
+        }
+    }
+    
+    for (size_t i = 0; i < LANES / 2; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, sums[i]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(keys) + i, lane_keys[i]);
+    }
+}
+
+PAGE_FINGERPRINT_TARGET_AVX2
+void StripesAvx2(uint64_t* acc, uint64_t* keys, const uint8_t* data, size_t stripes) {
+    __m256i sums[LANES / 4];
+    __m256i lane_keys[LANES / 4];
+    for (size_t i = 0; i < LANES / 4; ++i) {
+        sums[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+        lane_keys[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys) + i);
+    }
+    
+    const __m256i step = _mm256_set1_epi64x(static_cast<long long>(KEY_STEP));
+    for (size_t s = 0; s < stripes; ++s, data += STRIPE) {
+        for (size_t i = 0; i < LANES / 4; ++i) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data) + i);
+            __m256i keyed = _mm256_xor_si256(value, lane_keys[i]);
+            __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+            sums[i] = _mm256_add_epi64(sums[i], _mm256_add_epi64(value, product));
+            lane_keys[i] = _mm256_add_epi64(lane_keys[i], step);
+        }
+    }
+    
+    for (size_t i = 0; i < LANES / 4; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, sums[i]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys) + i, lane_keys[i]);
+    }
+}
+
+#endif
+
+StripeKernel SelectKernel() {
+#ifdef PAGE_FINGERPRINT_X86
+    return CpuSupportsAvx2() ? &StripesAvx2 : &StripesSse2;
+#else
+    return &StripesScalar;
+#endif
+}
+
+uint64_t Avalanche(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace
+
+uint64_t HashPage(const uint8_t* data, size_t size) {
+    uint64_t acc[LANES] = {};
+    uint64_t keys[LANES];
+    std::memcpy(keys, LANE_KEYS, sizeof(keys));
+    
+    static const StripeKernel kernel = SelectKernel();
+    size_t stripes = size / STRIPE;
+    if (stripes > 0) {
+        kernel(acc, keys, data, stripes);
+    }
+    
+    // The zero-padded tail is told apart from real zeros by the size below
+    size_t tail = size % STRIPE;
+    if (tail > 0) {
+        uint8_t block[STRIPE] = {};
+        std::memcpy(block, data + stripes * STRIPE, tail);
+        StripesScalar(acc, keys, block, 1);
+    }
+    
+    uint64_t hash = size * PRIME_1;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        hash = (hash ^ Avalanche(acc[lane])) * PRIME_1 + PRIME_3;
+        hash = (hash << 31) | (hash >> 33);
+    }
+    return Avalanche(hash);
+}
+
+void PageFingerprints::Table::FindAll(const PatternMatcher& matcher, const uint8_t* data, size_t size,
+                                      MemoryAddress address, MemoryAddress align_origin,
+                                      std::vector<MemoryAddress>& results) {
+    size_t lookbehind = matcher.Length() - 1;
+    MemoryAddress end = address + size;
+    
+    // Hits ending in (from, to]: those inside data from `lookbehind` bytes before from
+    auto match = [&](MemoryAddress from, MemoryAddress to) {
+        MemoryAddress begin = from - std::min<MemoryAddress>(lookbehind, from - address);
+        matcher.FindAll(data + (begin - address), static_cast<size_t>(to - begin), begin, align_origin, results);
+    };
+    
+    MemoryAddress pending = address;
+    Offsets offsets;
+    MemoryAddress page = (address + REMOTE_PAGE_SIZE - 1) / REMOTE_PAGE_SIZE * REMOTE_PAGE_SIZE;
+    for (; page + REMOTE_PAGE_SIZE <= end; page += REMOTE_PAGE_SIZE) {
+        // Fewer lookbehind bytes only near the start of data, where no earlier hit can begin
+        const uint8_t* page_data = data + (page - address);
+        size_t before = static_cast<size_t>(std::min<MemoryAddress>(lookbehind, page - address));
+        Key key{ HashPage(page_data, REMOTE_PAGE_SIZE), HashPage(page_data - before, before),
+                 static_cast<uint32_t>((page - align_origin) % matcher.Alignment()) };
+        
+        if (pending < page) {
+            match(pending, page);
+        }
+        
+        if (Lookup(key, offsets)) {
+            for (int16_t offset : offsets) {
+                results.push_back(page + offset);
+            }
+        } else {
+            size_t first = results.size();
+            match(page, page + REMOTE_PAGE_SIZE);
+            
+            offsets.clear();
+            for (size_t i = first; i < results.size(); ++i) {
+                offsets.push_back(static_cast<int16_t>(static_cast<int64_t>(results[i] - page)));
+            }
+            Store(key, offsets);
+        }
+        pending = page + REMOTE_PAGE_SIZE;
+    }
+    
+    if (pending < end) {
+        match(pending, end);
+    }
+}
+
+bool PageFingerprints::Table::Lookup(const Key& key, Offsets& offsets) {
+    Shard& shard = ShardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        
+        it->second.generation = generation_.load(std::memory_order_relaxed);
+        offsets = it->second.offsets;
+    }
+    
+    owner_.pages_reused_.fetch_add(1, std::memory_order_relaxed);
+    owner_.hits_reused_.fetch_add(offsets.size(), std::memory_order_relaxed);
+    return true;
+}
+
+void PageFingerprints::Table::Store(const Key& key, Offsets offsets) {
+    Shard& shard = ShardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.insert_or_assign(key, Entry{ std::move(offsets), generation_.load(std::memory_order_relaxed) });
+    }
+    
+    owner_.pages_matched_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t PageFingerprints::Table::Size() const {
+    size_t size = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.entries.size();
+    }
+    return size;
+}
+
+void PageFingerprints::Table::BeginScan() {
+    uint64_t generation = generation_.fetch_add(1, std::memory_order_relaxed) + 1;
+    
+    // Content the previous scan did not see has changed or been freed
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            if (it->second.generation + 1 < generation) {
+                it = shard.entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+std::shared_ptr<PageFingerprints::Table> PageFingerprints::BeginScan(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++scans_;
+    
+    auto& table = tables_[key];
+    if (!table) {
+        table.reset(new Table(*this));
+    }
+    table->last_used_ = scans_;
+    auto current = table;
+    
+    if (tables_.size() > MAX_TABLES) {
+        auto oldest = std::min_element(tables_.begin(), tables_.end(), [](const auto& a, const auto& b) {
+            return a.second->last_used_ < b.second->last_used_;
+        });
+        LOG_DEBUG("Dropping page fingerprints of {}", oldest->first);
+        tables_.erase(oldest);
+    }
+    
+    current->BeginScan();
+    return current;
+}
+
+void PageFingerprints::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.clear();
+    pages_reused_ = 0;
+    pages_matched_ = 0;
+    hits_reused_ = 0;
+}
+
+PageFingerprints::Statistics PageFingerprints::GetStatistics() const {
+    Statistics stats;
+    stats.pages_reused = pages_reused_.load(std::memory_order_relaxed);
+    stats.pages_matched = pages_matched_.load(std::memory_order_relaxed);
+    stats.hits_reused = hits_reused_.load(std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.tables = tables_.size();
+    for (const auto& [key, table] : tables_) {
+        stats.entries += table->Size();
+    }
+    return stats;
+}
+
+} // namespace MemoryForensics
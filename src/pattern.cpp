@@ -0,0 +1,182 @@
+#include "pattern.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace MemoryForensics {
+
+namespace {
+
+// Rough likelihood of a byte value in heap and code pages; lower is rarer
+int ByteFrequency(uint8_t value) {
+    switch (value) {
+        case 0x00: return 100;
+        case 0xFF: return 80;
+        case 0x48: case 0x8B: case 0x89: case 0xCC: case 0x90: case 0xE8: return 60;
+        default: break;
+    }
+    
+    if (value < 0x10) {
+        return 50;
+    }
+    if (value >= 0x20 && value < 0x7F) {
+        return 30;  // ASCII text, UTF-16 strings
+    }
+    return 10;
+}
+
+// Value and mask of one hex digit or '?'
+bool ParseNibble(char c, uint8_t& value, uint8_t& mask) {
+    if (c == '?') {
+        value = 0;
+        mask = 0;
+        return true;
+    }
+    
+    if (!std::isxdigit(static_cast<unsigned char>(c))) {
+        return false;
+    }
+    
+    value = static_cast<uint8_t>(std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : std::toupper(c) - 'A' + 10);
+    mask = 0xF;
+    return true;
+}
+
+} // namespace
+
+Pattern::Pattern(const ByteVector& bytes, const ByteVector& mask)
+    : bytes_(bytes), mask_(bytes.size(), 0xFF) {
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+        if (i < mask.size()) {
+            mask_[i] = mask[i];
+        }
+        bytes_[i] &= mask_[i];
+    }
+    
+    BuildPlan();
+}
+
+std::optional<Pattern> Pattern::Parse(const std::string& text) {
+    ByteVector bytes;
+    ByteVector mask;
+    
+    size_t i = 0;
+    while (i < text.length()) {
+        if (std::isspace(static_cast<unsigned char>(text[i]))) {
+            ++i;
+            continue;
+        }
+        
+        // A lone '?' between separators is a whole-byte wildcard
+        bool lone_wildcard = text[i] == '?' &&
+                             (i + 1 >= text.length() || std::isspace(static_cast<unsigned char>(text[i + 1])));
+        if (lone_wildcard) {
+            bytes.push_back(0x00);
+            mask.push_back(0x00);
+            ++i;
+            continue;
+        }
+        
+        uint8_t high = 0, high_mask = 0, low = 0, low_mask = 0;
+        if (i + 1 >= text.length() ||
+            !ParseNibble(text[i], high, high_mask) ||
+            !ParseNibble(text[i + 1], low, low_mask)) {
+            return std::nullopt;
+        }
+        
+        bytes.push_back(static_cast<uint8_t>((high << 4) | low));
+        mask.push_back(static_cast<uint8_t>((high_mask << 4) | low_mask));
+        i += 2;
+    }
+    
+    if (bytes.empty()) {
+        return std::nullopt;
+    }
+    
+    return Pattern(bytes, mask);
+}
+
+Pattern Pattern::FromBytes(const ByteVector& bytes, const ByteVector& mask) {
+    ByteVector bit_mask(bytes.size(), 0xFF);
+    for (size_t i = 0; i < bytes.size() && i < mask.size(); ++i) {
+        bit_mask[i] = mask[i] == 0 ? 0x00 : 0xFF;
+    }
+    return Pattern(bytes, bit_mask);
+}
+
+bool Pattern::Matches(const uint8_t* data) const {
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+        if ((data[i] & mask_[i]) != bytes_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string Pattern::ToString() const {
+    static const char* digits = "0123456789ABCDEF";
+    std::string text;
+    
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+        if (i > 0) {
+            text += ' ';
+        }
+        text += (mask_[i] & 0xF0) ? digits[bytes_[i] >> 4] : '?';
+        text += (mask_[i] & 0x0F) ? digits[bytes_[i] & 0xF] : '?';
+    }
+    
+    return text;
+}
+
+void Pattern::BuildPlan() {
+    // Rank the fixed bytes by rarity; ties go to the earlier offset
+    std::vector<size_t> fixed;
+    for (size_t i = 0; i < bytes_.size(); ++i) {
+        if (IsFixed(i)) {
+            fixed.push_back(i);
+        }
+    }
+    
+    if (fixed.empty()) {
+        plan_.strategy = Strategy::Wildcard;
+        return;
+    }
+    
+    std::stable_sort(fixed.begin(), fixed.end(), [this](size_t a, size_t b) {
+        return ByteFrequency(bytes_[a]) < ByteFrequency(bytes_[b]);
+    });
+    plan_.anchor = fixed[0];
+    plan_.second_anchor = fixed.size() > 1 ? fixed[1] : fixed[0];
+    
+    // Longest run of fixed bytes
+    size_t run_start = 0;
+    for (size_t i = 0; i <= bytes_.size(); ++i) {
+        if (i < bytes_.size() && IsFixed(i)) {
+            continue;
+        }
+        
+        if (i - run_start > plan_.run_length) {
+            plan_.run_offset = run_start;
+            plan_.run_length = i - run_start;
+        }
+        run_start = i + 1;
+    }
+    
+    if (plan_.run_length < HORSPOOL_MIN_RUN) {
+        plan_.strategy = Strategy::Anchor;
+        return;
+    }
+    
+    // Horspool shifts are keyed on the byte under the run's last position
+    size_t max_shift = std::min<size_t>(plan_.run_length, 255);
+    plan_.skip.fill(static_cast<uint8_t>(max_shift));
+    for (size_t i = 0; i + 1 < plan_.run_length; ++i) {
+        size_t shift = plan_.run_length - 1 - i;
+        if (shift <= max_shift) {
+            plan_.skip[bytes_[plan_.run_offset + i]] = static_cast<uint8_t>(shift);
+        }
+    }
+    
+    plan_.strategy = Strategy::Horspool;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,249 @@
+#include "pattern_matcher.hpp"
+#include "bit_utils.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PATTERN_MATCHER_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PATTERN_MATCHER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PATTERN_MATCHER_TARGET_AVX2
+#endif
+
+namespace MemoryForensics {
+
+namespace {
+
+constexpr size_t VERIFY_BLOCK = 16;
+
+} // namespace
+
+PatternMatcher::PatternMatcher(const Pattern& pattern, size_t alignment)
+    : pattern_(pattern), length_(pattern.Length()), alignment_(std::max<size_t>(alignment, 1)) {
+    padded_length_ = (length_ + VERIFY_BLOCK - 1) / VERIFY_BLOCK * VERIFY_BLOCK;
+    bytes_.assign(padded_length_, 0x00);
+    mask_.assign(padded_length_, 0x00);
+    std::copy(pattern.Bytes().begin(), pattern.Bytes().end(), bytes_.begin());
+    std::copy(pattern.Mask().begin(), pattern.Mask().end(), mask_.begin());
+    
+    anchor_ = pattern.GetPlan().anchor;
+    second_anchor_ = pattern.GetPlan().second_anchor;
+}
+
+void PatternMatcher::FindAll(const uint8_t* data, size_t size, MemoryAddress address,
+                             MemoryAddress align_origin, std::vector<MemoryAddress>& results) const {
+    if (length_ == 0 || size < length_) {
+        return;
+    }
+    
+    size_t phase = static_cast<size_t>((address - align_origin) % alignment_);
+    std::vector<size_t> hits;
+    
+    switch (pattern_.GetPlan().strategy) {
+        case Pattern::Strategy::Wildcard:
+            // Nothing to anchor on: verify every aligned offset
+            for (size_t i = 0; i + length_ <= size; ++i) {
+                if (IsAligned(phase, i) && pattern_.Matches(data + i)) {
+                    hits.push_back(i);
+                }
+            }
+            break;
+        
+        case Pattern::Strategy::Horspool:
+            FindHorspool(data, size, phase, hits);
+            break;
+        
+        case Pattern::Strategy::Anchor: {
+            static const Kernel kernel = SelectKernel();
+            (this->*kernel)(data, size, phase, hits);
+            break;
+        }
+    }
+    
+    for (size_t offset : hits) {
+        results.push_back(address + offset);
+    }
+}
+
+const char* PatternMatcher::ActiveKernel() {
+    Kernel kernel = SelectKernel();
+    if (kernel == &PatternMatcher::FindAvx2) {
+        return "avx2";
+    }
+    if (kernel == &PatternMatcher::FindSse2) {
+        return "sse2";
+    }
+    return "scalar";
+}
+
+PatternMatcher::Kernel PatternMatcher::SelectKernel() {
+#ifdef PATTERN_MATCHER_X86
+    // SSE2 is part of the x86-64 baseline; AVX2 depends on the CPU
+    return CpuSupportsAvx2() ? &PatternMatcher::FindAvx2 : &PatternMatcher::FindSse2;
+#else
+    return &PatternMatcher::FindScalar;
+#endif
+}
+
+bool PatternMatcher::IsAligned(size_t phase, size_t position) const {
+    return alignment_ == 1 || (phase + position) % alignment_ == 0;
+}
+
+bool PatternMatcher::Verify(const uint8_t* candidate, size_t available) const {
+#ifdef PATTERN_MATCHER_X86
+    // Whole 16-byte blocks can be compared when the padding stays inside the buffer
+    if (available >= padded_length_) {
+        for (size_t i = 0; i < padded_length_; i += VERIFY_BLOCK) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate + i));
+            __m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes_.data() + i));
+            __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask_.data() + i));
+            
+            __m128i matched = _mm_cmpeq_epi8(_mm_and_si128(block, mask), expected);
+            if (_mm_movemask_epi8(matched) != 0xFFFF) {
+                return false;
+            }
+        }
+        return true;
+    }
+#else
+    (void)available;
+#endif
+
+    return pattern_.Matches(candidate);
+}
+
+void PatternMatcher::FindScalar(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    uint8_t anchor_byte = bytes_[anchor_];
+    
+    // memchr is vectorized by the C library, so let it find the anchor
+    size_t i = 0;
+    while (i <= last) {
+        const void* found = std::memchr(data + i + anchor_, anchor_byte, last - i + 1);
+        if (found == nullptr) {
+            break;
+        }
+        
+        i = static_cast<size_t>(static_cast<const uint8_t*>(found) - data) - anchor_;
+        if (IsAligned(phase, i) && Verify(data + i, size - i)) {
+            hits.push_back(i);
+        }
+        ++i;
+    }
+}
+
+void PatternMatcher::FindHorspool(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    const Pattern::Plan& plan = pattern_.GetPlan();
+    const uint8_t* run = bytes_.data() + plan.run_offset;
+    size_t run_last = plan.run_offset + plan.run_length - 1;
+    size_t last = size - length_;
+    
+    // Shift by the byte under the run's last position until the run lines up
+    size_t i = 0;
+    while (i <= last) {
+        uint8_t tail = data[i + run_last];
+        if (tail == run[plan.run_length - 1] &&
+            std::memcmp(data + i + plan.run_offset, run, plan.run_length - 1) == 0 &&
+            IsAligned(phase, i) && Verify(data + i, size - i)) {
+            hits.push_back(i);
+        }
+        i += plan.skip[tail];
+    }
+}
+
+#ifdef PATTERN_MATCHER_X86
+
+void PatternMatcher::FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    const __m128i first = _mm_set1_epi8(static_cast<char>(bytes_[anchor_]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(bytes_[second_anchor_]));
+    
+    // 32 candidate offsets per step; a load at offset + anchor never passes size
+    size_t i = 0;
+    for (; i + 32 <= last + 1; i += 32) {
+        const uint8_t* p = data + i;
+        __m128i lo = _mm_and_si128(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + anchor_)), first),
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + second_anchor_)), second));
+        __m128i hi = _mm_and_si128(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 + anchor_)), first),
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 + second_anchor_)), second));
+        
+        uint64_t bits = static_cast<uint32_t>(_mm_movemask_epi8(lo)) |
+                        (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hi))) << 16);
+        while (bits != 0) {
+            size_t position = i + CountTrailingZeros(bits);
+            bits &= bits - 1;
+            
+            if (IsAligned(phase, position) && Verify(data + position, size - position)) {
+                hits.push_back(position);
+            }
+        }
+    }
+    
+    // Remaining offsets go through the scalar path
+    if (i <= last) {
+        std::vector<size_t> tail;
+        FindScalar(data + i, size - i, (phase + i) % alignment_, tail);
+        for (size_t offset : tail) {
+            hits.push_back(i + offset);
+        }
+    }
+}
+
+PATTERN_MATCHER_TARGET_AVX2
+void PatternMatcher::FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(bytes_[anchor_]));
+    const __m256i second = _mm256_set1_epi8(static_cast<char>(bytes_[second_anchor_]));
+    
+    // 64 candidate offsets per step
+    size_t i = 0;
+    for (; i + 64 <= last + 1; i += 64) {
+        const uint8_t* p = data + i;
+        __m256i lo = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + anchor_)), first),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + second_anchor_)), second));
+        __m256i hi = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 + anchor_)), first),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 + second_anchor_)), second));
+        
+        uint64_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(lo)) |
+                        (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi))) << 32);
+        while (bits != 0) {
+            size_t position = i + CountTrailingZeros(bits);
+            bits &= bits - 1;
+            
+            if (IsAligned(phase, position) && Verify(data + position, size - position)) {
+                hits.push_back(position);
+            }
+        }
+    }
+    
+    // Fewer than 64 offsets left: finish with the narrower kernel
+    if (i <= last) {
+        std::vector<size_t> tail;
+        FindSse2(data + i, size - i, (phase + i) % alignment_, tail);
+        for (size_t offset : tail) {
+            hits.push_back(i + offset);
+        }
+    }
+}
+
+#else
+
+void PatternMatcher::FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    FindScalar(data, size, phase, hits);
+}
+
+void PatternMatcher::FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    FindScalar(data, size, phase, hits);
+}
+
+#endif
+
+} // namespace MemoryForensics
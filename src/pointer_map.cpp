@@ -0,0 +1,202 @@
+#include "pointer_map.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace MemoryForensics {
+
+PointerMap::PointerMap(std::vector<Entry> entries, std::vector<Module> modules)
+    : owned_entries_(std::move(entries)), modules_(std::move(modules)) {
+    std::sort(owned_entries_.begin(), owned_entries_.end(), [](const Entry& a, const Entry& b) {
+        return a.value != b.value ? a.value < b.value : a.address < b.address;
+    });
+    std::sort(modules_.begin(), modules_.end(), [](const Module& a, const Module& b) {
+        return a.base < b.base;
+    });
+    
+    owned_index_.resize(owned_entries_.size());
+    std::iota(owned_index_.begin(), owned_index_.end(), 0);
+    std::sort(owned_index_.begin(), owned_index_.end(), [this](uint64_t a, uint64_t b) {
+        return owned_entries_[a].address < owned_entries_[b].address;
+    });
+    
+    entries_ = owned_entries_.data();
+    by_address_ = owned_index_.data();
+    count_ = owned_entries_.size();
+}
+
+std::shared_ptr<const PointerMap> PointerMap::Load(const std::string& path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->Open(path)) {
+        return nullptr;
+    }
+    
+    const uint8_t* data = file->Data();
+    size_t size = file->Size();
+    
+    FileHeader header;
+    if (size < sizeof(header)) {
+        LOG_ERROR("{} is too small to be a pointer map", path);
+        return nullptr;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION) {
+        LOG_ERROR("{} is not a version {} pointer map", path, FILE_VERSION);
+        return nullptr;
+    }
+    
+    // Every section has to lie inside the file; the names run from the end of
+    // the module records up to the entries
+    if (!FileLayout::FitsInFile(header.modules_offset, header.module_count, sizeof(ModuleRecord), size) ||
+        !FileLayout::FitsInFile(header.entries_offset, header.entry_count, sizeof(Entry), size) ||
+        !FileLayout::FitsInFile(header.index_offset, header.entry_count, sizeof(uint64_t), size) ||
+        header.modules_offset + uint64_t{header.module_count} * sizeof(ModuleRecord) > header.entries_offset ||
+        header.entries_offset % 8 != 0 || header.index_offset % 8 != 0) {
+        LOG_ERROR("Pointer map {} is truncated or corrupt", path);
+        return nullptr;
+    }
+    uint64_t names_offset = header.modules_offset + uint64_t{header.module_count} * sizeof(ModuleRecord);
+    
+    std::shared_ptr<PointerMap> map(new PointerMap());
+    
+    for (uint32_t i = 0; i < header.module_count; ++i) {
+        ModuleRecord record;
+        std::memcpy(&record, data + header.modules_offset + i * sizeof(ModuleRecord), sizeof(record));
+        if (uint64_t{record.name_offset} + record.name_length > header.entries_offset - names_offset) {
+            LOG_ERROR("Pointer map {} has a corrupt module table", path);
+            return nullptr;
+        }
+        
+        const char* name = reinterpret_cast<const char*>(data + names_offset + record.name_offset);
+        map->modules_.push_back({ static_cast<MemoryAddress>(record.base),
+                                  static_cast<MemoryAddress>(record.base + record.size),
+                                  std::string(name, record.name_length) });
+    }
+    
+    map->entries_ = reinterpret_cast<const Entry*>(data + header.entries_offset);
+    map->by_address_ = reinterpret_cast<const uint64_t*>(data + header.index_offset);
+    map->count_ = static_cast<size_t>(header.entry_count);
+    
+    // ValueAt dereferences the index, so it must stay in range
+    for (size_t i = 0; i < map->count_; ++i) {
+        if (map->by_address_[i] >= map->count_) {
+            LOG_ERROR("Pointer map {} has a corrupt address index", path);
+            return nullptr;
+        }
+    }
+    
+    map->file_ = std::move(file);
+    
+    LOG_INFO("Mapped pointer map {} ({} pointers, {} modules)", path, map->count_, map->modules_.size());
+    return map;
+}
+
+bool PointerMap::Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("Failed to create {}", path);
+        return false;
+    }
+    
+    std::string names;
+    std::vector<ModuleRecord> records;
+    for (const auto& module : modules_) {
+        records.push_back({ module.base, module.end - module.base,
+                            static_cast<uint32_t>(names.size()), static_cast<uint32_t>(module.name.size()) });
+        names += module.name;
+    }
+    
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.module_count = static_cast<uint32_t>(records.size());
+    header.entry_count = count_;
+    header.modules_offset = sizeof(FileHeader);
+    header.entries_offset = FileLayout::AlignUp(header.modules_offset + records.size() * sizeof(ModuleRecord) + names.size());
+    header.index_offset = header.entries_offset + count_ * sizeof(Entry);
+    
+    static const char padding[8] = {};
+    size_t names_end = header.modules_offset + records.size() * sizeof(ModuleRecord) + names.size();
+    
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ModuleRecord));
+    out.write(names.data(), names.size());
+    out.write(padding, header.entries_offset - names_end);
+    out.write(reinterpret_cast<const char*>(entries_), count_ * sizeof(Entry));
+    out.write(reinterpret_cast<const char*>(by_address_), count_ * sizeof(uint64_t));
+    
+    if (!out) {
+        LOG_ERROR("Failed to write pointer map {}", path);
+        return false;
+    }
+    
+    LOG_INFO("Saved {} pointers to {}", count_, path);
+    return true;
+}
+
+const PointerMap::Module* PointerMap::FindModule(MemoryAddress address) const {
+    auto it = std::upper_bound(modules_.begin(), modules_.end(), address,
+                               [](MemoryAddress value, const Module& module) { return value < module.base; });
+    if (it == modules_.begin()) {
+        return nullptr;
+    }
+    
+    --it;
+    return address < it->end ? &*it : nullptr;
+}
+
+std::optional<MemoryAddress> PointerMap::ModuleBase(const std::string& name) const {
+    for (const auto& module : modules_) {
+        if (module.name == name) {
+            return module.base;
+        }
+    }
+    
+    // Windows module names are case-insensitive
+    for (const auto& module : modules_) {
+        if (EqualsIgnoreCase(module.name, name)) {
+            return module.base;
+        }
+    }
+    return std::nullopt;
+}
+
+std::pair<const PointerMap::Entry*, const PointerMap::Entry*> PointerMap::PointingInto(MemoryAddress low, MemoryAddress high) const {
+    const Entry* first = std::lower_bound(entries_, entries_ + count_, low,
+                                          [](const Entry& entry, MemoryAddress value) { return entry.value < value; });
+    const Entry* last = std::upper_bound(first, entries_ + count_, high,
+                                         [](MemoryAddress value, const Entry& entry) { return value < entry.value; });
+    return { first, last };
+}
+
+std::optional<MemoryAddress> PointerMap::ValueAt(MemoryAddress slot) const {
+    const uint64_t* it = std::lower_bound(by_address_, by_address_ + count_, slot,
+                                          [this](uint64_t index, MemoryAddress address) { return entries_[index].address < address; });
+    if (it == by_address_ + count_ || entries_[*it].address != slot) {
+        return std::nullopt;
+    }
+    return static_cast<MemoryAddress>(entries_[*it].value);
+}
+
+std::optional<MemoryAddress> PointerMap::ResolvePath(const PointerPath& path) const {
+    auto base = ModuleBase(path.module);
+    if (!base || path.offsets.empty()) {
+        return std::nullopt;
+    }
+    
+    MemoryAddress current = *base;
+    for (size_t offset : path.offsets) {
+        auto next = ValueAt(current + offset);
+        if (!next) {
+            return std::nullopt;
+        }
+        current = *next;
+    }
+    
+    return current;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,202 @@
+#include "pointer_scanner.hpp"
+#include "app_logger.hpp"
+#include "region_map.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace MemoryForensics {
+
+PointerScanner::PointerScanner(std::shared_ptr<MemoryScanner> scanner)
+    : scanner_(scanner) {
+}
+
+bool PointerScanner::BuildPointerMap() {
+    map_.reset();
+    
+    auto source = scanner_->GetMemorySource();
+    auto region_map = source->GetRegionMap();
+    if (!region_map || region_map->Empty()) {
+        LOG_ERROR("No memory regions to build a pointer map from");
+        return false;
+    }
+    
+    std::vector<PointerMap::Module> modules;
+    for (const auto& module : source->Modules()) {
+        modules.push_back({ module.base, module.base + module.size, module.name });
+    }
+    
+    // Cheap bounds test before the region lookup
+    const MemoryAddress lowest = region_map->BaseAt(0);
+    const MemoryAddress highest = region_map->EndAt(region_map->Size() - 1);
+    
+    std::vector<std::vector<PointerMap::Entry>> task_pointers;
+    scanner_->SweepScanRegions(sizeof(MemoryAddress),
+        [&](size_t task_count) {
+            task_pointers.assign(task_count, {});
+        },
+        [&](const SweepSpan& span) {
+            auto& out = task_pointers[span.task];
+            
+            MemoryAddress slot = (span.owned_begin + POINTER_ALIGNMENT - 1) & ~static_cast<MemoryAddress>(POINTER_ALIGNMENT - 1);
+            for (; slot < span.owned_end; slot += POINTER_ALIGNMENT) {
+                MemoryAddress value;
+                std::memcpy(&value, span.data + (slot - span.address), sizeof(value));
+                
+                if (value < lowest || value >= highest || (value & 3) != 0) {
+                    continue;
+                }
+                if (region_map->Find(value) != RegionMap::npos) {
+                    out.push_back({ value, slot });
+                }
+            }
+        });
+    
+    size_t total = 0;
+    for (const auto& pointers : task_pointers) {
+        total += pointers.size();
+    }
+    
+    std::vector<PointerMap::Entry> entries;
+    entries.reserve(total);
+    for (auto& pointers : task_pointers) {
+        entries.insert(entries.end(), pointers.begin(), pointers.end());
+        std::vector<PointerMap::Entry>().swap(pointers);
+    }
+    
+    map_ = std::make_shared<PointerMap>(std::move(entries), std::move(modules));
+    
+    LOG_INFO("Pointer map holds {} pointers ({} MB), {} modules",
+             map_->Size(), map_->Size() * sizeof(PointerMap::Entry) >> 20, map_->Modules().size());
+    return !map_->Empty();
+}
+
+std::vector<PointerPath> PointerScanner::FindPaths(MemoryAddress target, const PointerScanOptions& options) const {
+    if (!map_) {
+        return {};
+    }
+    return FindPaths(*map_, target, options);
+}
+
+std::vector<PointerPath> PointerScanner::FindPaths(const PointerMap& map, MemoryAddress target,
+                                                   const PointerScanOptions& options) {
+    std::vector<PointerPath> paths;
+    if (map.Empty() || options.max_depth == 0) {
+        return paths;
+    }
+    
+    // The last link is dereferenced too, so the first level needs exact hits
+    std::vector<Node> nodes;
+    auto [first, last] = map.PointingInto(target, target);
+    for (auto it = first; it != last; ++it) {
+        nodes.push_back({ it->address, NO_PARENT, 0 });
+    }
+    
+    size_t level_begin = 0;
+    for (size_t depth = 1; depth <= options.max_depth; ++depth) {
+        size_t level_end = nodes.size();
+        
+        for (size_t i = level_begin; i < level_end; ++i) {
+            // A static slot ends the path; it is not expanded further
+            if (const PointerMap::Module* module = map.FindModule(nodes[i].slot)) {
+                paths.push_back(MakePath(nodes, i, *module));
+                if (paths.size() >= options.max_results) {
+                    return paths;
+                }
+                continue;
+            }
+            
+            if (depth == options.max_depth || nodes.size() >= options.max_nodes) {
+                continue;
+            }
+            
+            MemoryAddress slot = nodes[i].slot;
+            MemoryAddress low = slot > options.max_offset ? slot - options.max_offset : 0;
+            auto [candidates_begin, candidates_end] = map.PointingInto(low, slot);
+            for (auto it = candidates_begin; it != candidates_end && nodes.size() < options.max_nodes; ++it) {
+                nodes.push_back({ it->address, i, static_cast<size_t>(slot - it->value) });
+            }
+        }
+        
+        if (level_end == nodes.size()) {
+            break;
+        }
+        level_begin = level_end;
+    }
+    
+    if (nodes.size() >= options.max_nodes) {
+        LOG_WARN("Pointer search stopped expanding at {} nodes", options.max_nodes);
+    }
+    
+    LOG_INFO("Found {} pointer paths to 0x{:X}", paths.size(), target);
+    return paths;
+}
+
+std::vector<PointerPath> PointerScanner::IntersectPaths(const std::vector<PointerPath>& a,
+                                                        const std::vector<PointerPath>& b) {
+    auto lowered = [](const std::string& name) {
+        std::string result = name;
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return result;
+    };
+    
+    using Key = std::pair<std::string, std::vector<size_t>>;
+    auto keys_of = [&](const std::vector<PointerPath>& paths) {
+        std::vector<std::pair<Key, size_t>> keys;
+        keys.reserve(paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            keys.push_back({ { lowered(paths[i].module), paths[i].offsets }, i });
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    
+    auto keys_a = keys_of(a);
+    auto keys_b = keys_of(b);
+    
+    // Merge the two sorted key lists, keeping a's spelling of each path
+    std::vector<PointerPath> result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_a.size() && j < keys_b.size()) {
+        if (keys_a[i].first < keys_b[j].first) {
+            ++i;
+        } else if (keys_b[j].first < keys_a[i].first) {
+            ++j;
+        } else {
+            result.push_back(a[keys_a[i].second]);
+            ++i;
+            ++j;
+        }
+    }
+    
+    return result;
+}
+
+std::vector<PointerPath> PointerScanner::KeepResolving(const std::vector<PointerPath>& paths,
+                                                       const PointerMap& map, MemoryAddress target) {
+    std::vector<PointerPath> result;
+    for (const auto& path : paths) {
+        auto resolved = map.ResolvePath(path);
+        if (resolved && *resolved == target) {
+            result.push_back(path);
+        }
+    }
+    return result;
+}
+
+PointerPath PointerScanner::MakePath(const std::vector<Node>& nodes, size_t index, const PointerMap::Module& module) {
+    PointerPath path;
+    path.module = module.name;
+    path.offsets.push_back(static_cast<size_t>(nodes[index].slot - module.base));
+    
+    // Walk towards the target; each node's offset leads to its parent's slot
+    for (size_t i = index; nodes[i].parent != NO_PARENT; i = nodes[i].parent) {
+        path.offsets.push_back(nodes[i].offset);
+    }
+    
+    return path;
+}
+
+} // namespace MemoryForensics
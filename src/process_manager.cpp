@@ -2,6 +2,7 @@
 #include "app_logger.hpp"
 #include <algorithm>
 #include <iostream>
+#include <limits>
 
 namespace MemoryForensics {
 
@@ -25,6 +26,7 @@ bool ProcessManager::AttachToProcess(const std::string& process_name) {
     return AttachToProcess(*pid_opt);
 }
 
+#ifndef LINUX_BUILD
 bool ProcessManager::AttachToProcess(ProcessID pid) {
     LOG_INFO("Attempting to attach to process ID: {}", pid);
     
@@ -74,6 +76,8 @@ bool ProcessManager::AttachToProcess(ProcessID pid) {
         process_name_ = "Unknown";
     }
     
+    RefreshRegionMap();
+    
     if (!ValidateProcessAccess()) {
         LOG_WARN("Process access validation failed for PID {}", pid);
     }
@@ -91,63 +95,33 @@ void ProcessManager::DetachFromProcess() {
         process_handle_ = nullptr;
         process_id_ = 0;
         process_name_.clear();
+        ResetFilterCache();
+        
+        std::lock_guard<std::mutex> lock(region_map_mutex_);
+        region_map_.reset();
     }
 }
 
-std::vector<MemoryRegion> ProcessManager::EnumerateMemoryRegions() {
-    std::vector<MemoryRegion> regions;
-    
-    if (!IsAttached()) {
-        LOG_ERROR("Not attached to any process");
-        return regions;
-    }
-    
-    LOG_DEBUG("Enumerating memory regions for process {}", process_id_);
+std::vector<RegionMap::Entry> ProcessManager::QueryRegionEntries(MemoryAddress start, MemoryAddress end) {
+    std::vector<RegionMap::Entry> entries;
     
     MEMORY_BASIC_INFORMATION mbi;
-    MemoryAddress current_address = 0;
+    MemoryAddress current_address = start;
     
-    while (VirtualQueryEx(process_handle_, 
+    while (current_address < end &&
+           VirtualQueryEx(process_handle_, 
                          reinterpret_cast<LPCVOID>(current_address), 
                          &mbi, 
                          sizeof(mbi)) == sizeof(mbi)) {
         
         if (mbi.State == MEM_COMMIT) {
-            MemoryRegion region;
-            region.base_address = reinterpret_cast<MemoryAddress>(mbi.BaseAddress);
-            region.size = mbi.RegionSize;
-            region.protection = mbi.Protect;
-            
-            // Determine region type/name
-            if (mbi.Type == MEM_IMAGE) {
-                region.name = "IMAGE";
-            } else if (mbi.Type == MEM_MAPPED) {
-                region.name = "MAPPED";
-            } else if (mbi.Type == MEM_PRIVATE) {
-                region.name = "PRIVATE";
-            } else {
-                region.name = "UNKNOWN";
-            }
-            
-            // Add protection information to name
-            std::string protection_str;
-            if (mbi.Protect & PAGE_EXECUTE) protection_str += "X";
-            if (mbi.Protect & PAGE_READWRITE) protection_str += "RW";
-            else if (mbi.Protect & PAGE_READONLY) protection_str += "R";
-            if (mbi.Protect & PAGE_WRITECOPY) protection_str += "WC";
-            
-            if (!protection_str.empty()) {
-                region.name += "_" + protection_str;
-            }
-            
-            regions.push_back(region);
+            entries.push_back({ reinterpret_cast<MemoryAddress>(mbi.BaseAddress), mbi.RegionSize, mbi.Protect, mbi.Type });
         }
         
         current_address = reinterpret_cast<MemoryAddress>(mbi.BaseAddress) + mbi.RegionSize;
     }
     
-    LOG_DEBUG("Found {} memory regions", regions.size());
-    return regions;
+    return entries;
 }
 
 bool ProcessManager::ReadMemory(MemoryAddress address, void* buffer, size_t size) {
@@ -185,6 +159,50 @@ bool ProcessManager::ReadMemory(MemoryAddress address, void* buffer, size_t size
     return true;
 }
 
+size_t ProcessManager::ReadMemoryBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    for (auto& request : requests) {
+        request.success = false;
+    }
+    
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        if (on_complete) {
+            for (size_t i = 0; i < requests.size(); ++i) {
+                on_complete(i);
+            }
+        }
+        return 0;
+    }
+    
+    // ReadProcessMemory has no vectored form, so keep the loop tight and quiet
+    size_t succeeded = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto& request = requests[i];
+        if (request.buffer != nullptr && request.size != 0 && request.size <= MAX_READ_SIZE) {
+            SIZE_T bytes_read = 0;
+            BOOL result = ReadProcessMemory(
+                process_handle_,
+                reinterpret_cast<LPCVOID>(request.address),
+                request.buffer,
+                request.size,
+                &bytes_read
+            );
+            
+            request.success = result && bytes_read == request.size;
+            if (request.success) {
+                ++succeeded;
+            }
+        }
+        
+        if (on_complete) {
+            on_complete(i);
+        }
+    }
+    
+    LOG_DEBUG("Batch read completed {}/{} requests", succeeded, requests.size());
+    return succeeded;
+}
+
 bool ProcessManager::WriteMemory(MemoryAddress address, const void* buffer, size_t size) {
     if (!IsAttached()) {
         LOG_ERROR("Not attached to any process");
@@ -213,6 +231,7 @@ bool ProcessManager::WriteMemory(MemoryAddress address, const void* buffer, size
     }
     
     LOG_DEBUG("Successfully wrote {} bytes to 0x{:X}", size, address);
+    NotifyWrite(address, size);
     return true;
 }
 
@@ -238,6 +257,8 @@ std::vector<std::pair<ProcessID, std::string>> ProcessManager::ListRunningProces
     return processes;
 }
 
+#endif // !LINUX_BUILD
+
 std::optional<ProcessID> ProcessManager::FindProcessByName(const std::string& name) {
     auto processes = ListRunningProcesses();
     
@@ -266,6 +287,7 @@ std::optional<ProcessID> ProcessManager::FindProcessByName(const std::string& na
     return std::nullopt;
 }
 
+#ifndef LINUX_BUILD
 std::vector<MODULEENTRY32> ProcessManager::GetLoadedModules() {
     std::vector<MODULEENTRY32> modules;
     
@@ -294,6 +316,74 @@ std::vector<MODULEENTRY32> ProcessManager::GetLoadedModules() {
     return modules;
 }
 
+// Soft-dirty bits have no counterpart for other processes: Windows write
+// watches only cover the caller's own MEM_WRITE_WATCH allocations
+bool ProcessManager::ClearWrittenPages() {
+    LOG_DEBUG("Write tracking is not supported on this platform");
+    return false;
+}
+
+std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> ProcessManager::QueryWrittenPages(
+    const std::vector<MemoryRegion>& regions) {
+    (void)regions;
+    return std::nullopt;
+}
+
+// Pages per QueryWorkingSetEx call
+constexpr size_t WORKING_SET_QUERY_BATCH = 4096;
+
+// The working set only says which pages are mapped right now; a page trimmed
+// to the pagefile cannot be told apart from one never touched, so both count
+// as not resident
+std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> ProcessManager::QueryResidentPages(
+    const std::vector<MemoryRegion>& regions) {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return std::nullopt;
+    }
+    
+    std::vector<std::pair<MemoryAddress, MemoryAddress>> resident;
+    std::vector<PSAPI_WORKING_SET_EX_INFORMATION> entries;
+    
+    for (const auto& region : regions) {
+        MemoryAddress region_end = region.base_address + region.size;
+        MemoryAddress page = region.base_address / REMOTE_PAGE_SIZE * REMOTE_PAGE_SIZE;
+        
+        while (page < region_end) {
+            size_t count = static_cast<size_t>(std::min<MemoryAddress>(
+                (region_end - page + REMOTE_PAGE_SIZE - 1) / REMOTE_PAGE_SIZE, WORKING_SET_QUERY_BATCH));
+            entries.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                entries[i].VirtualAddress = reinterpret_cast<LPVOID>(page + i * REMOTE_PAGE_SIZE);
+            }
+            
+            if (!QueryWorkingSetEx(process_handle_, entries.data(),
+                                   static_cast<DWORD>(count * sizeof(PSAPI_WORKING_SET_EX_INFORMATION)))) {
+                LOG_WARN("QueryWorkingSetEx failed for process {} at 0x{:X}: {}", process_id_, page, GetLastErrorString());
+                return std::nullopt;
+            }
+            
+            for (size_t i = 0; i < count; ++i, page += REMOTE_PAGE_SIZE) {
+                if (!entries[i].VirtualAttributes.Valid) {
+                    continue;
+                }
+                
+                MemoryAddress start = std::max(page, region.base_address);
+                MemoryAddress end = std::min<MemoryAddress>(page + REMOTE_PAGE_SIZE, region_end);
+                if (!resident.empty() && resident.back().second == start) {
+                    resident.back().second = end;
+                } else {
+                    resident.emplace_back(start, end);
+                }
+            }
+        }
+    }
+    
+    return resident;
+}
+
+#endif // !LINUX_BUILD
+
 std::optional<MemoryAddress> ProcessManager::GetModuleBaseAddress(const std::string& module_name) {
     auto modules = GetLoadedModules();
     
@@ -325,6 +415,180 @@ std::optional<MemoryAddress> ProcessManager::GetModuleBaseAddress(const std::str
     return std::nullopt;
 }
 
+std::vector<MemoryRegion> ProcessManager::EnumerateMemoryRegions() {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return {};
+    }
+    
+    LOG_DEBUG("Enumerating memory regions for process {}", process_id_);
+    
+    auto regions = RefreshRegionMap()->ToMemoryRegions();
+    
+    LOG_DEBUG("Found {} memory regions", regions.size());
+    return regions;
+}
+
+std::shared_ptr<const RegionMap> ProcessManager::GetRegionMap() {
+    {
+        std::lock_guard<std::mutex> lock(region_map_mutex_);
+        if (region_map_) {
+            return region_map_;
+        }
+    }
+    
+    return RefreshRegionMap();
+}
+
+std::shared_ptr<const RegionMap> ProcessManager::RefreshRegionMap() {
+    return RefreshRegionMap(0, std::numeric_limits<MemoryAddress>::max());
+}
+
+std::shared_ptr<const RegionMap> ProcessManager::RefreshRegionMap(MemoryAddress start, MemoryAddress end) {
+    std::vector<RegionMap::Entry> fresh;
+    if (IsAttached() && start < end) {
+        fresh = QueryRegionEntries(start, end);
+    }
+    
+    std::lock_guard<std::mutex> lock(region_map_mutex_);
+    
+    // Readers holding the previous map keep a consistent snapshot. An unchanged
+    // layout keeps the current map, so the caches built on it stay valid.
+    if (!region_map_) {
+        region_map_ = std::make_shared<const RegionMap>(std::move(fresh));
+    } else {
+        RegionMap refreshed = region_map_->WithRange(start, end, fresh);
+        if (refreshed != *region_map_) {
+            region_map_ = std::make_shared<const RegionMap>(std::move(refreshed));
+        }
+    }
+    
+    LOG_DEBUG("Region map refreshed: {} regions, {} MB", region_map_->Size(), region_map_->TotalBytes() / (1024 * 1024));
+    return region_map_;
+}
+
+void ProcessManager::SetRegionFilter(const RegionFilter& filter) {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    region_filter_ = filter;
+    filtered_source_.reset();
+}
+
+RegionFilter ProcessManager::GetRegionFilter() {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    return region_filter_;
+}
+
+std::vector<MemoryRegion> ProcessManager::GetFilteredRegions(RegionFilterStats* stats) {
+    auto region_map = GetRegionMap();
+    
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    if (filtered_source_ != region_map) {
+        // Libraries may have loaded since the last evaluation
+        module_ranges_.reset();
+        filtered_regions_ = region_filter_.Apply(region_map->ToMemoryRegions(), ModuleRangesLocked(), &filter_stats_);
+        filtered_source_ = region_map;
+        
+        LOG_INFO("Region filter kept {} regions ({} MB) and skipped {} regions ({} MB)",
+                 filter_stats_.kept_regions, filter_stats_.kept_bytes / (1024 * 1024),
+                 filter_stats_.skipped_regions, filter_stats_.skipped_bytes / (1024 * 1024));
+    }
+    
+    if (stats) {
+        *stats = filter_stats_;
+    }
+    return filtered_regions_;
+}
+
+bool ProcessManager::SetReadBackend(ReadBackend backend) {
+    if (backend == ReadBackend::Synchronous) {
+        uring_engine_.reset();
+        read_backend_ = backend;
+        return true;
+    }
+    
+    if (!UringReadEngine::Supported()) {
+        LOG_WARN("io_uring reads are not available; keeping the synchronous backend");
+        return false;
+    }
+    
+    // Opened now when attached, otherwise on the next attach
+    if (IsAttached() && !uring_engine_) {
+        uring_engine_ = UringReadEngine::Open(process_id_);
+        if (!uring_engine_) {
+            return false;
+        }
+    }
+    
+    read_backend_ = backend;
+    return true;
+}
+
+std::vector<MemoryRegion> ProcessManager::FilterRegions(const std::vector<MemoryRegion>& regions, RegionFilterStats* stats) {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    return region_filter_.Apply(regions, ModuleRangesLocked(), stats);
+}
+
+const std::vector<RegionFilter::ModuleRange>& ProcessManager::ModuleRangesLocked() {
+    static const std::vector<RegionFilter::ModuleRange> none;
+    if (!region_filter_.NeedsModules()) {
+        return none;
+    }
+    
+    if (!module_ranges_) {
+        module_ranges_ = RegionFilter::ModuleRanges(GetLoadedModules());
+    }
+    return *module_ranges_;
+}
+
+void ProcessManager::ResetFilterCache() {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    filtered_source_.reset();
+    filtered_regions_.clear();
+    filter_stats_ = {};
+    module_ranges_.reset();
+}
+
+void ProcessManager::AddWriteListener(WriteListener listener) {
+    std::lock_guard<std::mutex> lock(write_listeners_mutex_);
+    write_listeners_.push_back(std::move(listener));
+}
+
+void ProcessManager::NotifyWrite(MemoryAddress address, size_t size) {
+    std::lock_guard<std::mutex> lock(write_listeners_mutex_);
+    for (const auto& listener : write_listeners_) {
+        listener(address, size);
+    }
+}
+
+std::string ProcessManager::BuildRegionName(DWORD type, DWORD protection) {
+    std::string name;
+    
+    // Determine region type/name
+    if (type == MEM_IMAGE) {
+        name = "IMAGE";
+    } else if (type == MEM_MAPPED) {
+        name = "MAPPED";
+    } else if (type == MEM_PRIVATE) {
+        name = "PRIVATE";
+    } else {
+        name = "UNKNOWN";
+    }
+    
+    // Add protection information to name
+    std::string protection_str;
+    if (protection & PAGE_EXECUTE) protection_str += "X";
+    if (protection & PAGE_READWRITE) protection_str += "RW";
+    else if (protection & PAGE_READONLY) protection_str += "R";
+    if (protection & PAGE_WRITECOPY) protection_str += "WC";
+    
+    if (!protection_str.empty()) {
+        name += "_" + protection_str;
+    }
+    
+    return name;
+}
+
+#ifndef LINUX_BUILD
 bool ProcessManager::ValidateProcessAccess() {
     if (!IsAttached()) {
         return false;
@@ -385,4 +649,6 @@ void ProcessManager::LogProcessInfo() {
     }
 }
 
+#endif // !LINUX_BUILD
+
 } // namespace MemoryForensics
\ No newline at end of file
@@ -0,0 +1,680 @@
+#include "process_manager.hpp"
+#include "app_logger.hpp"
+
+#ifdef LINUX_BUILD
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/mman.h>
+
+namespace MemoryForensics {
+
+namespace {
+
+// process_vm_readv accepts at most IOV_MAX elements per call
+constexpr size_t MAX_BATCH_IOVECS = IOV_MAX;
+
+// /proc/<pid>/pagemap holds one 64-bit entry per virtual page
+constexpr uint64_t PAGEMAP_PRESENT = 1ULL << 63;
+constexpr uint64_t PAGEMAP_SWAPPED = 1ULL << 62;
+constexpr uint64_t PAGEMAP_SOFT_DIRTY = 1ULL << 55;
+constexpr size_t PAGEMAP_BATCH = 4096;  // Entries per pread
+
+// One parsed line of /proc/<pid>/maps
+struct MapsEntry {
+    MemoryAddress start = 0;
+    MemoryAddress end = 0;
+    char perms[5] = {};
+    uint64_t offset = 0;
+    uint64_t inode = 0;
+    std::string path;
+};
+
+std::vector<MapsEntry> ReadMapsFile(ProcessID pid) {
+    std::vector<MapsEntry> entries;
+    
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    if (!maps.is_open()) {
+        return entries;
+    }
+    
+    std::string line;
+    while (std::getline(maps, line)) {
+        MapsEntry entry;
+        unsigned long long start = 0, end = 0, offset = 0, inode = 0;
+        int path_pos = 0;
+        
+        // Format: start-end perms offset dev inode [path]
+        if (std::sscanf(line.c_str(), "%llx-%llx %4s %llx %*s %llu %n",
+                        &start, &end, entry.perms, &offset, &inode, &path_pos) < 5) {
+            continue;
+        }
+        
+        entry.start = static_cast<MemoryAddress>(start);
+        entry.end = static_cast<MemoryAddress>(end);
+        entry.offset = offset;
+        entry.inode = inode;
+        if (path_pos > 0 && static_cast<size_t>(path_pos) < line.size()) {
+            entry.path = line.substr(path_pos);
+        }
+        
+        entries.push_back(entry);
+    }
+    
+    return entries;
+}
+
+// Translate "rwxp" permissions to the Windows protection constants used by MemoryRegion
+DWORD ProtectionFromPerms(const char* perms) {
+    bool readable = perms[0] == 'r';
+    bool writable = perms[1] == 'w';
+    bool executable = perms[2] == 'x';
+    
+    if (executable) {
+        if (writable) return PAGE_EXECUTE_READWRITE;
+        if (readable) return PAGE_EXECUTE_READ;
+        return PAGE_EXECUTE;
+    }
+    
+    if (writable) return PAGE_READWRITE;
+    if (readable) return PAGE_READONLY;
+    return PAGE_NOACCESS;
+}
+
+bool HasImageExtension(const std::string& path) {
+    std::string lower = path;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    
+    auto ends_with = [&lower](const char* suffix) {
+        size_t len = std::strlen(suffix);
+        return lower.size() >= len && lower.compare(lower.size() - len, len, suffix) == 0;
+    };
+    
+    // Native shared objects plus PE images mapped by Wine/Proton
+    return ends_with(".so") || lower.find(".so.") != std::string::npos ||
+           ends_with(".dll") || ends_with(".exe") || ends_with(".drv") || ends_with(".sys");
+}
+
+// Classify a mapping the same way VirtualQueryEx reports MEMORY_BASIC_INFORMATION::Type
+DWORD TypeFromMapping(const MapsEntry& entry, const std::string& exe_path) {
+    if (entry.path.empty() || entry.path.front() == '[') {
+        return MEM_PRIVATE;  // Anonymous memory, [heap], [stack], [anon:...]
+    }
+    
+    if (entry.inode != 0 && (entry.path == exe_path || HasImageExtension(entry.path))) {
+        return MEM_IMAGE;
+    }
+    
+    return MEM_MAPPED;
+}
+
+std::string ReadExePath(ProcessID pid) {
+    std::error_code ec;
+    auto target = std::filesystem::read_symlink("/proc/" + std::to_string(pid) + "/exe", ec);
+    return ec ? std::string() : target.string();
+}
+
+std::string BaseName(const std::string& path) {
+    size_t last_slash = path.find_last_of("\\/");
+    return last_slash == std::string::npos ? path : path.substr(last_slash + 1);
+}
+
+// Process name as it would appear in a Toolhelp snapshot. Wine/Proton processes
+// carry the Windows image path in argv[0], so prefer that over /proc/<pid>/comm.
+std::string ReadProcessName(ProcessID pid) {
+    std::string proc_dir = "/proc/" + std::to_string(pid);
+    
+    std::ifstream cmdline(proc_dir + "/cmdline", std::ios::binary);
+    if (cmdline.is_open()) {
+        std::string argv0;
+        std::getline(cmdline, argv0, '\0');
+        if (!argv0.empty()) {
+            return BaseName(argv0);
+        }
+    }
+    
+    std::ifstream comm(proc_dir + "/comm");
+    std::string name;
+    if (comm.is_open() && std::getline(comm, name)) {
+        return name;
+    }
+    
+    return "";
+}
+
+// Kernels without CONFIG_MEM_SOFT_DIRTY accept writes to clear_refs but never set
+// the bit. A fresh mapping starts soft-dirty where tracking exists, so one page of
+// our own shows whether the bit means anything.
+bool SoftDirtySupported() {
+    static const bool supported = [] {
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        void* page = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED) {
+            return false;
+        }
+        
+        *static_cast<volatile uint8_t*>(page) = 1;
+        uint64_t entry = 0;
+        int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            off_t offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(page) / page_size * sizeof(uint64_t));
+            if (pread(fd, &entry, sizeof(entry), offset) != static_cast<ssize_t>(sizeof(entry))) {
+                entry = 0;
+            }
+            close(fd);
+        }
+        munmap(page, page_size);
+        return (entry & PAGEMAP_SOFT_DIRTY) != 0;
+    }();
+    return supported;
+}
+
+// Coalesced [start, end) runs of the pages in regions whose pagemap entry has
+// any of the bits in mask, clipped to the regions. Pages whose entry cannot be
+// read ([vsyscall] has none) are included, as both callers need to read them.
+std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> ReadPagemapRuns(
+    ProcessID pid, const std::vector<MemoryRegion>& regions, uint64_t mask) {
+    std::string path = "/proc/" + std::to_string(pid) + "/pagemap";
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARN("Cannot open {}: {} ({})", path, GetLastErrorString(), errno);
+        return std::nullopt;
+    }
+    
+    const MemoryAddress page_size = static_cast<MemoryAddress>(sysconf(_SC_PAGESIZE));
+    std::vector<std::pair<MemoryAddress, MemoryAddress>> runs;
+    std::vector<uint64_t> entries(PAGEMAP_BATCH);
+    
+    auto add = [&runs](MemoryAddress start, MemoryAddress end) {
+        if (!runs.empty() && runs.back().second == start) {
+            runs.back().second = end;
+        } else {
+            runs.emplace_back(start, end);
+        }
+    };
+    
+    for (const auto& region : regions) {
+        MemoryAddress page = region.base_address / page_size * page_size;
+        MemoryAddress region_end = region.base_address + region.size;
+        
+        while (page < region_end) {
+            size_t count = static_cast<size_t>(std::min<MemoryAddress>((region_end - page + page_size - 1) / page_size, PAGEMAP_BATCH));
+            ssize_t bytes = pread(fd, entries.data(), count * sizeof(uint64_t), static_cast<off_t>(page / page_size * sizeof(uint64_t)));
+            if (bytes < static_cast<ssize_t>(sizeof(uint64_t))) {
+                LOG_DEBUG("No pagemap entries for process {} at 0x{:X}: {} ({})",
+                          pid, page, GetLastErrorString(), errno);
+                add(std::max(page, region.base_address), region_end);
+                break;
+            }
+            
+            count = static_cast<size_t>(bytes) / sizeof(uint64_t);
+            for (size_t i = 0; i < count; ++i, page += page_size) {
+                if (entries[i] & mask) {
+                    add(std::max(page, region.base_address), std::min(page + page_size, region_end));
+                }
+            }
+        }
+    }
+    
+    close(fd);
+    return runs;
+}
+
+// Read requests[indices] with as few process_vm_readv calls as possible
+size_t ReadVectored(ProcessID pid, std::vector<ReadRequest>& requests, const std::vector<size_t>& indices,
+                    const ReadCompletion& on_complete) {
+    std::vector<struct iovec> local_iov;
+    std::vector<struct iovec> remote_iov;
+    size_t succeeded = 0;
+    size_t next = 0;
+    
+    while (next < indices.size()) {
+        size_t count = std::min(indices.size() - next, MAX_BATCH_IOVECS);
+        
+        local_iov.clear();
+        remote_iov.clear();
+        for (size_t k = next; k < next + count; ++k) {
+            const auto& request = requests[indices[k]];
+            local_iov.push_back({ request.buffer, request.size });
+            remote_iov.push_back({ reinterpret_cast<void*>(request.address), request.size });
+        }
+        
+        ssize_t bytes_read = process_vm_readv(pid, local_iov.data(), count,
+                                              remote_iov.data(), count, 0);
+        
+        // The kernel transfers elements in order and stops at the first one that
+        // faults, so the byte count tells us exactly which elements completed
+        size_t completed = 0;
+        size_t remaining = bytes_read > 0 ? static_cast<size_t>(bytes_read) : 0;
+        while (completed < count && remaining >= requests[indices[next + completed]].size) {
+            auto& request = requests[indices[next + completed]];
+            remaining -= request.size;
+            request.success = true;
+            ++succeeded;
+            ++completed;
+        }
+        
+        if (completed < count) {
+            // Skip the faulting element and resume with the one after it
+            LOG_DEBUG("Batch read stopped at unreadable address 0x{:X}",
+                     requests[indices[next + completed]].address);
+            ++completed;
+        }
+        
+        if (on_complete) {
+            for (size_t k = next; k < next + completed; ++k) {
+                on_complete(indices[k]);
+            }
+        }
+        next += completed;
+    }
+    
+    return succeeded;
+}
+
+} // namespace
+
+bool ProcessManager::AttachToProcess(ProcessID pid) {
+    LOG_INFO("Attempting to attach to process ID: {}", pid);
+    
+    // Detach from any existing process first
+    DetachFromProcess();
+    
+    // Reading the maps file requires the same ptrace access check as process_vm_readv
+    std::string maps_path = "/proc/" + std::to_string(pid) + "/maps";
+    if (access(maps_path.c_str(), R_OK) != 0) {
+        LOG_ERROR("Failed to open process {}: {} ({})", pid, GetLastErrorString(), errno);
+        return false;
+    }
+    
+    process_id_ = pid;
+    process_handle_ = nullptr;
+    
+    process_name_ = ReadProcessName(pid);
+    if (process_name_.empty()) {
+        process_name_ = "Unknown";
+    }
+    
+    RefreshRegionMap();
+    
+    if (read_backend_ == ReadBackend::IoUring) {
+        uring_engine_ = UringReadEngine::Open(pid);
+        if (!uring_engine_) {
+            LOG_WARN("Falling back to process_vm_readv for PID {}", pid);
+        }
+    }
+    
+    if (!ValidateProcessAccess()) {
+        LOG_WARN("Process access validation failed for PID {}", pid);
+    }
+    
+    LogProcessInfo();
+    LOG_INFO("Successfully attached to process {} (PID: {})", process_name_, process_id_);
+    
+    return true;
+}
+
+void ProcessManager::DetachFromProcess() {
+    if (process_id_ != 0) {
+        LOG_INFO("Detaching from process {} (PID: {})", process_name_, process_id_);
+        process_handle_ = nullptr;
+        process_id_ = 0;
+        process_name_.clear();
+        uring_engine_.reset();
+        ResetFilterCache();
+        
+        std::lock_guard<std::mutex> lock(region_map_mutex_);
+        region_map_.reset();
+    }
+}
+
+std::vector<RegionMap::Entry> ProcessManager::QueryRegionEntries(MemoryAddress start, MemoryAddress end) {
+    std::vector<RegionMap::Entry> entries;
+    
+    std::string exe_path = ReadExePath(process_id_);
+    
+    for (const auto& entry : ReadMapsFile(process_id_)) {
+        if (entry.end <= start || entry.start >= end) {
+            continue;
+        }
+        
+        DWORD protection = ProtectionFromPerms(entry.perms);
+        
+        // "---p" mappings are address space reservations (guard areas, Wine's
+        // reserved ranges) - the equivalent of MEM_RESERVE, which we skip on Windows too
+        if (protection == PAGE_NOACCESS) {
+            continue;
+        }
+        
+        entries.push_back({ entry.start, static_cast<size_t>(entry.end - entry.start),
+                            protection, TypeFromMapping(entry, exe_path) });
+    }
+    
+    return entries;
+}
+
+bool ProcessManager::ReadMemory(MemoryAddress address, void* buffer, size_t size) {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return false;
+    }
+    
+    if (buffer == nullptr || size == 0) {
+        LOG_ERROR("Invalid buffer or size for memory read");
+        return false;
+    }
+    
+    if (size > MAX_READ_SIZE) {
+        LOG_WARN("Read size {} exceeds maximum allowed size {}", size, MAX_READ_SIZE);
+        return false;
+    }
+    
+    struct iovec local_iov = { buffer, size };
+    struct iovec remote_iov = { reinterpret_cast<void*>(address), size };
+    
+    ssize_t bytes_read = process_vm_readv(process_id_, &local_iov, 1, &remote_iov, 1, 0);
+    
+    if (bytes_read < 0 || static_cast<size_t>(bytes_read) != size) {
+        LOG_DEBUG("Failed to read {} bytes from 0x{:X}: {} ({})",
+                 size, address, GetLastErrorString(), errno);
+        return false;
+    }
+    
+    return true;
+}
+
+size_t ProcessManager::ReadMemoryBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    std::vector<size_t> pending;
+    pending.reserve(requests.size());
+    
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto& request = requests[i];
+        request.success = false;
+        if (request.buffer != nullptr && request.size != 0 && request.size <= MAX_READ_SIZE) {
+            pending.push_back(i);
+        } else if (on_complete) {
+            on_complete(i);
+        }
+    }
+    
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        if (on_complete) {
+            for (size_t index : pending) {
+                on_complete(index);
+            }
+        }
+        return 0;
+    }
+    
+    size_t succeeded = 0;
+    if (uring_engine_) {
+        // The mem file reads through page protections where process_vm_readv
+        // fails. Only ranges the region map knows to be readable go to the ring;
+        // the rest, no-access pages included, take process_vm_readv, so both
+        // backends fail the same reads.
+        auto region_map = GetRegionMap();
+        std::vector<ReadRequest> ring_requests;
+        std::vector<size_t> ring_owners;
+        std::vector<size_t> vectored;
+        for (size_t index : pending) {
+            const auto& request = requests[index];
+            if (region_map->IsReadable(request.address, request.size)) {
+                ring_requests.push_back({ request.address, request.buffer, request.size });
+                ring_owners.push_back(index);
+            } else {
+                vectored.push_back(index);
+            }
+        }
+        
+        if (!ring_requests.empty()) {
+            succeeded += uring_engine_->ReadBatch(ring_requests, [&](size_t k) {
+                requests[ring_owners[k]].success = ring_requests[k].success;
+                if (on_complete) {
+                    on_complete(ring_owners[k]);
+                }
+            });
+        }
+        pending = std::move(vectored);
+    }
+    
+    succeeded += ReadVectored(process_id_, requests, pending, on_complete);
+    
+    LOG_DEBUG("Batch read completed {}/{} requests", succeeded, requests.size());
+    return succeeded;
+}
+
+bool ProcessManager::WriteMemory(MemoryAddress address, const void* buffer, size_t size) {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return false;
+    }
+    
+    if (buffer == nullptr || size == 0) {
+        LOG_ERROR("Invalid buffer or size for memory write");
+        return false;
+    }
+    
+    struct iovec local_iov = { const_cast<void*>(buffer), size };
+    struct iovec remote_iov = { reinterpret_cast<void*>(address), size };
+    
+    ssize_t bytes_written = process_vm_writev(process_id_, &local_iov, 1, &remote_iov, 1, 0);
+    
+    if (bytes_written < 0 || static_cast<size_t>(bytes_written) != size) {
+        LOG_ERROR("Failed to write {} bytes to 0x{:X}: {} ({})",
+                 size, address, GetLastErrorString(), errno);
+        return false;
+    }
+    
+    LOG_DEBUG("Successfully wrote {} bytes to 0x{:X}", size, address);
+    NotifyWrite(address, size);
+    return true;
+}
+
+bool ProcessManager::ClearWrittenPages() {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return false;
+    }
+    
+    if (!SoftDirtySupported()) {
+        LOG_WARN("Kernel does not track soft-dirty pages (CONFIG_MEM_SOFT_DIRTY)");
+        return false;
+    }
+    
+    // "4" clears only the soft-dirty bits; other values reset the accessed bits too.
+    // The file is writable by the target's owner, not through ptrace access alone.
+    std::string path = "/proc/" + std::to_string(process_id_) + "/clear_refs";
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARN("Cannot open {}: {} ({})", path, GetLastErrorString(), errno);
+        return false;
+    }
+    
+    bool cleared = write(fd, "4", 1) == 1;
+    if (!cleared) {
+        LOG_WARN("Failed to clear soft-dirty bits of process {}: {} ({})",
+                 process_id_, GetLastErrorString(), errno);
+    }
+    close(fd);
+    return cleared;
+}
+
+std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> ProcessManager::QueryWrittenPages(
+    const std::vector<MemoryRegion>& regions) {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return std::nullopt;
+    }
+    return ReadPagemapRuns(process_id_, regions, PAGEMAP_SOFT_DIRTY);
+}
+
+std::optional<std::vector<std::pair<MemoryAddress, MemoryAddress>>> ProcessManager::QueryResidentPages(
+    const std::vector<MemoryRegion>& regions) {
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return std::nullopt;
+    }
+    
+    // A swapped-out page still holds data; only pages with neither bit were never populated
+    return ReadPagemapRuns(process_id_, regions, PAGEMAP_PRESENT | PAGEMAP_SWAPPED);
+}
+
+std::vector<std::pair<ProcessID, std::string>> ProcessManager::ListRunningProcesses() {
+    std::vector<std::pair<ProcessID, std::string>> processes;
+    
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc", ec)) {
+        const std::string dir_name = entry.path().filename().string();
+        if (dir_name.empty() || !std::all_of(dir_name.begin(), dir_name.end(), ::isdigit)) {
+            continue;
+        }
+        
+        ProcessID pid = static_cast<ProcessID>(std::stoul(dir_name));
+        std::string name = ReadProcessName(pid);
+        if (!name.empty()) {
+            processes.emplace_back(pid, name);
+        }
+    }
+    
+    if (ec) {
+        LOG_ERROR("Failed to enumerate /proc: {}", ec.message());
+    }
+    
+    return processes;
+}
+
+std::vector<MODULEENTRY32> ProcessManager::GetLoadedModules() {
+    std::vector<MODULEENTRY32> modules;
+    
+    if (!IsAttached()) {
+        LOG_ERROR("Not attached to any process");
+        return modules;
+    }
+    
+    std::string exe_path = ReadExePath(process_id_);
+    
+    // A module is every image mapping of the same file; its extent spans all of them
+    std::map<std::string, std::pair<MemoryAddress, MemoryAddress>> extents;
+    std::vector<std::string> load_order;
+    
+    for (const auto& entry : ReadMapsFile(process_id_)) {
+        if (TypeFromMapping(entry, exe_path) != MEM_IMAGE) {
+            continue;
+        }
+        
+        auto it = extents.find(entry.path);
+        if (it == extents.end()) {
+            extents.emplace(entry.path, std::make_pair(entry.start, entry.end));
+            load_order.push_back(entry.path);
+        } else {
+            it->second.first = std::min(it->second.first, entry.start);
+            it->second.second = std::max(it->second.second, entry.end);
+        }
+    }
+    
+    for (const auto& path : load_order) {
+        const auto& [start, end] = extents[path];
+        
+        MODULEENTRY32 me32 = {};
+        me32.dwSize = sizeof(MODULEENTRY32);
+        me32.th32ProcessID = process_id_;
+        me32.modBaseAddr = reinterpret_cast<BYTE*>(start);
+        me32.modBaseSize = static_cast<DWORD>(std::min<MemoryAddress>(end - start, UINT32_MAX));
+        std::strncpy(me32.szModule, BaseName(path).c_str(), sizeof(me32.szModule) - 1);
+        std::strncpy(me32.szExePath, path.c_str(), sizeof(me32.szExePath) - 1);
+        
+        modules.push_back(me32);
+    }
+    
+    LOG_DEBUG("Found {} loaded modules", modules.size());
+    return modules;
+}
+
+bool ProcessManager::ValidateProcessAccess() {
+    if (!IsAttached()) {
+        return false;
+    }
+    
+    // Reading a few bytes from the first readable region validates ptrace access,
+    // which is governed by kernel.yama.ptrace_scope rather than file permissions
+    auto region_map = GetRegionMap();
+    size_t readable = 0;
+    while (readable < region_map->Size() && region_map->ProtectionAt(readable) == PAGE_EXECUTE) {
+        ++readable;
+    }
+    
+    if (readable == region_map->Size()) {
+        LOG_WARN("Cannot query memory information for process {}", process_id_);
+        return false;
+    }
+    
+    uint64_t probe = 0;
+    struct iovec local_iov = { &probe, sizeof(probe) };
+    struct iovec remote_iov = { reinterpret_cast<void*>(region_map->BaseAt(readable)), sizeof(probe) };
+    if (process_vm_readv(process_id_, &local_iov, 1, &remote_iov, 1, 0) != sizeof(probe)) {
+        LOG_WARN("Cannot read memory of process {}: {} - check ptrace_scope or CAP_SYS_PTRACE",
+                 process_id_, GetLastErrorString());
+        return false;
+    }
+    
+    auto modules = GetLoadedModules();
+    if (modules.empty()) {
+        LOG_WARN("Cannot enumerate modules for process {} - may have limited permissions", process_id_);
+        return false;
+    }
+    
+    return true;
+}
+
+void ProcessManager::LogProcessInfo() {
+    if (!IsAttached()) {
+        return;
+    }
+    
+    LOG_DEBUG("Process Information:");
+    LOG_DEBUG("  Name: {}", process_name_);
+    LOG_DEBUG("  PID: {}", process_id_);
+    
+    // Log some basic process information
+    std::ifstream status("/proc/" + std::to_string(process_id_) + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            LOG_DEBUG("  Working Set Size: {}", line.substr(6));
+        } else if (line.rfind("VmHWM:", 0) == 0) {
+            LOG_DEBUG("  Peak Working Set: {}", line.substr(6));
+        } else if (line.rfind("VmSwap:", 0) == 0) {
+            LOG_DEBUG("  Swap Usage: {}", line.substr(7));
+        }
+    }
+    
+    // Log number of loaded modules
+    auto modules = GetLoadedModules();
+    LOG_DEBUG("  Loaded Modules: {}", modules.size());
+    
+    // Log some key modules
+    for (const auto& module : modules) {
+        std::string module_name(module.szModule);
+        if (module_name.find("mono") != std::string::npos ||
+            module_name.find("unity") != std::string::npos ||
+            module_name.find("UnityPlayer") != std::string::npos ||
+            module_name == process_name_) {
+            LOG_DEBUG("    {} - Base: 0x{:X}, Size: {} KB",
+                     module_name,
+                     reinterpret_cast<uintptr_t>(module.modBaseAddr),
+                     module.modBaseSize / 1024);
+        }
+    }
+}
+
+} // namespace MemoryForensics
+
+#endif // LINUX_BUILD
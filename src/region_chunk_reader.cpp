@@ -0,0 +1,222 @@
+#include "region_chunk_reader.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace MemoryForensics {
+
+RegionChunkReader::RegionChunkReader(std::shared_ptr<MemorySource> source, size_t chunk_size, size_t read_ahead)
+    : source_(source), chunk_size_(std::max(chunk_size, REMOTE_PAGE_SIZE)), chunks_(std::max<size_t>(read_ahead, 1)) {
+}
+
+RegionChunkReader::~RegionChunkReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void RegionChunkReader::Begin(MemoryAddress base, size_t size, size_t overlap) {
+    auto mapped = source_->Map(base, size);
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    // Submit nothing more of the previous region, and let the reads already
+    // in flight land before their chunks are reused
+    chunk_count_ = submitted_;
+    cv_.wait(lock, [this] { return !reading_; });
+    
+    region_base_ = base;
+    region_end_ = base + size;
+    overlap_ = overlap;
+    skipped_bytes_ = 0;
+    submitted_ = 0;
+    released_ = 0;
+    next_chunk_ = 0;
+    current_ = nullptr;
+    current_run_ = 0;
+    carry_.clear();
+    carry_end_ = 0;
+    mapped_address_ = base;
+    mapped_ = mapped;
+    
+    chunk_count_ = mapped_.empty() ? (size + chunk_size_ - 1) / chunk_size_ : 0;
+    if (chunk_count_ == 0) {
+        return;
+    }
+    
+    for (auto& chunk : chunks_) {
+        chunk.state = ChunkState::Free;
+        chunk.storage.resize(overlap_ + chunk_size_);
+    }
+    
+    if (!worker_.joinable()) {
+        worker_ = std::thread(&RegionChunkReader::WorkerLoop, this);
+    }
+    
+    lock.unlock();
+    cv_.notify_all();
+}
+
+bool RegionChunkReader::Next(Span& span) {
+    if (!mapped_.empty()) {
+        span = { mapped_address_, mapped_.data(), mapped_.size() };
+        mapped_ = {};
+        return true;
+    }
+    
+    while (true) {
+        if (current_ != nullptr && current_run_ < current_->runs.size()) {
+            auto [offset, length] = current_->runs[current_run_++];
+            uint8_t* data = current_->Data(overlap_) + offset;
+            MemoryAddress address = current_->address + offset;
+            
+            // Prepend the tail of the previous span when it ends exactly here;
+            // the chunk's headroom leaves room for it in front of the data
+            size_t carried = 0;
+            if (offset == 0 && !carry_.empty() && carry_end_ == address) {
+                carried = carry_.size();
+                std::memcpy(data - carried, carry_.data(), carried);
+            }
+            
+            span = { address - carried, data - carried, length + carried };
+            
+            size_t keep = std::min(overlap_, span.size);
+            carry_.assign(span.data + span.size - keep, span.data + span.size);
+            carry_end_ = address + length;
+            return true;
+        }
+        
+        // Current chunk is exhausted: give its buffer back to the read-ahead
+        // window and wait for the next chunk's own read, not the whole batch
+        ReleaseCurrent();
+        if (next_chunk_ >= chunk_count_) {
+            return false;
+        }
+        
+        Chunk& chunk = chunks_[next_chunk_ % chunks_.size()];
+        bool complete;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&chunk] { return chunk.state == ChunkState::Read || chunk.state == ChunkState::Failed; });
+            complete = chunk.state == ChunkState::Read;
+        }
+        ++next_chunk_;
+        
+        chunk.runs.clear();
+        if (complete) {
+            chunk.runs.emplace_back(0, chunk.size);
+        } else {
+            ReadByPage(chunk);
+        }
+        
+        size_t readable = 0;
+        for (const auto& run : chunk.runs) {
+            readable += run.second;
+        }
+        skipped_bytes_ += chunk.size - readable;
+        
+        current_ = &chunk;
+        current_run_ = 0;
+    }
+}
+
+void RegionChunkReader::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<ReadRequest> requests;
+    std::vector<Chunk*> batch;
+    
+    while (true) {
+        cv_.wait(lock, [this] {
+            return stop_ || (submitted_ < chunk_count_ && submitted_ < released_ + chunks_.size());
+        });
+        if (stop_) {
+            return;
+        }
+        
+        // Every chunk the window has room for goes out in one batch
+        requests.clear();
+        batch.clear();
+        size_t limit = std::min(chunk_count_, released_ + chunks_.size());
+        for (; submitted_ < limit; ++submitted_) {
+            Chunk& chunk = chunks_[submitted_ % chunks_.size()];
+            chunk.address = region_base_ + submitted_ * chunk_size_;
+            chunk.size = static_cast<size_t>(std::min<MemoryAddress>(chunk_size_, region_end_ - chunk.address));
+            chunk.state = ChunkState::Reading;
+            requests.push_back({ chunk.address, chunk.Data(overlap_), chunk.size });
+            batch.push_back(&chunk);
+        }
+        reading_ = true;
+        lock.unlock();
+        
+        source_->ReadBatch(requests, [&](size_t index) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            batch[index]->state = requests[index].success ? ChunkState::Read : ChunkState::Failed;
+            cv_.notify_all();
+        });
+        
+        lock.lock();
+        
+        // Sources are not obliged to report every request as it finishes
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (batch[i]->state == ChunkState::Reading) {
+                batch[i]->state = requests[i].success ? ChunkState::Read : ChunkState::Failed;
+            }
+        }
+        reading_ = false;
+        cv_.notify_all();
+    }
+}
+
+void RegionChunkReader::ReadByPage(Chunk& chunk) {
+    // Some page in the chunk is unreadable; retry page by page and keep the rest
+    uint8_t* data = chunk.Data(overlap_);
+    std::vector<ReadRequest> pages;
+    size_t offset = 0;
+    while (offset < chunk.size) {
+        MemoryAddress address = chunk.address + offset;
+        MemoryAddress page_end = (address & ~static_cast<MemoryAddress>(REMOTE_PAGE_SIZE - 1)) + REMOTE_PAGE_SIZE;
+        size_t length = std::min(static_cast<size_t>(page_end - address), chunk.size - offset);
+        
+        pages.push_back({ address, data + offset, length });
+        offset += length;
+    }
+    
+    source_->ReadBatch(pages);
+    
+    for (const auto& page : pages) {
+        if (!page.success) {
+            continue;
+        }
+        
+        size_t page_offset = static_cast<size_t>(page.address - chunk.address);
+        if (!chunk.runs.empty() && chunk.runs.back().first + chunk.runs.back().second == page_offset) {
+            chunk.runs.back().second += page.size;
+        } else {
+            chunk.runs.emplace_back(page_offset, page.size);
+        }
+    }
+    
+    LOG_DEBUG("Chunk at 0x{:X} partially unreadable: {} readable runs", chunk.address, chunk.runs.size());
+}
+
+void RegionChunkReader::ReleaseCurrent() {
+    if (current_ == nullptr) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_->state = ChunkState::Free;
+        ++released_;
+    }
+    cv_.notify_all();
+    current_ = nullptr;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,203 @@
+#include "region_filter.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+
+namespace MemoryForensics {
+
+namespace {
+
+bool ListContains(const std::vector<std::string>& names, const std::string& name) {
+    return std::any_of(names.begin(), names.end(), [&name](const std::string& entry) {
+        return EqualsIgnoreCase(entry, name);
+    });
+}
+
+// Config addresses may be numbers or strings such as "0x7FF600000000"
+std::optional<MemoryAddress> ParseAddress(const nlohmann::json& value) {
+    if (value.is_number_unsigned()) {
+        return value.get<MemoryAddress>();
+    }
+    if (value.is_string()) {
+        try {
+            return static_cast<MemoryAddress>(std::stoull(value.get<std::string>(), nullptr, 0));
+        } catch (const std::exception&) {
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+bool RegionFilter::Accepts(const MemoryRegion& region, const std::string* module) const {
+    if (region.size < min_size || (max_size > 0 && region.size > max_size)) {
+        return false;
+    }
+    
+    if (skip_guard && ((region.protection & PAGE_GUARD) || (region.protection & 0xFF) == PAGE_NOACCESS)) {
+        return false;
+    }
+    if (skip_readonly && !IsWritable(region)) {
+        return false;
+    }
+    if (skip_executable && IsExecutable(region)) {
+        return false;
+    }
+    
+    // Untyped regions (explicit ranges) are never dropped by type
+    if ((region.type == MEM_IMAGE && !include_image) ||
+        (region.type == MEM_MAPPED && !include_mapped) ||
+        (region.type == MEM_PRIVATE && !include_private)) {
+        return false;
+    }
+    
+    if (module && ListContains(exclude_modules, *module)) {
+        return false;
+    }
+    if (!modules.empty() && region.type == MEM_IMAGE && (!module || !ListContains(modules, *module))) {
+        return false;
+    }
+    
+    return true;
+}
+
+std::vector<MemoryRegion> RegionFilter::Apply(const std::vector<MemoryRegion>& regions,
+                                              const std::vector<ModuleRange>& module_ranges,
+                                              RegionFilterStats* stats) const {
+    std::vector<MemoryRegion> kept;
+    RegionFilterStats counts;
+    
+    auto sorted_exclusions = exclude_ranges;
+    std::sort(sorted_exclusions.begin(), sorted_exclusions.end());
+    
+    auto owning_module = [&module_ranges](MemoryAddress address) -> const std::string* {
+        auto it = std::upper_bound(module_ranges.begin(), module_ranges.end(), address,
+                                   [](MemoryAddress value, const ModuleRange& range) { return value < range.base; });
+        if (it == module_ranges.begin()) {
+            return nullptr;
+        }
+        
+        --it;
+        return address < it->end ? &it->name : nullptr;
+    };
+    
+    for (const auto& region : regions) {
+        if (!Accepts(region, owning_module(region.base_address))) {
+            counts.skipped_regions++;
+            counts.skipped_bytes += region.size;
+            continue;
+        }
+        
+        // Keep whatever the exclusion ranges leave of the region
+        size_t pieces_before = kept.size();
+        MemoryAddress cursor = region.base_address;
+        MemoryAddress region_end = region.base_address + region.size;
+        for (const auto& [start, end] : sorted_exclusions) {
+            if (end <= cursor || start >= region_end) {
+                continue;
+            }
+            
+            if (start > cursor) {
+                MemoryRegion piece = region;
+                piece.base_address = cursor;
+                piece.size = static_cast<size_t>(start - cursor);
+                kept.push_back(piece);
+            }
+            cursor = std::max(cursor, std::min(end, region_end));
+        }
+        
+        if (cursor < region_end) {
+            MemoryRegion piece = region;
+            piece.base_address = cursor;
+            piece.size = static_cast<size_t>(region_end - cursor);
+            kept.push_back(piece);
+        }
+        
+        uint64_t kept_bytes = 0;
+        for (size_t i = pieces_before; i < kept.size(); ++i) {
+            kept_bytes += kept[i].size;
+        }
+        
+        if (kept.size() > pieces_before) {
+            counts.kept_regions++;
+        } else {
+            counts.skipped_regions++;
+        }
+        counts.kept_bytes += kept_bytes;
+        counts.skipped_bytes += region.size - kept_bytes;
+    }
+    
+    if (stats) {
+        *stats = counts;
+    }
+    return kept;
+}
+
+RegionFilter RegionFilter::FromConfig(const nlohmann::json& config) {
+    RegionFilter filter;
+    if (!config.contains("memory_scanning")) {
+        return filter;
+    }
+    
+    const auto& scanning = config["memory_scanning"];
+    filter.skip_readonly = scanning.value("skip_readonly_regions", false);
+    if (!scanning.contains("region_filter")) {
+        return filter;
+    }
+    
+    const auto& settings = scanning["region_filter"];
+    filter.skip_readonly = settings.value("skip_readonly", filter.skip_readonly);
+    filter.skip_executable = settings.value("skip_executable", false);
+    filter.skip_guard = settings.value("skip_guard_pages", true);
+    filter.min_size = settings.value("min_region_size", size_t{0});
+    filter.max_size = settings.value("max_region_size", size_t{0});
+    
+    if (settings.contains("types")) {
+        filter.include_image = filter.include_mapped = filter.include_private = false;
+        for (const auto& type : settings["types"]) {
+            std::string name = type.get<std::string>();
+            if (name == "image") {
+                filter.include_image = true;
+            } else if (name == "mapped") {
+                filter.include_mapped = true;
+            } else if (name == "private") {
+                filter.include_private = true;
+            } else {
+                LOG_WARN("Ignoring unknown region type '{}' in region_filter", name);
+            }
+        }
+    }
+    
+    filter.modules = settings.value("modules", std::vector<std::string>());
+    filter.exclude_modules = settings.value("exclude_modules", std::vector<std::string>());
+    
+    if (settings.contains("exclude_ranges")) {
+        for (const auto& range : settings["exclude_ranges"]) {
+            auto start = range.is_array() && range.size() == 2 ? ParseAddress(range[0]) : std::nullopt;
+            auto end = range.is_array() && range.size() == 2 ? ParseAddress(range[1]) : std::nullopt;
+            if (!start || !end || *start >= *end) {
+                LOG_WARN("Ignoring malformed exclude range {}", range.dump());
+                continue;
+            }
+            filter.exclude_ranges.emplace_back(*start, *end);
+        }
+    }
+    
+    return filter;
+}
+
+std::vector<RegionFilter::ModuleRange> RegionFilter::ModuleRanges(const std::vector<MODULEENTRY32>& modules) {
+    std::vector<ModuleRange> ranges;
+    ranges.reserve(modules.size());
+    
+    for (const auto& module : modules) {
+        MemoryAddress base = reinterpret_cast<MemoryAddress>(module.modBaseAddr);
+        ranges.push_back({ base, base + module.modBaseSize, module.szModule });
+    }
+    
+    std::sort(ranges.begin(), ranges.end(), [](const ModuleRange& a, const ModuleRange& b) {
+        return a.base < b.base;
+    });
+    return ranges;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,169 @@
+#include "region_map.hpp"
+#include "process_manager.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace MemoryForensics {
+
+RegionMap::RegionMap(std::vector<Entry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.base_address < b.base_address;
+    });
+    
+    starts_.reserve(entries.size());
+    ends_.reserve(entries.size());
+    protections_.reserve(entries.size());
+    types_.reserve(entries.size());
+    name_ids_.reserve(entries.size());
+    
+    // Only a handful of distinct (type, protection) pairs exist, so each name is built once
+    std::unordered_map<uint64_t, uint16_t> interned;
+    
+    for (const auto& entry : entries) {
+        if (entry.size == 0) {
+            continue;
+        }
+        
+        uint64_t key = (static_cast<uint64_t>(entry.type) << 32) | entry.protection;
+        auto it = interned.find(key);
+        if (it == interned.end()) {
+            it = interned.emplace(key, static_cast<uint16_t>(names_.size())).first;
+            names_.push_back(ProcessManager::BuildRegionName(entry.type, entry.protection));
+        }
+        
+        starts_.push_back(entry.base_address);
+        ends_.push_back(entry.base_address + entry.size);
+        protections_.push_back(entry.protection);
+        types_.push_back(entry.type);
+        name_ids_.push_back(it->second);
+    }
+}
+
+size_t RegionMap::Find(MemoryAddress address) const {
+    size_t count = starts_.size();
+    if (count == 0) {
+        return npos;
+    }
+    
+    // Branchless search for the last region starting at or below address;
+    // the conditional move keeps the loop free of unpredictable branches
+    const MemoryAddress* base = starts_.data();
+    while (count > 1) {
+        size_t half = count / 2;
+        base = (base[half] <= address) ? base + half : base;
+        count -= half;
+    }
+    
+    size_t index = static_cast<size_t>(base - starts_.data());
+    if (starts_[index] > address || address >= ends_[index]) {
+        return npos;
+    }
+    
+    return index;
+}
+
+MemoryRegion RegionMap::RegionAt(size_t index) const {
+    MemoryRegion region;
+    region.base_address = starts_[index];
+    region.size = SizeAt(index);
+    region.protection = protections_[index];
+    region.type = types_[index];
+    region.name = NameAt(index);
+    return region;
+}
+
+std::vector<MemoryRegion> RegionMap::ToMemoryRegions() const {
+    std::vector<MemoryRegion> regions;
+    regions.reserve(Size());
+    
+    for (size_t i = 0; i < Size(); ++i) {
+        regions.push_back(RegionAt(i));
+    }
+    
+    return regions;
+}
+
+bool RegionMap::IsReadable(MemoryAddress address, size_t size) const {
+    if (size > std::numeric_limits<MemoryAddress>::max() - address) {
+        return false;
+    }
+    
+    // Adjacent regions may cover the range between them
+    MemoryAddress end = address + size;
+    while (address < end) {
+        size_t index = Find(address);
+        if (index == npos) {
+            return false;
+        }
+        
+        DWORD protection = ProtectionAt(index);
+        if ((protection & PAGE_GUARD) || !(protection & READABLE_PROTECTION)) {
+            return false;
+        }
+        address = EndAt(index);
+    }
+    return true;
+}
+
+bool RegionMap::operator==(const RegionMap& other) const {
+    // Names follow from type and protection
+    return starts_ == other.starts_ && ends_ == other.ends_ &&
+           protections_ == other.protections_ && types_ == other.types_;
+}
+
+size_t RegionMap::TotalBytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < Size(); ++i) {
+        total += SizeAt(i);
+    }
+    return total;
+}
+
+RegionMap RegionMap::WithRange(MemoryAddress start, MemoryAddress end, const std::vector<Entry>& fresh) const {
+    std::vector<Entry> entries;
+    entries.reserve(Size() + fresh.size());
+    
+    // Keep whatever part of the old regions lies outside the refreshed range
+    for (const auto& entry : ToEntries()) {
+        MemoryAddress entry_end = entry.base_address + entry.size;
+        
+        if (entry.base_address < start) {
+            Entry before = entry;
+            before.size = static_cast<size_t>(std::min(entry_end, start) - entry.base_address);
+            entries.push_back(before);
+        }
+        
+        if (entry_end > end) {
+            Entry after = entry;
+            after.base_address = std::max(entry.base_address, end);
+            after.size = static_cast<size_t>(entry_end - after.base_address);
+            entries.push_back(after);
+        }
+    }
+    
+    // Fresh entries only describe the refreshed range
+    for (const auto& entry : fresh) {
+        MemoryAddress clipped_start = std::max(entry.base_address, start);
+        MemoryAddress clipped_end = std::min(entry.base_address + entry.size, end);
+        
+        if (clipped_start < clipped_end) {
+            entries.push_back({ clipped_start, static_cast<size_t>(clipped_end - clipped_start),
+                                entry.protection, entry.type });
+        }
+    }
+    
+    return RegionMap(std::move(entries));
+}
+
+std::vector<RegionMap::Entry> RegionMap::ToEntries() const {
+    std::vector<Entry> entries;
+    entries.reserve(Size());
+    
+    for (size_t i = 0; i < Size(); ++i) {
+        entries.push_back({ starts_[i], SizeAt(i), protections_[i], types_[i] });
+    }
+    
+    return entries;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,617 @@
+#include "rule.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace MemoryForensics {
+
+namespace {
+
+using Instruction = Rule::Instruction;
+using Program = std::vector<Instruction>;
+
+// A compiled piece of a string. Jump targets are relative to the fragment and
+// may equal its size, which means "continue after the fragment".
+struct Fragment {
+    Program program;
+    size_t min_length = 0;
+    size_t max_length = 0;
+};
+
+Instruction ByteStep(uint8_t value, uint8_t mask) {
+    Instruction instruction{ Instruction::Op::Byte };
+    instruction.value = value & mask;
+    instruction.mask = mask;
+    return instruction;
+}
+
+Instruction Branch(Instruction::Op op, size_t target, size_t alternate = 0) {
+    Instruction instruction{ op };
+    instruction.target = static_cast<uint32_t>(target);
+    instruction.alternate = static_cast<uint32_t>(alternate);
+    return instruction;
+}
+
+void Append(Fragment& to, const Fragment& piece) {
+    uint32_t base = static_cast<uint32_t>(to.program.size());
+    for (Instruction instruction : piece.program) {
+        if (instruction.op == Instruction::Op::Split || instruction.op == Instruction::Op::Jump) {
+            instruction.target += base;
+            instruction.alternate += base;
+        }
+        to.program.push_back(instruction);
+    }
+    to.min_length += piece.min_length;
+    to.max_length += piece.max_length;
+}
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+class RuleParser {
+public:
+    explicit RuleParser(const std::string& text) : text_(text) {}
+    
+    bool Fail(const std::string& message) {
+        if (error_.empty()) {
+            error_ = fmt::format("{} at offset {}", message, position_);
+        }
+        return false;
+    }
+    
+    const std::string& Error() const { return error_; }
+    
+    // Whitespace and // comments
+    void SkipSpace() {
+        while (position_ < text_.size()) {
+            if (std::isspace(static_cast<unsigned char>(text_[position_]))) {
+                ++position_;
+            } else if (text_.compare(position_, 2, "//") == 0) {
+                position_ = text_.find('\n', position_);
+                position_ = position_ == std::string::npos ? text_.size() : position_;
+            } else {
+                break;
+            }
+        }
+    }
+    
+    bool AtEnd() {
+        SkipSpace();
+        return position_ >= text_.size();
+    }
+    
+    char Peek() {
+        SkipSpace();
+        return position_ < text_.size() ? text_[position_] : '\0';
+    }
+    
+    bool Consume(char c) {
+        if (Peek() != c) {
+            return false;
+        }
+        ++position_;
+        return true;
+    }
+    
+    bool ConsumeWord(const char* word) {
+        SkipSpace();
+        size_t length = std::char_traits<char>::length(word);
+        if (text_.compare(position_, length, word) != 0) {
+            return false;
+        }
+        if (position_ + length < text_.size() && IsIdentifierChar(text_[position_ + length])) {
+            return false;
+        }
+        position_ += length;
+        return true;
+    }
+    
+    bool ParseIdentifier(std::string& identifier) {
+        SkipSpace();
+        size_t start = position_;
+        while (position_ < text_.size() && IsIdentifierChar(text_[position_])) {
+            ++position_;
+        }
+        identifier = text_.substr(start, position_ - start);
+        return !identifier.empty() || Fail("Expected an identifier");
+    }
+    
+    // Decimal or 0x-prefixed hexadecimal
+    bool ParseNumber(size_t& number) {
+        SkipSpace();
+        size_t start = position_;
+        int base = 10;
+        if (text_.compare(position_, 2, "0x") == 0 || text_.compare(position_, 2, "0X") == 0) {
+            base = 16;
+            position_ += 2;
+        }
+        
+        number = 0;
+        size_t digits = 0;
+        while (position_ < text_.size()) {
+            int digit = base == 16 ? HexDigit(text_[position_]) :
+                        std::isdigit(static_cast<unsigned char>(text_[position_])) ? text_[position_] - '0' : -1;
+            if (digit < 0) {
+                break;
+            }
+            if (number > (SIZE_MAX - digit) / base) {
+                return Fail("Number is too large");
+            }
+            number = number * base + digit;
+            ++position_;
+            ++digits;
+        }
+        
+        if (digits == 0) {
+            position_ = start;
+            return Fail("Expected a number");
+        }
+        return true;
+    }
+    
+    bool IsNumberNext() {
+        return std::isdigit(static_cast<unsigned char>(Peek())) != 0;
+    }
+    
+    // Items up to (not including) '}', '|' or ')'
+    bool ParseHexSequence(Fragment& sequence) {
+        while (true) {
+            char c = Peek();
+            if (c == '}' || c == '|' || c == ')' || c == '\0') {
+                return true;
+            }
+            
+            Fragment item;
+            if (c == '[') {
+                if (!ParseJump(item)) {
+                    return false;
+                }
+            } else if (c == '(') {
+                if (!ParseAlternation(item)) {
+                    return false;
+                }
+            } else if (!ParseHexByte(item)) {
+                return false;
+            }
+            
+            Append(sequence, item);
+            if (sequence.max_length > Rule::MAX_WINDOW) {
+                return Fail(fmt::format("String can be longer than {} bytes", Rule::MAX_WINDOW));
+            }
+        }
+    }
+    
+    // "4F", "4?", "?F" or "??"
+    bool ParseHexByte(Fragment& item) {
+        SkipSpace();
+        if (position_ + 1 >= text_.size()) {
+            return Fail("Truncated hex byte");
+        }
+        
+        uint8_t value = 0;
+        uint8_t mask = 0;
+        for (int nibble = 0; nibble < 2; ++nibble) {
+            char c = text_[position_ + nibble];
+            int shift = nibble == 0 ? 4 : 0;
+            if (c == '?') {
+                continue;
+            }
+            
+            int digit = HexDigit(c);
+            if (digit < 0) {
+                return Fail(fmt::format("Unexpected '{}' in hex string", c));
+            }
+            value |= static_cast<uint8_t>(digit << shift);
+            mask |= static_cast<uint8_t>(0xF << shift);
+        }
+        
+        position_ += 2;
+        item.program.push_back(ByteStep(value, mask));
+        item.min_length = item.max_length = 1;
+        return true;
+    }
+    
+    // "[n]" or "[n-m]": n wildcard bytes, then up to m - n optional ones
+    bool ParseJump(Fragment& item) {
+        Consume('[');
+        size_t low = 0;
+        size_t high = 0;
+        if (!ParseNumber(low)) {
+            return false;
+        }
+        high = low;
+        if (Consume('-') && !ParseNumber(high)) {
+            return false;
+        }
+        if (!Consume(']')) {
+            return Fail("Expected ']'");
+        }
+        if (high < low || high > Rule::MAX_JUMP) {
+            return Fail(fmt::format("Jumps must be ordered and at most {} bytes", Rule::MAX_JUMP));
+        }
+        
+        for (size_t i = 0; i < low; ++i) {
+            item.program.push_back(ByteStep(0, 0));
+        }
+        
+        // Every optional byte may be skipped straight to the end of the jump
+        size_t end = low + 2 * (high - low);
+        for (size_t i = low; i < high; ++i) {
+            item.program.push_back(Branch(Instruction::Op::Split, item.program.size() + 1, end));
+            item.program.push_back(ByteStep(0, 0));
+        }
+        
+        item.min_length = low;
+        item.max_length = high;
+        return true;
+    }
+    
+    // "( a | b | c )" laid out as split, a, jump end, split, b, jump end, c
+    bool ParseAlternation(Fragment& item) {
+        Consume('(');
+        
+        std::vector<Fragment> alternatives;
+        do {
+            Fragment alternative;
+            if (!ParseHexSequence(alternative)) {
+                return false;
+            }
+            if (alternative.program.empty()) {
+                return Fail("Empty alternative");
+            }
+            alternatives.push_back(std::move(alternative));
+        } while (Consume('|'));
+        
+        if (!Consume(')')) {
+            return Fail("Expected ')'");
+        }
+        
+        std::vector<size_t> exits;
+        item.min_length = SIZE_MAX;
+        for (size_t i = 0; i < alternatives.size(); ++i) {
+            bool last = i + 1 == alternatives.size();
+            size_t split = item.program.size();
+            if (!last) {
+                item.program.push_back(Branch(Instruction::Op::Split, split + 1, 0));
+            }
+            
+            size_t min_length = item.min_length;
+            size_t max_length = item.max_length;
+            item.min_length = item.max_length = 0;
+            Append(item, alternatives[i]);
+            item.min_length = std::min(min_length, item.min_length);
+            item.max_length = std::max(max_length, item.max_length);
+            
+            if (!last) {
+                exits.push_back(item.program.size());
+                item.program.push_back(Branch(Instruction::Op::Jump, 0));
+                item.program[split].alternate = static_cast<uint32_t>(item.program.size());
+            }
+        }
+        
+        for (size_t exit : exits) {
+            item.program[exit].target = static_cast<uint32_t>(item.program.size());
+        }
+        return true;
+    }
+    
+    bool ParseQuoted(Fragment& item) {
+        ++position_;
+        while (position_ < text_.size() && text_[position_] != '"') {
+            char c = text_[position_++];
+            if (c == '\\') {
+                if (position_ >= text_.size()) {
+                    break;
+                }
+                
+                char escape = text_[position_++];
+                switch (escape) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case '0': c = '\0'; break;
+                    case '\\': case '"': c = escape; break;
+                    case 'x': {
+                        int high = position_ < text_.size() ? HexDigit(text_[position_]) : -1;
+                        int low = position_ + 1 < text_.size() ? HexDigit(text_[position_ + 1]) : -1;
+                        if (high < 0 || low < 0) {
+                            return Fail("Expected two hex digits after \\x");
+                        }
+                        c = static_cast<char>(high * 16 + low);
+                        position_ += 2;
+                        break;
+                    }
+                    default:
+                        return Fail(fmt::format("Unknown escape '\\{}'", escape));
+                }
+            }
+            
+            item.program.push_back(ByteStep(static_cast<uint8_t>(c), 0xFF));
+        }
+        
+        if (position_ >= text_.size()) {
+            return Fail("Unterminated string");
+        }
+        ++position_;
+        
+        item.min_length = item.max_length = item.program.size();
+        if (item.max_length > Rule::MAX_WINDOW) {
+            return Fail(fmt::format("String is longer than {} bytes", Rule::MAX_WINDOW));
+        }
+        return true;
+    }
+    
+    bool ParseString(Rule::String& string) {
+        if (!Consume('$') || !ParseIdentifier(string.id)) {
+            return Fail("Expected a $string definition");
+        }
+        if (!Consume('=')) {
+            return Fail("Expected '='");
+        }
+        
+        Fragment body;
+        if (Consume('{')) {
+            if (!ParseHexSequence(body)) {
+                return false;
+            }
+            if (!Consume('}')) {
+                return Fail("Expected '}'");
+            }
+        } else if (Peek() == '"') {
+            if (!ParseQuoted(body)) {
+                return false;
+            }
+        } else {
+            return Fail("Expected a hex string or a quoted string");
+        }
+        
+        if (body.min_length == 0) {
+            return Fail(fmt::format("${} can match zero bytes", string.id));
+        }
+        
+        body.program.push_back({ Instruction::Op::Accept });
+        string.program = std::move(body.program);
+        string.min_length = body.min_length;
+        string.max_length = body.max_length;
+        return true;
+    }
+    
+    bool ParseOr(const std::vector<Rule::String>& strings, Rule::Condition& condition) {
+        if (!ParseAnd(strings, condition)) {
+            return false;
+        }
+        
+        while (ConsumeWord("or")) {
+            Rule::Condition right;
+            if (!ParseAnd(strings, right)) {
+                return false;
+            }
+            condition = Combine(Rule::Condition::Kind::Or, std::move(condition), std::move(right));
+        }
+        return true;
+    }
+    
+    bool ParseAnd(const std::vector<Rule::String>& strings, Rule::Condition& condition) {
+        if (!ParseUnary(strings, condition)) {
+            return false;
+        }
+        
+        while (ConsumeWord("and")) {
+            Rule::Condition right;
+            if (!ParseUnary(strings, right)) {
+                return false;
+            }
+            condition = Combine(Rule::Condition::Kind::And, std::move(condition), std::move(right));
+        }
+        return true;
+    }
+    
+    bool ParseUnary(const std::vector<Rule::String>& strings, Rule::Condition& condition) {
+        if (ConsumeWord("not")) {
+            condition.kind = Rule::Condition::Kind::Not;
+            condition.operands.resize(1);
+            return ParseUnary(strings, condition.operands[0]);
+        }
+        
+        if (Consume('(')) {
+            if (!ParseOr(strings, condition)) {
+                return false;
+            }
+            return Consume(')') || Fail("Expected ')'");
+        }
+        
+        if (Consume('$')) {
+            std::string id;
+            if (!ParseIdentifier(id)) {
+                return false;
+            }
+            
+            auto it = std::find_if(strings.begin(), strings.end(), [&id](const Rule::String& string) {
+                return string.id == id;
+            });
+            if (it == strings.end()) {
+                return Fail(fmt::format("Unknown string ${}", id));
+            }
+            
+            condition.kind = Rule::Condition::Kind::String;
+            condition.index = static_cast<size_t>(it - strings.begin());
+            return true;
+        }
+        
+        // "any of them", "all of them", "N of them"
+        condition.kind = Rule::Condition::Kind::Count;
+        if (ConsumeWord("any")) {
+            condition.count = 1;
+        } else if (ConsumeWord("all")) {
+            condition.count = strings.size();
+        } else if (!IsNumberNext() || !ParseNumber(condition.count)) {
+            return Fail("Expected a condition");
+        }
+        
+        if (!ConsumeWord("of") || !ConsumeWord("them")) {
+            return Fail("Expected 'of them'");
+        }
+        if (condition.count > strings.size()) {
+            return Fail(fmt::format("{} of them, but the rule has {} strings", condition.count, strings.size()));
+        }
+        return true;
+    }
+    
+private:
+    const std::string& text_;
+    size_t position_ = 0;
+    std::string error_;
+    
+    static bool IsIdentifierChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+    
+    // Chains of the same operator stay flat
+    static Rule::Condition Combine(Rule::Condition::Kind kind, Rule::Condition left, Rule::Condition right) {
+        if (left.kind == kind) {
+            left.operands.push_back(std::move(right));
+            return left;
+        }
+        
+        Rule::Condition combined;
+        combined.kind = kind;
+        combined.operands.push_back(std::move(left));
+        combined.operands.push_back(std::move(right));
+        return combined;
+    }
+};
+
+} // namespace
+
+std::optional<Rule> Rule::Parse(const std::string& name, const std::string& text) {
+    Rule rule;
+    rule.name_ = name;
+    
+    RuleParser parser(text);
+    auto fail = [&]() -> std::optional<Rule> {
+        LOG_ERROR("Rule '{}': {}", name, parser.Error());
+        return std::nullopt;
+    };
+    
+    if (parser.ConsumeWord("strings") && !parser.Consume(':')) {
+        parser.Fail("Expected ':'");
+        return fail();
+    }
+    
+    while (parser.Peek() == '$') {
+        String string;
+        if (!parser.ParseString(string)) {
+            return fail();
+        }
+        
+        for (const auto& existing : rule.strings_) {
+            if (existing.id == string.id) {
+                parser.Fail(fmt::format("Duplicate string ${}", string.id));
+                return fail();
+            }
+        }
+        rule.strings_.push_back(std::move(string));
+    }
+    
+    if (rule.strings_.empty()) {
+        parser.Fail("A rule needs at least one string");
+        return fail();
+    }
+    
+    size_t longest = 0;
+    for (const auto& string : rule.strings_) {
+        longest = std::max(longest, string.max_length);
+    }
+    rule.window_ = longest;
+    
+    if (parser.ConsumeWord("condition")) {
+        if (!parser.Consume(':') || !parser.ParseOr(rule.strings_, rule.condition_)) {
+            parser.Fail("Expected ':'");
+            return fail();
+        }
+        
+        if (parser.ConsumeWord("within")) {
+            if (!parser.ParseNumber(rule.window_)) {
+                return fail();
+            }
+            if (rule.window_ > MAX_WINDOW) {
+                parser.Fail(fmt::format("within is limited to {} bytes", MAX_WINDOW));
+                return fail();
+            }
+        }
+    }
+    
+    if (!parser.AtEnd()) {
+        parser.Fail("Unexpected text after the rule");
+        return fail();
+    }
+    
+    for (const auto& string : rule.strings_) {
+        if (string.min_length > rule.window_) {
+            parser.Fail(fmt::format("${} never fits in a {} byte window", string.id, rule.window_));
+            return fail();
+        }
+    }
+    
+    rule.anchors_.assign(rule.strings_.size(), false);
+    rule.MarkAnchors(rule.condition_, false);
+    if (std::find(rule.anchors_.begin(), rule.anchors_.end(), true) == rule.anchors_.end()) {
+        parser.Fail("The condition needs a string that is not negated");
+        return fail();
+    }
+    
+    return rule;
+}
+
+bool Rule::Evaluate(const std::function<bool(size_t index)>& present) const {
+    return Evaluate(condition_, present);
+}
+
+bool Rule::Evaluate(const Condition& condition, const std::function<bool(size_t index)>& present) const {
+    switch (condition.kind) {
+        case Condition::Kind::String:
+            return present(condition.index);
+        case Condition::Kind::And:
+            return std::all_of(condition.operands.begin(), condition.operands.end(),
+                               [&](const Condition& operand) { return Evaluate(operand, present); });
+        case Condition::Kind::Or:
+            return std::any_of(condition.operands.begin(), condition.operands.end(),
+                               [&](const Condition& operand) { return Evaluate(operand, present); });
+        case Condition::Kind::Not:
+            return !Evaluate(condition.operands[0], present);
+        case Condition::Kind::Count: {
+            size_t found = 0;
+            for (size_t i = 0; i < strings_.size() && found < condition.count; ++i) {
+                found += present(i) ? 1 : 0;
+            }
+            return found >= condition.count;
+        }
+    }
+    return false;
+}
+
+void Rule::MarkAnchors(const Condition& condition, bool negated) {
+    switch (condition.kind) {
+        case Condition::Kind::String:
+            anchors_[condition.index] = anchors_[condition.index] || !negated;
+            break;
+        case Condition::Kind::Not:
+            MarkAnchors(condition.operands[0], !negated);
+            break;
+        case Condition::Kind::Count:
+            if (!negated && condition.count > 0) {
+                std::fill(anchors_.begin(), anchors_.end(), true);
+            }
+            break;
+        default:
+            for (const auto& operand : condition.operands) {
+                MarkAnchors(operand, negated);
+            }
+            break;
+    }
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,354 @@
+#include "rule_matcher.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+
+namespace MemoryForensics {
+
+namespace {
+
+using Op = Rule::Instruction::Op;
+
+constexpr uint32_t KEY_SEPARATOR = UINT32_MAX;
+
+} // namespace
+
+RuleMatcher::RuleMatcher(const std::vector<Rule>& rules, size_t alignment)
+    : rules_(rules), alignment_(std::max<size_t>(alignment, 1)) {
+    for (const auto& rule : rules_) {
+        max_window_ = std::max(max_window_, rule.Window());
+    }
+    
+    Compile();
+    LOG_DEBUG("Compiled {} rules into {} program steps over {} byte classes",
+              rules_.size(), program_.size(), class_count_);
+}
+
+void RuleMatcher::Compile() {
+    for (const auto& rule : rules_) {
+        rule_strings_.push_back(string_entries_.size());
+        
+        for (const auto& string : rule.Strings()) {
+            uint32_t base = static_cast<uint32_t>(program_.size());
+            uint32_t index = static_cast<uint32_t>(string_entries_.size());
+            
+            for (Rule::Instruction instruction : string.program) {
+                if (instruction.op == Op::Split || instruction.op == Op::Jump) {
+                    instruction.target += base;
+                    instruction.alternate += base;
+                } else if (instruction.op == Op::Accept) {
+                    instruction.target = index;
+                }
+                program_.push_back(instruction);
+            }
+            
+            string_entries_.push_back(base);
+            string_min_.push_back(string.min_length);
+            string_max_.push_back(string.max_length);
+        }
+    }
+    
+    BuildByteClasses();
+    
+    states_.reset(new State[MAX_DFA_STATES]);
+    transitions_.reset(new std::atomic<int32_t>[MAX_DFA_STATES * class_count_]);
+    for (size_t i = 0; i < MAX_DFA_STATES * class_count_; ++i) {
+        transitions_[i].store(-1, std::memory_order_relaxed);
+    }
+    
+    // State 0: every string may start at the next byte
+    Scratch scratch;
+    scratch.marks.assign(program_.size(), 0);
+    scratch.generation = 1;
+    
+    std::vector<uint32_t> steps;
+    std::vector<uint32_t> accepts;
+    for (uint32_t entry : string_entries_) {
+        Closure(entry, steps, accepts, scratch);
+    }
+    std::sort(steps.begin(), steps.end());
+    
+    std::lock_guard<std::mutex> lock(build_mutex_);
+    InternLocked(std::move(steps), std::move(accepts));
+}
+
+void RuleMatcher::BuildByteClasses() {
+    std::vector<std::pair<uint8_t, uint8_t>> tests;
+    for (const auto& instruction : program_) {
+        if (instruction.op == Op::Byte && instruction.mask != 0) {
+            tests.emplace_back(instruction.value, instruction.mask);
+        }
+    }
+    std::sort(tests.begin(), tests.end());
+    tests.erase(std::unique(tests.begin(), tests.end()), tests.end());
+    
+    // Bytes that pass exactly the same tests behave identically in every state
+    std::map<std::vector<bool>, uint16_t> classes;
+    for (int byte = 0; byte < 256; ++byte) {
+        std::vector<bool> passes(tests.size());
+        for (size_t i = 0; i < tests.size(); ++i) {
+            passes[i] = (byte & tests[i].second) == tests[i].first;
+        }
+        
+        auto inserted = classes.emplace(std::move(passes), static_cast<uint16_t>(classes.size()));
+        if (inserted.second) {
+            class_bytes_.push_back(static_cast<uint8_t>(byte));
+        }
+        byte_classes_[byte] = inserted.first->second;
+    }
+    
+    class_count_ = class_bytes_.size();
+}
+
+void RuleMatcher::FindAll(const uint8_t* data, size_t size, MemoryAddress address, MemoryAddress align_origin,
+                          MemoryAddress reported_until, bool at_end, std::vector<SignatureHit>& hits) const {
+    if (rules_.empty() || size == 0) {
+        return;
+    }
+    
+    // Pass 1: where each string ends
+    std::vector<std::vector<size_t>> ends(string_entries_.size());
+    
+    uint32_t state = 0;
+    size_t i = 0;
+    for (; i < size; ++i) {
+        uint16_t byte_class = byte_classes_[data[i]];
+        int32_t next = transitions_[state * class_count_ + byte_class].load(std::memory_order_acquire);
+        if (next < 0 && (next = AddTransition(state, byte_class)) < 0) {
+            break;
+        }
+        
+        state = static_cast<uint32_t>(next);
+        for (uint32_t string : states_[state].accepts) {
+            ends[string].push_back(i + 1);
+        }
+    }
+    
+    Scratch scratch;
+    scratch.marks.assign(program_.size(), 0);
+    
+    if (i < size) {
+        if (!cache_full_reported_.exchange(true)) {
+            LOG_WARN("Rule DFA reached {} states; continuing without caching", MAX_DFA_STATES);
+        }
+        
+        std::vector<uint32_t> steps = states_[state].steps;
+        std::vector<uint32_t> next;
+        std::vector<uint32_t> accepts;
+        for (; i < size; ++i) {
+            Advance(steps, data[i], next, accepts, scratch);
+            for (uint32_t string : accepts) {
+                ends[string].push_back(i + 1);
+            }
+            steps.swap(next);
+        }
+    }
+    
+    // Pass 2: turn ends into (start, shortest end) pairs, sorted by start
+    std::vector<std::vector<Match>> matches(string_entries_.size());
+    for (size_t string = 0; string < ends.size(); ++string) {
+        if (string_min_[string] == string_max_[string]) {
+            for (size_t end : ends[string]) {
+                matches[string].push_back({ end - string_min_[string], end });
+            }
+            continue;
+        }
+        
+        // Variable length: every start that could produce one of the ends is tried once
+        size_t next_start = 0;
+        for (size_t end : ends[string]) {
+            size_t first = std::max(next_start, end >= string_max_[string] ? end - string_max_[string] : 0);
+            size_t last = end - string_min_[string];
+            for (size_t start = first; start <= last; ++start) {
+                size_t length = AnchoredLength(string, data + start, size - start, scratch);
+                if (length != 0) {
+                    matches[string].push_back({ start, start + length });
+                }
+            }
+            next_start = std::max(next_start, last + 1);
+        }
+    }
+    
+    // Pass 3: open a window at each anchor string match and evaluate the condition
+    std::vector<size_t> anchors;
+    for (size_t r = 0; r < rules_.size(); ++r) {
+        const Rule& rule = rules_[r];
+        size_t first_string = rule_strings_[r];
+        size_t window = rule.Window();
+        
+        anchors.clear();
+        for (size_t k = 0; k < rule.Strings().size(); ++k) {
+            if (rule.IsAnchor(k)) {
+                for (const auto& match : matches[first_string + k]) {
+                    anchors.push_back(match.start);
+                }
+            }
+        }
+        std::sort(anchors.begin(), anchors.end());
+        anchors.erase(std::unique(anchors.begin(), anchors.end()), anchors.end());
+        
+        for (size_t start : anchors) {
+            MemoryAddress hit = address + start;
+            if ((hit - align_origin) % alignment_ != 0 || hit + window <= reported_until ||
+                (start + window > size && !at_end)) {
+                continue;
+            }
+            
+            size_t window_end = start + window;
+            bool matched = rule.Evaluate([&](size_t k) {
+                const auto& list = matches[first_string + k];
+                auto it = std::lower_bound(list.begin(), list.end(), start,
+                                           [](const Match& match, size_t value) { return match.start < value; });
+                for (; it != list.end() && it->start + string_min_[first_string + k] <= window_end; ++it) {
+                    if (it->end <= window_end) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+            
+            if (matched) {
+                hits.push_back({ rule.Name(), hit });
+            }
+        }
+    }
+}
+
+void RuleMatcher::Closure(uint32_t step, std::vector<uint32_t>& steps, std::vector<uint32_t>& accepts,
+                          Scratch& scratch) const {
+    scratch.stack.push_back(step);
+    while (!scratch.stack.empty()) {
+        uint32_t current = scratch.stack.back();
+        scratch.stack.pop_back();
+        if (scratch.marks[current] == scratch.generation) {
+            continue;
+        }
+        scratch.marks[current] = scratch.generation;
+        
+        const Rule::Instruction& instruction = program_[current];
+        switch (instruction.op) {
+            case Op::Byte:
+                steps.push_back(current);
+                break;
+            case Op::Accept:
+                accepts.push_back(instruction.target);
+                break;
+            case Op::Split:
+                scratch.stack.push_back(instruction.alternate);
+                scratch.stack.push_back(instruction.target);
+                break;
+            case Op::Jump:
+                scratch.stack.push_back(instruction.target);
+                break;
+        }
+    }
+}
+
+void RuleMatcher::Advance(const std::vector<uint32_t>& steps, uint8_t byte, std::vector<uint32_t>& next,
+                          std::vector<uint32_t>& accepts, Scratch& scratch) const {
+    next.clear();
+    accepts.clear();
+    if (++scratch.generation == 0) {
+        std::fill(scratch.marks.begin(), scratch.marks.end(), 0);
+        scratch.generation = 1;
+    }
+    
+    for (uint32_t step : steps) {
+        const Rule::Instruction& instruction = program_[step];
+        if ((byte & instruction.mask) == instruction.value) {
+            Closure(step + 1, next, accepts, scratch);
+        }
+    }
+    
+    // The search is unanchored: every string may also start at the next byte
+    for (uint32_t step : states_[0].steps) {
+        if (scratch.marks[step] != scratch.generation) {
+            scratch.marks[step] = scratch.generation;
+            next.push_back(step);
+        }
+    }
+    
+    std::sort(next.begin(), next.end());
+    std::sort(accepts.begin(), accepts.end());
+}
+
+int32_t RuleMatcher::AddTransition(uint32_t state, uint16_t byte_class) const {
+    std::lock_guard<std::mutex> lock(build_mutex_);
+    
+    // Another thread may have added it while we waited
+    std::atomic<int32_t>& slot = transitions_[state * class_count_ + byte_class];
+    int32_t existing = slot.load(std::memory_order_relaxed);
+    if (existing >= 0) {
+        return existing;
+    }
+    
+    Scratch scratch;
+    scratch.marks.assign(program_.size(), 0);
+    
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> accepts;
+    Advance(states_[state].steps, class_bytes_[byte_class], next, accepts, scratch);
+    
+    int32_t target = InternLocked(std::move(next), std::move(accepts));
+    if (target >= 0) {
+        slot.store(target, std::memory_order_release);
+    }
+    return target;
+}
+
+int32_t RuleMatcher::InternLocked(std::vector<uint32_t> steps, std::vector<uint32_t> accepts) const {
+    std::vector<uint32_t> key = steps;
+    key.push_back(KEY_SEPARATOR);
+    key.insert(key.end(), accepts.begin(), accepts.end());
+    
+    auto it = state_index_.find(key);
+    if (it != state_index_.end()) {
+        return static_cast<int32_t>(it->second);
+    }
+    
+    size_t count = state_count_.load(std::memory_order_relaxed);
+    if (count >= MAX_DFA_STATES) {
+        return -1;
+    }
+    
+    states_[count] = { std::move(steps), std::move(accepts) };
+    state_index_.emplace(std::move(key), static_cast<uint32_t>(count));
+    state_count_.store(count + 1, std::memory_order_release);
+    return static_cast<int32_t>(count);
+}
+
+size_t RuleMatcher::AnchoredLength(size_t string, const uint8_t* data, size_t available, Scratch& scratch) const {
+    std::vector<uint32_t> steps;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> accepts;
+    
+    if (++scratch.generation == 0) {
+        std::fill(scratch.marks.begin(), scratch.marks.end(), 0);
+        scratch.generation = 1;
+    }
+    Closure(string_entries_[string], steps, accepts, scratch);
+    
+    for (size_t length = 0; length < available && !steps.empty(); ++length) {
+        if (++scratch.generation == 0) {
+            std::fill(scratch.marks.begin(), scratch.marks.end(), 0);
+            scratch.generation = 1;
+        }
+        
+        next.clear();
+        accepts.clear();
+        for (uint32_t step : steps) {
+            const Rule::Instruction& instruction = program_[step];
+            if ((data[length] & instruction.mask) == instruction.value) {
+                Closure(step + 1, next, accepts, scratch);
+            }
+        }
+        
+        if (!accepts.empty()) {
+            return length + 1;
+        }
+        steps.swap(next);
+    }
+    
+    return 0;
+}
+
+} // namespace MemoryForensics
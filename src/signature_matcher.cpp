@@ -0,0 +1,144 @@
+#include "signature_matcher.hpp"
+#include "app_logger.hpp"
+#include <deque>
+#include <limits>
+
+namespace MemoryForensics {
+
+namespace {
+
+constexpr uint32_t NO_STATE = std::numeric_limits<uint32_t>::max();
+
+} // namespace
+
+SignatureMatcher::SignatureMatcher(const std::vector<Signature>& signatures, size_t alignment)
+    : alignment_(std::max<size_t>(alignment, 1)) {
+    for (const auto& signature : signatures) {
+        // The plan's longest fixed run is the most selective fragment
+        if (signature.pattern.GetPlan().run_length == 0) {
+            LOG_WARN("Signature '{}' has no fixed bytes and cannot be matched", signature.name);
+            continue;
+        }
+        
+        signatures_.push_back(signature);
+        max_length_ = std::max(max_length_, signature.pattern.Length());
+    }
+    
+    Build();
+    LOG_DEBUG("Compiled {} signatures into {} automaton states over {} byte classes",
+             signatures_.size(), StateCount(), class_count_);
+}
+
+void SignatureMatcher::FindAll(const uint8_t* data, size_t size, MemoryAddress address, MemoryAddress align_origin,
+                               MemoryAddress reported_until, std::vector<SignatureHit>& hits) const {
+    uint32_t state = 0;
+    
+    for (size_t i = 0; i < size; ++i) {
+        state = transitions_[state * class_count_ + byte_classes_[data[i]]];
+        
+        for (uint32_t k = outputs_begin_[state]; k < outputs_begin_[state + 1]; ++k) {
+            const Signature& signature = signatures_[outputs_[k]];
+            const Pattern::Plan& plan = signature.pattern.GetPlan();
+            size_t fragment_end = i + 1;
+            size_t length = signature.pattern.Length();
+            
+            // Place the whole signature around the fragment and make sure it fits
+            if (fragment_end < plan.run_offset + plan.run_length) {
+                continue;
+            }
+            size_t start = fragment_end - plan.run_length - plan.run_offset;
+            if (start + length > size) {
+                continue;
+            }
+            
+            MemoryAddress match = address + start;
+            if (match + length <= reported_until || (match - align_origin) % alignment_ != 0) {
+                continue;
+            }
+            
+            if (signature.pattern.Matches(data + start)) {
+                hits.push_back({ signature.name, match });
+            }
+        }
+    }
+}
+
+void SignatureMatcher::Build() {
+    // Bytes that never occur in a fragment share class 0, which keeps rows short
+    for (const auto& signature : signatures_) {
+        const Pattern::Plan& plan = signature.pattern.GetPlan();
+        for (size_t i = 0; i < plan.run_length; ++i) {
+            uint8_t value = signature.pattern.Bytes()[plan.run_offset + i];
+            if (byte_classes_[value] == 0) {
+                byte_classes_[value] = static_cast<uint16_t>(class_count_++);
+            }
+        }
+    }
+    
+    // Trie of all fragments
+    transitions_.assign(class_count_, NO_STATE);
+    std::vector<std::vector<uint32_t>> outputs(1);
+    
+    for (size_t index = 0; index < signatures_.size(); ++index) {
+        const Pattern::Plan& plan = signatures_[index].pattern.GetPlan();
+        uint32_t state = 0;
+        
+        for (size_t i = 0; i < plan.run_length; ++i) {
+            uint16_t byte_class = byte_classes_[signatures_[index].pattern.Bytes()[plan.run_offset + i]];
+            uint32_t& next = transitions_[state * class_count_ + byte_class];
+            
+            if (next == NO_STATE) {
+                next = static_cast<uint32_t>(outputs.size());
+                outputs.emplace_back();
+                transitions_.resize(transitions_.size() + class_count_, NO_STATE);
+            }
+            state = transitions_[state * class_count_ + byte_class];
+        }
+        
+        outputs[state].push_back(static_cast<uint32_t>(index));
+    }
+    
+    // Breadth-first pass turns the trie into a DFA: missing edges follow the
+    // failure link, and each state inherits the outputs of its failure state
+    std::vector<uint32_t> failure(outputs.size(), 0);
+    std::deque<uint32_t> queue;
+    
+    for (size_t c = 0; c < class_count_; ++c) {
+        uint32_t& next = transitions_[c];
+        if (next == NO_STATE) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    
+    while (!queue.empty()) {
+        uint32_t state = queue.front();
+        queue.pop_front();
+        
+        const auto& inherited = outputs[failure[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+        
+        for (size_t c = 0; c < class_count_; ++c) {
+            uint32_t& next = transitions_[state * class_count_ + c];
+            uint32_t fallback = transitions_[failure[state] * class_count_ + c];
+            
+            if (next == NO_STATE) {
+                next = fallback;
+            } else {
+                failure[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+    
+    // Flatten the per-state output lists
+    outputs_begin_.reserve(outputs.size() + 1);
+    for (const auto& list : outputs) {
+        outputs_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+        outputs_.insert(outputs_.end(), list.begin(), list.end());
+    }
+    outputs_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+}
+
+} // namespace MemoryForensics
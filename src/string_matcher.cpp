@@ -0,0 +1,260 @@
+#include "string_matcher.hpp"
+#include "bit_utils.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define STRING_MATCHER_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STRING_MATCHER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define STRING_MATCHER_TARGET_AVX2
+#endif
+
+namespace MemoryForensics {
+
+namespace {
+
+constexpr size_t VERIFY_BLOCK = 16;
+
+bool IsAsciiLetter(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+} // namespace
+
+StringMatcher::StringMatcher(const std::string& text, StringEncoding encoding, bool case_insensitive)
+    : encoding_(encoding), unit_size_(encoding == StringEncoding::Utf16 ? 2 : 1) {
+    if (encoding_ == StringEncoding::Utf16) {
+        expected_ = EncodeUtf16(text);
+    } else {
+        expected_.assign(text.begin(), text.end());
+    }
+    
+    length_ = expected_.size();
+    padded_length_ = (length_ + VERIFY_BLOCK - 1) / VERIFY_BLOCK * VERIFY_BLOCK;
+    last_anchor_ = length_ >= unit_size_ ? length_ - unit_size_ : 0;
+    fold_.assign(length_, 0x00);
+    
+    // Fold whole ASCII code units only; the high byte of a UTF-16 letter stays
+    // an exact zero, so folding can never pair with a non-ASCII character
+    if (case_insensitive) {
+        for (size_t i = 0; i < length_; i += unit_size_) {
+            bool ascii_unit = unit_size_ == 1 || expected_[i + 1] == 0;
+            if (ascii_unit && IsAsciiLetter(expected_[i])) {
+                expected_[i] |= 0x20;
+                fold_[i] = 0x20;
+            }
+        }
+    }
+    
+    // Padding matches anything: (byte | 0xFF) == 0xFF
+    expected_.resize(padded_length_, 0xFF);
+    fold_.resize(padded_length_, 0xFF);
+}
+
+void StringMatcher::FindAll(const uint8_t* data, size_t size, MemoryAddress address,
+                            std::vector<MemoryAddress>& results) const {
+    if (length_ == 0 || size < length_) {
+        return;
+    }
+    
+    size_t phase = static_cast<size_t>(address % unit_size_);
+    std::vector<size_t> hits;
+    
+    static const Kernel kernel = SelectKernel();
+    (this->*kernel)(data, size, phase, hits);
+    
+    for (size_t offset : hits) {
+        results.push_back(address + offset);
+    }
+}
+
+ByteVector StringMatcher::EncodeUtf16(const std::string& text) {
+    ByteVector encoded;
+    encoded.reserve(text.size() * 2);
+    
+    auto put = [&encoded](uint32_t unit) {
+        encoded.push_back(static_cast<uint8_t>(unit & 0xFF));
+        encoded.push_back(static_cast<uint8_t>(unit >> 8));
+    };
+    
+    size_t i = 0;
+    while (i < text.size()) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        size_t extra = lead < 0x80 ? 0 : (lead >> 5) == 0x6 ? 1 : (lead >> 4) == 0xE ? 2 : (lead >> 3) == 0x1E ? 3 : 4;
+        uint32_t code_point = extra == 0 ? lead : extra == 1 ? (lead & 0x1F) : extra == 2 ? (lead & 0x0F) : (lead & 0x07);
+        
+        bool valid = extra < 4 && i + extra < text.size();
+        for (size_t k = 1; valid && k <= extra; ++k) {
+            uint8_t next = static_cast<uint8_t>(text[i + k]);
+            valid = (next & 0xC0) == 0x80;
+            code_point = (code_point << 6) | (next & 0x3F);
+        }
+        
+        if (!valid || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            put(0xFFFD);
+            ++i;
+            continue;
+        }
+        
+        if (code_point >= 0x10000) {
+            code_point -= 0x10000;
+            put(0xD800 | (code_point >> 10));
+            put(0xDC00 | (code_point & 0x3FF));
+        } else {
+            put(code_point);
+        }
+        i += extra + 1;
+    }
+    
+    return encoded;
+}
+
+StringMatcher::Kernel StringMatcher::SelectKernel() {
+#ifdef STRING_MATCHER_X86
+    return CpuSupportsAvx2() ? &StringMatcher::FindAvx2 : &StringMatcher::FindSse2;
+#else
+    return &StringMatcher::FindScalar;
+#endif
+}
+
+bool StringMatcher::IsAligned(size_t phase, size_t position) const {
+    return unit_size_ == 1 || (phase + position) % unit_size_ == 0;
+}
+
+bool StringMatcher::Verify(const uint8_t* candidate, size_t available) const {
+#ifdef STRING_MATCHER_X86
+    if (available >= padded_length_) {
+        for (size_t i = 0; i < padded_length_; i += VERIFY_BLOCK) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate + i));
+            __m128i fold = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fold_.data() + i));
+            __m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected_.data() + i));
+            
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(block, fold), expected)) != 0xFFFF) {
+                return false;
+            }
+        }
+        return true;
+    }
+#else
+    (void)available;
+#endif
+
+    for (size_t i = 0; i < length_; ++i) {
+        if ((candidate[i] | fold_[i]) != expected_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StringMatcher::FindScalar(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    uint8_t first = expected_[0];
+    uint8_t first_fold = fold_[0];
+    
+    for (size_t i = 0; i <= last; ++i) {
+        if ((data[i] | first_fold) == first && IsAligned(phase, i) && Verify(data + i, size - i)) {
+            hits.push_back(i);
+        }
+    }
+}
+
+#ifdef STRING_MATCHER_X86
+
+void StringMatcher::FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    const __m128i first = _mm_set1_epi8(static_cast<char>(expected_[0]));
+    const __m128i first_fold = _mm_set1_epi8(static_cast<char>(fold_[0]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(expected_[last_anchor_]));
+    const __m128i second_fold = _mm_set1_epi8(static_cast<char>(fold_[last_anchor_]));
+    
+    // Steps are a multiple of the unit size, so one mask keeps aligned offsets
+    const uint64_t aligned = unit_size_ == 1 ? ~uint64_t{0} : phase == 0 ? 0x5555555555555555ULL : 0xAAAAAAAAAAAAAAAAULL;
+    
+    auto candidates = [&](const uint8_t* p) {
+        return _mm_and_si128(
+            _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), first_fold), first),
+            _mm_cmpeq_epi8(_mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + last_anchor_)), second_fold), second));
+    };
+    
+    size_t i = 0;
+    for (; i + 32 <= last + 1; i += 32) {
+        const uint8_t* p = data + i;
+        uint64_t bits = (static_cast<uint32_t>(_mm_movemask_epi8(candidates(p))) |
+                         (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(candidates(p + 16)))) << 16)) & aligned;
+        while (bits != 0) {
+            size_t position = i + CountTrailingZeros(bits);
+            bits &= bits - 1;
+            
+            if (Verify(data + position, size - position)) {
+                hits.push_back(position);
+            }
+        }
+    }
+    
+    if (i <= last) {
+        std::vector<size_t> tail;
+        FindScalar(data + i, size - i, (phase + i) % unit_size_, tail);
+        for (size_t offset : tail) {
+            hits.push_back(i + offset);
+        }
+    }
+}
+
+STRING_MATCHER_TARGET_AVX2
+void StringMatcher::FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    size_t last = size - length_;
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(expected_[0]));
+    const __m256i first_fold = _mm256_set1_epi8(static_cast<char>(fold_[0]));
+    const __m256i second = _mm256_set1_epi8(static_cast<char>(expected_[last_anchor_]));
+    const __m256i second_fold = _mm256_set1_epi8(static_cast<char>(fold_[last_anchor_]));
+    const uint64_t aligned = unit_size_ == 1 ? ~uint64_t{0} : phase == 0 ? 0x5555555555555555ULL : 0xAAAAAAAAAAAAAAAAULL;
+    
+    size_t i = 0;
+    for (; i + 64 <= last + 1; i += 64) {
+        const uint8_t* p = data + i;
+        __m256i lo = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), first_fold), first),
+            _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + last_anchor_)), second_fold), second));
+        __m256i hi = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), first_fold), first),
+            _mm256_cmpeq_epi8(_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 + last_anchor_)), second_fold), second));
+        
+        uint64_t bits = (static_cast<uint32_t>(_mm256_movemask_epi8(lo)) |
+                         (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi))) << 32)) & aligned;
+        while (bits != 0) {
+            size_t position = i + CountTrailingZeros(bits);
+            bits &= bits - 1;
+            
+            if (Verify(data + position, size - position)) {
+                hits.push_back(position);
+            }
+        }
+    }
+    
+    if (i <= last) {
+        std::vector<size_t> tail;
+        FindSse2(data + i, size - i, (phase + i) % unit_size_, tail);
+        for (size_t offset : tail) {
+            hits.push_back(i + offset);
+        }
+    }
+}
+
+#else
+
+void StringMatcher::FindSse2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    FindScalar(data, size, phase, hits);
+}
+
+void StringMatcher::FindAvx2(const uint8_t* data, size_t size, size_t phase, std::vector<size_t>& hits) const {
+    FindScalar(data, size, phase, hits);
+}
+
+#endif
+
+} // namespace MemoryForensics
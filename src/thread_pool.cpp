@@ -0,0 +1,131 @@
+#include "thread_pool.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+
+namespace MemoryForensics {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    thread_count = std::max<size_t>(thread_count, 1);
+    
+    for (size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+    
+    LOG_DEBUG("Thread pool started with {} workers", thread_count);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t task_count, const Body& body,
+                             const WaitCallback& on_wait, std::chrono::milliseconds wait_interval) {
+    if (task_count == 0) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    
+    // The body is published before any task becomes visible
+    body_.store(&body, std::memory_order_release);
+    remaining_.store(task_count, std::memory_order_release);
+    
+    // Deal out contiguous blocks so neighbouring tasks stay on one worker
+    size_t workers = queues_.size();
+    for (size_t w = 0; w < workers; ++w) {
+        size_t begin = task_count * w / workers;
+        size_t end = task_count * (w + 1) / workers;
+        
+        std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+        for (size_t task = begin; task < end; ++task) {
+            queues_[w]->tasks.push_back(task);
+        }
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++generation_;
+    work_cv_.notify_all();
+    auto done = [this] { return remaining_.load(std::memory_order_acquire) == 0; };
+    if (!on_wait) {
+        done_cv_.wait(lock, done);
+    } else {
+        // The callback runs unlocked so it cannot hold up finishing workers
+        while (!done_cv_.wait_for(lock, wait_interval, done)) {
+            lock.unlock();
+            on_wait();
+            lock.lock();
+        }
+    }
+    
+    body_.store(nullptr, std::memory_order_release);
+}
+
+void ThreadPool::WorkerLoop(size_t worker) {
+    uint64_t seen_generation = 0;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+        
+        size_t task;
+        while (TakeTask(worker, task)) {
+            // Queues only ever hold tasks of the running batch, so body_ matches them
+            const Body* body = body_.load(std::memory_order_acquire);
+            try {
+                (*body)(task, worker);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Worker {} task {} failed: {}", worker, task, e.what());
+            }
+            
+            if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_cv_.notify_all();
+            }
+        }
+    }
+}
+
+bool ThreadPool::TakeTask(size_t worker, size_t& task) {
+    // Own work first, from the front
+    {
+        WorkerQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    
+    // Then steal from the back of the other workers' queues
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& victim = *queues_[(worker + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+} // namespace MemoryForensics
@@ -0,0 +1,359 @@
+#include "uring_read_engine.hpp"
+#include "app_logger.hpp"
+
+#ifdef LINUX_BUILD
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <thread>
+
+namespace MemoryForensics {
+
+namespace {
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+} // namespace
+
+struct UringReadEngine::Ring {
+    int fd = -1;
+    void* sq_map = MAP_FAILED;
+    size_t sq_map_size = 0;
+    void* cq_map = MAP_FAILED;
+    size_t cq_map_size = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqes_size = 0;
+    
+    // Shared with the kernel: it advances sq_head and cq_tail, we advance the others
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned sq_mask = 0;
+    unsigned* sq_array = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+    
+    ~Ring() {
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, sqes_size);
+        }
+        if (cq_map != MAP_FAILED && cq_map != sq_map) {
+            munmap(cq_map, cq_map_size);
+        }
+        if (sq_map != MAP_FAILED) {
+            munmap(sq_map, sq_map_size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    
+    static std::unique_ptr<Ring> Create() {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        
+        auto ring = std::make_unique<Ring>();
+        ring->fd = IoUringSetup(QUEUE_DEPTH, &params);
+        if (ring->fd < 0) {
+            LOG_DEBUG("io_uring_setup failed: {} ({})", GetLastErrorString(), errno);
+            return nullptr;
+        }
+        
+        // Kernels with a single mapping share one region between both rings
+        ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_map) {
+            ring->sq_map_size = ring->cq_map_size = std::max(ring->sq_map_size, ring->cq_map_size);
+        }
+        
+        ring->sq_map = mmap(nullptr, ring->sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sq_map == MAP_FAILED) {
+            LOG_DEBUG("Failed to map io_uring submission ring: {} ({})", GetLastErrorString(), errno);
+            return nullptr;
+        }
+        
+        ring->cq_map = single_map ? ring->sq_map
+                                  : mmap(nullptr, ring->cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                         ring->fd, IORING_OFF_CQ_RING);
+        ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+                                                     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES));
+        if (ring->cq_map == MAP_FAILED || ring->sqes == MAP_FAILED) {
+            LOG_DEBUG("Failed to map io_uring queues: {} ({})", GetLastErrorString(), errno);
+            return nullptr;
+        }
+        
+        auto* sq = static_cast<uint8_t*>(ring->sq_map);
+        ring->sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        ring->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        ring->sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        ring->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        
+        auto* cq = static_cast<uint8_t*>(ring->cq_map);
+        ring->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        ring->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        ring->cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return ring;
+    }
+    
+    // Whether the kernel implements opcode. Probing arrived in 5.6 together
+    // with IORING_OP_READ, so a kernel that rejects the probe lacks both.
+    bool SupportsOp(uint8_t opcode) const {
+        constexpr unsigned MAX_OPS = 256;
+        std::vector<uint64_t> storage((sizeof(io_uring_probe) + MAX_OPS * sizeof(io_uring_probe_op)) / sizeof(uint64_t) + 1, 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (IoUringRegister(fd, IORING_REGISTER_PROBE, probe, MAX_OPS) < 0) {
+            LOG_DEBUG("io_uring probe failed: {} ({})", GetLastErrorString(), errno);
+            return false;
+        }
+        return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+};
+
+UringReadEngine::~UringReadEngine() {
+    idle_rings_.clear();
+    if (mem_fd_ >= 0) {
+        close(mem_fd_);
+    }
+}
+
+bool UringReadEngine::Supported() {
+    // Kernels 5.1 to 5.5 set rings up fine but fail every IORING_OP_READ with -EINVAL
+    static const bool supported = [] {
+        auto ring = Ring::Create();
+        return ring && ring->SupportsOp(IORING_OP_READ);
+    }();
+    return supported;
+}
+
+std::unique_ptr<UringReadEngine> UringReadEngine::Open(ProcessID pid) {
+    if (!Supported()) {
+        LOG_WARN("io_uring is not available (kernel too old, disabled or filtered)");
+        return nullptr;
+    }
+    
+    // Opening mem takes the same ptrace access check as process_vm_readv
+    std::string path = "/proc/" + std::to_string(pid) + "/mem";
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARN("Cannot open {}: {} ({})", path, GetLastErrorString(), errno);
+        return nullptr;
+    }
+    
+    std::unique_ptr<UringReadEngine> engine(new UringReadEngine());
+    engine->mem_fd_ = fd;
+    LOG_INFO("io_uring reads enabled for process {} (queue depth {})", pid, QUEUE_DEPTH);
+    return engine;
+}
+
+size_t UringReadEngine::ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    Batch batch{ requests, on_complete, {}, std::vector<size_t>(requests.size(), 0),
+                 std::vector<bool>(requests.size(), false) };
+    
+    for (size_t i = 0; i < requests.size(); ++i) {
+        auto& request = requests[i];
+        request.success = false;
+        if (request.buffer == nullptr || request.size == 0 || request.size > MAX_READ_SIZE) {
+            continue;
+        }
+        
+        for (size_t offset = 0; offset < request.size; offset += PIECE_SIZE) {
+            batch.pieces.push_back({ i, offset, std::min(PIECE_SIZE, request.size - offset) });
+            ++batch.outstanding[i];
+        }
+    }
+    
+    // Requests with nothing to read are finished before anything is submitted
+    if (on_complete) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (batch.outstanding[i] == 0) {
+                on_complete(i);
+            }
+        }
+    }
+    
+    auto ring = AcquireRing();
+    if (ring) {
+        if (ReadPieces(*ring, batch)) {
+            ReleaseRing(std::move(ring));
+        }
+    } else {
+        ReadPiecesBlocking(batch, 0);
+    }
+    
+    LOG_DEBUG("io_uring batch completed {}/{} requests in {} pieces",
+              batch.succeeded, requests.size(), batch.pieces.size());
+    return batch.succeeded;
+}
+
+bool UringReadEngine::ReadPieces(Ring& ring, Batch& batch) {
+    const std::vector<Piece>& pieces = batch.pieces;
+    size_t next = 0;        // Pieces queued so far
+    size_t completed = 0;
+    
+    while (completed < pieces.size()) {
+        // Top the queue up to its depth; every completion makes room for another piece
+        unsigned tail = *ring.sq_tail;
+        while (next - completed < QUEUE_DEPTH && next < pieces.size()) {
+            const Piece& piece = pieces[next];
+            const ReadRequest& request = batch.requests[piece.request];
+            
+            unsigned index = tail & ring.sq_mask;
+            io_uring_sqe& sqe = ring.sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = mem_fd_;
+            sqe.addr = reinterpret_cast<uint64_t>(static_cast<uint8_t*>(request.buffer) + piece.offset);
+            sqe.len = static_cast<uint32_t>(piece.size);
+            sqe.off = request.address + piece.offset;
+            sqe.user_data = next;
+            ring.sq_array[index] = index;
+            
+            ++tail;
+            ++next;
+        }
+        __atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+        
+        unsigned unsubmitted = tail - __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE);
+        if (IoUringEnter(ring.fd, unsubmitted, 1, IORING_ENTER_GETEVENTS) < 0 &&
+            errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            LOG_WARN("io_uring_enter failed: {} ({}); finishing the batch with pread", GetLastErrorString(), errno);
+            
+            // The kernel takes queued pieces in order and may still be reading
+            // into the ones it took, so those have to complete before the caller
+            // gets its buffers back. The rest stay queued on the ring, which is
+            // dropped so that no later batch submits them.
+            size_t taken = next - (tail - __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE));
+            while (completed < taken) {
+                if (IoUringEnter(ring.fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                    std::this_thread::yield();
+                }
+                completed += ReapCompletions(ring, batch);
+            }
+            
+            ReadPiecesBlocking(batch, taken);
+            return false;
+        }
+        
+        completed += ReapCompletions(ring, batch);
+    }
+    return true;
+}
+
+size_t UringReadEngine::ReapCompletions(Ring& ring, Batch& batch) {
+    // Pieces complete in any order; a short count means a page in it faulted
+    unsigned head = *ring.cq_head;
+    unsigned cq_tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+    size_t reaped = 0;
+    for (; head != cq_tail; ++head, ++reaped) {
+        const io_uring_cqe& cqe = ring.cqes[head & ring.cq_mask];
+        const Piece& piece = batch.pieces[static_cast<size_t>(cqe.user_data)];
+        bool complete = cqe.res >= 0 && static_cast<size_t>(cqe.res) == piece.size;
+        
+        // Hand the slot back before reporting, as the caller may take a while
+        __atomic_store_n(ring.cq_head, head + 1, __ATOMIC_RELEASE);
+        FinishPiece(batch, piece, complete);
+    }
+    return reaped;
+}
+
+void UringReadEngine::ReadPiecesBlocking(Batch& batch, size_t first) {
+    for (size_t p = first; p < batch.pieces.size(); ++p) {
+        const Piece& piece = batch.pieces[p];
+        const ReadRequest& request = batch.requests[piece.request];
+        if (batch.failed[piece.request]) {
+            FinishPiece(batch, piece, false);
+            continue;
+        }
+        
+        ssize_t bytes = pread(mem_fd_, static_cast<uint8_t*>(request.buffer) + piece.offset, piece.size,
+                              static_cast<off_t>(request.address + piece.offset));
+        FinishPiece(batch, piece, bytes >= 0 && static_cast<size_t>(bytes) == piece.size);
+    }
+}
+
+void UringReadEngine::FinishPiece(Batch& batch, const Piece& piece, bool complete) {
+    if (!complete) {
+        batch.failed[piece.request] = true;
+    }
+    if (--batch.outstanding[piece.request] > 0) {
+        return;
+    }
+    
+    ReadRequest& request = batch.requests[piece.request];
+    request.success = !batch.failed[piece.request];
+    batch.succeeded += request.success ? 1 : 0;
+    if (batch.on_complete) {
+        batch.on_complete(piece.request);
+    }
+}
+
+std::unique_ptr<UringReadEngine::Ring> UringReadEngine::AcquireRing() {
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        if (!idle_rings_.empty()) {
+            auto ring = std::move(idle_rings_.back());
+            idle_rings_.pop_back();
+            return ring;
+        }
+    }
+    return Ring::Create();
+}
+
+void UringReadEngine::ReleaseRing(std::unique_ptr<Ring> ring) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    idle_rings_.push_back(std::move(ring));
+}
+
+} // namespace MemoryForensics
+
+#else
+
+namespace MemoryForensics {
+
+// Other platforms read through their synchronous backend only
+struct UringReadEngine::Ring {};
+
+UringReadEngine::~UringReadEngine() = default;
+
+bool UringReadEngine::Supported() {
+    return false;
+}
+
+std::unique_ptr<UringReadEngine> UringReadEngine::Open(ProcessID pid) {
+    (void)pid;
+    LOG_WARN("io_uring reads are only available on Linux");
+    return nullptr;
+}
+
+size_t UringReadEngine::ReadBatch(std::vector<ReadRequest>& requests, const ReadCompletion& on_complete) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+        requests[i].success = false;
+        if (on_complete) {
+            on_complete(i);
+        }
+    }
+    return 0;
+}
+
+} // namespace MemoryForensics
+
+#endif // LINUX_BUILD
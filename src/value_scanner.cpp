@@ -0,0 +1,620 @@
+#include "value_scanner.hpp"
+#include "bit_utils.hpp"
+#include "app_logger.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace MemoryForensics {
+
+namespace {
+
+struct TypeName {
+    ValueType type;
+    const char* name;
+};
+
+const TypeName TYPE_NAMES[] = {
+    { ValueType::Int8, "int8" }, { ValueType::UInt8, "uint8" },
+    { ValueType::Int16, "int16" }, { ValueType::UInt16, "uint16" },
+    { ValueType::Int32, "int32" }, { ValueType::UInt32, "uint32" },
+    { ValueType::Int64, "int64" }, { ValueType::UInt64, "uint64" },
+    { ValueType::Float, "float" }, { ValueType::Double, "double" }
+};
+
+struct CompareName {
+    ValueCompare compare;
+    const char* name;
+};
+
+const CompareName COMPARE_NAMES[] = {
+    { ValueCompare::Exact, "exact" }, { ValueCompare::Exact, "equal" },
+    { ValueCompare::Range, "range" },
+    { ValueCompare::Changed, "changed" }, { ValueCompare::Unchanged, "unchanged" },
+    { ValueCompare::Increased, "increased" }, { ValueCompare::Decreased, "decreased" },
+    { ValueCompare::Unknown, "unknown" }
+};
+
+const uint8_t ZERO_PAGE[REMOTE_PAGE_SIZE] = {};
+
+bool IsZeroPage(const uint8_t* data) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < REMOTE_PAGE_SIZE; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        bits |= word;
+    }
+    return bits == 0;
+}
+
+template<typename T>
+ScanValue ToScanValue(T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+        return ScanValue::Real(value);
+    } else {
+        return ScanValue::Integer(static_cast<int64_t>(value));
+    }
+}
+
+const char* ValueTypeName(ValueType type) {
+    for (const auto& entry : TYPE_NAMES) {
+        if (entry.type == type) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+// Calls f with a value of the C++ type behind a ValueType
+template<typename F>
+void DispatchType(ValueType type, F&& f) {
+    switch (type) {
+        case ValueType::Int8: f(int8_t{}); break;
+        case ValueType::UInt8: f(uint8_t{}); break;
+        case ValueType::Int16: f(int16_t{}); break;
+        case ValueType::UInt16: f(uint16_t{}); break;
+        case ValueType::Int32: f(int32_t{}); break;
+        case ValueType::UInt32: f(uint32_t{}); break;
+        case ValueType::Int64: f(int64_t{}); break;
+        case ValueType::UInt64: f(uint64_t{}); break;
+        case ValueType::Float: f(float{}); break;
+        case ValueType::Double: f(double{}); break;
+    }
+}
+
+template<typename T>
+T Load(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// Equality and ordering with an absolute tolerance for floating point types
+template<typename T>
+struct Comparator {
+    double tolerance;
+    
+    bool Equal(T a, T b) const {
+        if constexpr (std::is_floating_point<T>::value) {
+            return std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= tolerance;
+        } else {
+            return a == b;
+        }
+    }
+    
+    bool InRange(T x, T low, T high) const {
+        if constexpr (std::is_floating_point<T>::value) {
+            return x >= low - tolerance && x <= high + tolerance;
+        } else {
+            return x >= low && x <= high;
+        }
+    }
+    
+    bool Greater(T a, T b) const { return a > b && !Equal(a, b); }
+};
+
+// Tests every aligned value owned by the span. Candidates are evaluated in
+// blocks of 64 into a bit mask first, which keeps the compare loop free of
+// branches so it vectorizes; Stride 0 falls back to the runtime stride.
+template<typename T, size_t Stride, typename Predicate>
+void CollectSpan(const SweepSpan& span, size_t stride, Predicate match,
+                 std::vector<MemoryAddress>& addresses, ByteVector& values) {
+    const size_t step = Stride ? Stride : stride;
+    
+    MemoryAddress first = span.owned_begin;
+    size_t phase = static_cast<size_t>((first - span.region_base) % step);
+    if (phase != 0) {
+        first += step - phase;
+    }
+    if (first >= span.owned_end) {
+        return;
+    }
+    
+    const uint8_t* base = span.data + (first - span.address);
+    size_t count = static_cast<size_t>((span.owned_end - first + step - 1) / step);
+    
+    for (size_t block = 0; block < count; block += 64) {
+        size_t block_count = std::min<size_t>(count - block, 64);
+        uint64_t bits = 0;
+        for (size_t i = 0; i < block_count; ++i) {
+            bits |= static_cast<uint64_t>(match(Load<T>(base + (block + i) * step))) << i;
+        }
+        
+        while (bits != 0) {
+            size_t i = block + CountTrailingZeros(bits);
+            bits &= bits - 1;
+            
+            const uint8_t* value = base + i * step;
+            addresses.push_back(first + i * step);
+            values.insert(values.end(), value, value + sizeof(T));
+        }
+    }
+}
+
+template<typename T, typename Predicate>
+void CollectSpan(const SweepSpan& span, size_t alignment, Predicate match,
+                 std::vector<MemoryAddress>& addresses, ByteVector& values) {
+    if (alignment == sizeof(T)) {
+        CollectSpan<T, sizeof(T)>(span, alignment, match, addresses, values);
+    } else if (alignment == 1) {
+        CollectSpan<T, 1>(span, alignment, match, addresses, values);
+    } else {
+        CollectSpan<T, 0>(span, alignment, match, addresses, values);
+    }
+}
+
+} // namespace
+
+ValueScanner::ValueScanner(std::shared_ptr<MemoryScanner> scanner)
+    : scanner_(scanner) {
+}
+
+bool ValueScanner::FirstScan(ValueType type, const ValueQuery& query) {
+    if (query.compare != ValueCompare::Exact && query.compare != ValueCompare::Range &&
+        query.compare != ValueCompare::Unknown) {
+        LOG_ERROR("First scan needs an exact value, a range or an unknown value");
+        return false;
+    }
+    
+    Reset();
+    type_ = type;
+    
+    if (query.compare == ValueCompare::Unknown) {
+        CaptureSnapshot();
+    } else {
+        DispatchType(type_, [&](auto tag) {
+            FirstScanTyped<decltype(tag)>(query);
+        });
+    }
+    
+    has_results_ = true;
+    LOG_INFO("First scan found {} {} values", GetResultCount(), ValueTypeName(type_));
+    return true;
+}
+
+bool ValueScanner::NextScan(const ValueQuery& query) {
+    if (!has_results_) {
+        LOG_ERROR("Next scan requires a first scan");
+        return false;
+    }
+    if (query.compare == ValueCompare::Unknown) {
+        LOG_ERROR("Unknown is only valid for a first scan");
+        return false;
+    }
+    
+    size_t before = GetResultCount();
+    DispatchType(type_, [&](auto tag) {
+        NextScanTyped<decltype(tag)>(query);
+    });
+    
+    LOG_INFO("Next scan kept {}/{} {} values", GetResultCount(), before, ValueTypeName(type_));
+    return true;
+}
+
+void ValueScanner::Reset() {
+    has_results_ = false;
+    addresses_.clear();
+    addresses_.shrink_to_fit();
+    values_.clear();
+    values_.shrink_to_fit();
+    snapshot_mode_ = false;
+    pages_.clear();
+    pages_.shrink_to_fit();
+    snapshot_survivors_ = 0;
+}
+
+std::vector<ValueResult> ValueScanner::GetResults(size_t limit) const {
+    std::vector<ValueResult> results;
+    
+    DispatchType(type_, [&](auto tag) {
+        using T = decltype(tag);
+        
+        if (!snapshot_mode_) {
+            size_t count = std::min(addresses_.size(), limit);
+            for (size_t i = 0; i < count; ++i) {
+                results.push_back({ addresses_[i], ToScanValue(Load<T>(values_.data() + i * sizeof(T))) });
+            }
+            return;
+        }
+        
+        size_t stride = SnapshotStride();
+        for (const auto& page : pages_) {
+            const uint8_t* data = page.data.empty() ? ZERO_PAGE : page.data.data();
+            for (size_t word = 0; word < page.survivors.size(); ++word) {
+                uint64_t bits = page.survivors[word];
+                while (bits != 0 && results.size() < limit) {
+                    size_t offset = (word * 64 + CountTrailingZeros(bits)) * stride;
+                    bits &= bits - 1;
+                    results.push_back({ page.address + offset, ToScanValue(Load<T>(data + offset)) });
+                }
+            }
+            if (results.size() >= limit) {
+                return;
+            }
+        }
+    });
+    
+    return results;
+}
+
+size_t ValueScanner::ValueSize(ValueType type) {
+    size_t size = 0;
+    DispatchType(type, [&](auto tag) {
+        size = sizeof(tag);
+    });
+    return size;
+}
+
+std::optional<ValueType> ValueScanner::ParseValueType(const std::string& name) {
+    for (const auto& entry : TYPE_NAMES) {
+        if (name == entry.name) {
+            return entry.type;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<ValueCompare> ValueScanner::ParseCompare(const std::string& name) {
+    for (const auto& entry : COMPARE_NAMES) {
+        if (name == entry.name) {
+            return entry.compare;
+        }
+    }
+    return std::nullopt;
+}
+
+template<typename T>
+void ValueScanner::FirstScanTyped(const ValueQuery& query) {
+    const Comparator<T> cmp{ float_tolerance_ };
+    const size_t alignment = alignment_ ? alignment_ : sizeof(T);
+    
+    // Per-task output, concatenated afterwards so results stay in address order
+    std::vector<std::vector<MemoryAddress>> task_addresses;
+    std::vector<ByteVector> task_values;
+    
+    auto sweep = [&](auto match) {
+        scanner_->SweepScanRegions(sizeof(T),
+            [&](size_t task_count) {
+                task_addresses.assign(task_count, {});
+                task_values.assign(task_count, {});
+            },
+            [&](const SweepSpan& span) {
+                CollectSpan<T>(span, alignment, match, task_addresses[span.task], task_values[span.task]);
+            });
+    };
+    
+    if (query.compare == ValueCompare::Exact) {
+        T target = query.value.As<T>();
+        sweep([cmp, target](T x) { return cmp.Equal(x, target); });
+    } else {
+        T low = query.value.As<T>();
+        T high = query.max_value.As<T>();
+        sweep([cmp, low, high](T x) { return cmp.InRange(x, low, high); });
+    }
+    
+    for (size_t task = 0; task < task_addresses.size(); ++task) {
+        addresses_.insert(addresses_.end(), task_addresses[task].begin(), task_addresses[task].end());
+        values_.insert(values_.end(), task_values[task].begin(), task_values[task].end());
+    }
+}
+
+template<typename T>
+void ValueScanner::NextScanTyped(const ValueQuery& query) {
+    const Comparator<T> cmp{ float_tolerance_ };
+    
+    auto filter = [&](auto keep) {
+        if (snapshot_mode_) {
+            FilterPages<T>(keep);
+        } else {
+            FilterResults<T>(keep);
+        }
+    };
+    
+    T target = query.value.As<T>();
+    T high = query.max_value.As<T>();
+    
+    switch (query.compare) {
+        case ValueCompare::Exact:
+            filter([&](T now, T) { return cmp.Equal(now, target); });
+            break;
+        case ValueCompare::Range:
+            filter([&](T now, T) { return cmp.InRange(now, target, high); });
+            break;
+        case ValueCompare::Changed:
+            filter([&](T now, T previous) { return !cmp.Equal(now, previous); });
+            break;
+        case ValueCompare::Unchanged:
+            filter([&](T now, T previous) { return cmp.Equal(now, previous); });
+            break;
+        case ValueCompare::Increased:
+            filter([&](T now, T previous) { return cmp.Greater(now, previous); });
+            break;
+        case ValueCompare::Decreased:
+            filter([&](T now, T previous) { return cmp.Greater(previous, now); });
+            break;
+        case ValueCompare::Unknown:
+            break;  // Rejected by NextScan
+    }
+}
+
+template<typename T, typename Keep>
+void ValueScanner::FilterResults(Keep keep) {
+    ByteVector current;
+    std::vector<bool> readable = ReadCurrentValues(current);
+    
+    // Compact survivors in place, remembering the value just read
+    size_t kept = 0;
+    for (size_t i = 0; i < addresses_.size(); ++i) {
+        if (!readable[i]) {
+            continue;
+        }
+        
+        T now = Load<T>(current.data() + i * sizeof(T));
+        T previous = Load<T>(values_.data() + i * sizeof(T));
+        if (!keep(now, previous)) {
+            continue;
+        }
+        
+        addresses_[kept] = addresses_[i];
+        std::memcpy(values_.data() + kept * sizeof(T), &now, sizeof(T));
+        ++kept;
+    }
+    
+    addresses_.resize(kept);
+    values_.resize(kept * sizeof(T));
+}
+
+template<typename T, typename Keep>
+void ValueScanner::FilterPages(Keep keep) {
+    const size_t stride = SnapshotStride();
+    const size_t slots = SnapshotSlots();
+    auto source = scanner_->GetReadSource();
+    
+    ByteVector buffer(SNAPSHOT_BATCH_PAGES * REMOTE_PAGE_SIZE);
+    std::vector<ReadRequest> requests;
+    size_t kept = 0;
+    snapshot_survivors_ = 0;
+    
+    for (size_t first = 0; first < pages_.size(); first += SNAPSHOT_BATCH_PAGES) {
+        size_t last = std::min(first + SNAPSHOT_BATCH_PAGES, pages_.size());
+        
+        requests.clear();
+        for (size_t i = first; i < last; ++i) {
+            requests.push_back({ pages_[i].address, buffer.data() + (i - first) * REMOTE_PAGE_SIZE, REMOTE_PAGE_SIZE });
+        }
+        source->ReadBatch(requests);
+        
+        for (size_t i = first; i < last; ++i) {
+            // Pages that went away take their survivors with them
+            if (!requests[i - first].success) {
+                continue;
+            }
+            
+            SnapshotPage& page = pages_[i];
+            const uint8_t* now = static_cast<const uint8_t*>(requests[i - first].buffer);
+            const uint8_t* before = page.data.empty() ? ZERO_PAGE : page.data.data();
+            
+            // Compare 64 slots at a time and mask with the survivors
+            size_t count = 0;
+            for (size_t word = 0; word < page.survivors.size(); ++word) {
+                if (page.survivors[word] == 0) {
+                    continue;
+                }
+                
+                size_t base = word * 64;
+                size_t block_count = std::min<size_t>(slots - base, 64);
+                uint64_t bits = 0;
+                for (size_t k = 0; k < block_count; ++k) {
+                    size_t offset = (base + k) * stride;
+                    bits |= static_cast<uint64_t>(keep(Load<T>(now + offset), Load<T>(before + offset))) << k;
+                }
+                
+                page.survivors[word] &= bits;
+                count += PopCount(page.survivors[word]);
+            }
+            
+            if (count == 0) {
+                continue;
+            }
+            
+            // The next pass compares against what was just read
+            if (IsZeroPage(now)) {
+                page.data.clear();
+                page.data.shrink_to_fit();
+            } else {
+                page.data.assign(now, now + REMOTE_PAGE_SIZE);
+            }
+            
+            snapshot_survivors_ += count;
+            if (kept != i) {
+                pages_[kept] = std::move(page);
+            }
+            ++kept;
+        }
+    }
+    
+    pages_.resize(kept);
+    
+    // Switch to an address list once that is the smaller representation
+    if (snapshot_survivors_ * (sizeof(MemoryAddress) + sizeof(T)) < SnapshotBytes()) {
+        MaterializeSnapshot<T>();
+    }
+}
+
+template<typename T>
+void ValueScanner::MaterializeSnapshot() {
+    addresses_.clear();
+    values_.clear();
+    addresses_.reserve(snapshot_survivors_);
+    values_.reserve(snapshot_survivors_ * sizeof(T));
+    
+    for (const auto& result : GetResults()) {
+        addresses_.push_back(result.address);
+        T value = result.value.As<T>();
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        values_.insert(values_.end(), bytes, bytes + sizeof(T));
+    }
+    
+    LOG_DEBUG("Unknown value scan switched to an address list of {} values", addresses_.size());
+    
+    snapshot_mode_ = false;
+    pages_.clear();
+    pages_.shrink_to_fit();
+    snapshot_survivors_ = 0;
+}
+
+void ValueScanner::CaptureSnapshot() {
+    const size_t slots = SnapshotSlots();
+    if (slots == 0) {
+        LOG_ERROR("Alignment {} leaves no value slots in a page", alignment_);
+        return;
+    }
+    
+    // Every slot of a page starts out as a survivor
+    std::vector<uint64_t> all_slots((slots + 63) / 64, ~uint64_t{0});
+    if (slots % 64 != 0) {
+        all_slots.back() = (uint64_t{1} << (slots % 64)) - 1;
+    }
+    
+    std::vector<std::vector<SnapshotPage>> task_pages;
+    scanner_->SweepScanRegions(1,
+        [&](size_t task_count) {
+            task_pages.assign(task_count, {});
+        },
+        [&](const SweepSpan& span) {
+            MemoryAddress page = (span.owned_begin + REMOTE_PAGE_SIZE - 1) & ~static_cast<MemoryAddress>(REMOTE_PAGE_SIZE - 1);
+            for (; page + REMOTE_PAGE_SIZE <= span.owned_end; page += REMOTE_PAGE_SIZE) {
+                const uint8_t* data = span.data + (page - span.address);
+                SnapshotPage snapshot{ page, {}, all_slots };
+                if (!IsZeroPage(data)) {
+                    snapshot.data.assign(data, data + REMOTE_PAGE_SIZE);
+                }
+                task_pages[span.task].push_back(std::move(snapshot));
+            }
+        },
+        IsWritable);
+    
+    for (auto& pages : task_pages) {
+        std::move(pages.begin(), pages.end(), std::back_inserter(pages_));
+    }
+    
+    snapshot_mode_ = true;
+    snapshot_survivors_ = pages_.size() * slots;
+    LOG_DEBUG("Snapshot holds {} writable pages in {} bytes", pages_.size(), SnapshotBytes());
+}
+
+size_t ValueScanner::SnapshotSlots() const {
+    size_t stride = SnapshotStride();
+    size_t size = ValueSize(type_);
+    return size <= REMOTE_PAGE_SIZE ? (REMOTE_PAGE_SIZE - size) / stride + 1 : 0;
+}
+
+size_t ValueScanner::SnapshotBytes() const {
+    size_t bytes = pages_.capacity() * sizeof(SnapshotPage);
+    for (const auto& page : pages_) {
+        bytes += page.data.capacity() + page.survivors.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+std::vector<bool> ValueScanner::ReadCurrentValues(ByteVector& values) {
+    const size_t value_size = ValueSize(type_);
+    const size_t count = addresses_.size();
+    auto source = scanner_->GetReadSource();
+    
+    values.assign(count * value_size, 0);
+    std::vector<bool> readable(count, false);
+    
+    // Results [first, last) covered by one request
+    struct Run {
+        size_t first;
+        size_t last;
+    };
+    
+    ByteVector buffer(READ_BATCH_BYTES + MAX_RUN_SIZE);
+    std::vector<ReadRequest> requests;
+    std::vector<Run> runs;
+    std::vector<size_t> retry;
+    
+    size_t next = 0;
+    while (next < count) {
+        requests.clear();
+        runs.clear();
+        
+        // Group nearby results into runs until the batch buffer is full
+        size_t used = 0;
+        while (next < count && used < READ_BATCH_BYTES) {
+            size_t first = next;
+            MemoryAddress start = addresses_[next];
+            MemoryAddress end = start + value_size;
+            
+            for (++next; next < count; ++next) {
+                MemoryAddress value_end = addresses_[next] + value_size;
+                if (addresses_[next] > end + MAX_RUN_GAP || value_end - start > MAX_RUN_SIZE) {
+                    break;
+                }
+                end = std::max(end, value_end);
+            }
+            
+            requests.push_back({ start, buffer.data() + used, static_cast<size_t>(end - start) });
+            runs.push_back({ first, next });
+            used += static_cast<size_t>(end - start);
+        }
+        
+        source->ReadBatch(requests);
+        
+        for (size_t k = 0; k < requests.size(); ++k) {
+            const Run& run = runs[k];
+            if (!requests[k].success) {
+                // One bad page fails the whole run, so its values get a second chance alone
+                if (run.last - run.first > 1) {
+                    for (size_t i = run.first; i < run.last; ++i) {
+                        retry.push_back(i);
+                    }
+                }
+                continue;
+            }
+            
+            const uint8_t* data = static_cast<const uint8_t*>(requests[k].buffer);
+            for (size_t i = run.first; i < run.last; ++i) {
+                std::memcpy(values.data() + i * value_size, data + (addresses_[i] - requests[k].address), value_size);
+                readable[i] = true;
+            }
+        }
+    }
+    
+    if (!retry.empty()) {
+        requests.clear();
+        for (size_t i : retry) {
+            requests.push_back({ addresses_[i], values.data() + i * value_size, value_size });
+        }
+        
+        source->ReadBatch(requests);
+        for (size_t k = 0; k < retry.size(); ++k) {
+            readable[retry[k]] = requests[k].success;
+        }
+    }
+    
+    return readable;
+}
+
+} // namespace MemoryForensics
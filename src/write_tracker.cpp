@@ -0,0 +1,122 @@
+#include "write_tracker.hpp"
+#include "app_logger.hpp"
+#include <algorithm>
+
+namespace MemoryForensics {
+
+WriteTracker::WriteTracker(std::shared_ptr<ProcessManager> process_mgr)
+    : process_mgr_(process_mgr) {
+}
+
+bool WriteTracker::Start() {
+    active_ = false;
+    history_.clear();
+    
+    if (!process_mgr_->ClearWrittenPages()) {
+        LOG_WARN("Write tracking is unavailable for this target");
+        return false;
+    }
+    
+    process_id_ = process_mgr_->GetProcessID();
+    active_ = true;
+    LOG_INFO("Tracking writes of process {} from pass {}", process_id_, pass_);
+    return true;
+}
+
+std::optional<uint64_t> WriteTracker::Advance() {
+    if (!active_) {
+        return std::nullopt;
+    }
+    
+    // Bits of another process mean nothing for the recorded passes
+    if (process_mgr_->GetProcessID() != process_id_) {
+        LOG_WARN("Target process changed; write tracking stopped");
+        active_ = false;
+        return std::nullopt;
+    }
+    
+    // The reset below covers the whole process, so the bits of every region that
+    // can be written are read first, not only those of the current scan; the
+    // layout is refreshed so that regions mapped since the last pass are included,
+    // which replaces the shared region map only when the layout changed
+    std::vector<MemoryRegion> writable;
+    for (const auto& region : process_mgr_->EnumerateMemoryRegions()) {
+        if (IsWritable(region)) {
+            writable.push_back(region);
+        }
+    }
+    
+    // Read before resetting; resetting first would lose what we came for
+    auto written = process_mgr_->QueryWrittenPages(writable);
+    if (!written || !process_mgr_->ClearWrittenPages()) {
+        LOG_WARN("Reading soft-dirty bits failed; write tracking stopped");
+        active_ = false;
+        return std::nullopt;
+    }
+    
+    uint64_t bytes = 0;
+    for (const auto& [start, end] : *written) {
+        bytes += end - start;
+    }
+    LOG_DEBUG("Write tracking pass {}: {} bytes in {} ranges written", pass_ + 1, bytes, written->size());
+    
+    history_.push_back(std::move(*written));
+    if (history_.size() > MAX_HISTORY) {
+        history_.pop_front();
+    }
+    return ++pass_;
+}
+
+std::optional<std::vector<WriteTracker::Range>> WriteTracker::WrittenSince(uint64_t pass) const {
+    // Pass p's writes sit at history_[size - 1 - (pass_ - p)]
+    if (!active_ || pass > pass_ || pass_ - pass > history_.size()) {
+        return std::nullopt;
+    }
+    
+    std::vector<Range> written;
+    for (size_t i = history_.size() - static_cast<size_t>(pass_ - pass); i < history_.size(); ++i) {
+        written = Union(written, history_[i]);
+    }
+    return written;
+}
+
+std::vector<WriteTracker::Range> WriteTracker::Union(const std::vector<Range>& a, const std::vector<Range>& b) {
+    std::vector<Range> merged;
+    merged.reserve(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+    
+    std::vector<Range> result;
+    for (const auto& range : merged) {
+        if (!result.empty() && range.first <= result.back().second) {
+            result.back().second = std::max(result.back().second, range.second);
+        } else {
+            result.push_back(range);
+        }
+    }
+    return result;
+}
+
+std::vector<WriteTracker::Range> WriteTracker::Subtract(const std::vector<Range>& from, const std::vector<Range>& remove) {
+    std::vector<Range> result;
+    size_t r = 0;
+    
+    for (auto [start, end] : from) {
+        while (r < remove.size() && remove[r].second <= start) {
+            ++r;
+        }
+        
+        for (size_t k = r; k < remove.size() && remove[k].first < end; ++k) {
+            if (remove[k].first > start) {
+                result.emplace_back(start, remove[k].first);
+            }
+            start = std::max(start, remove[k].second);
+        }
+        
+        if (start < end) {
+            result.emplace_back(start, end);
+        }
+    }
+    return result;
+}
+
+} // namespace MemoryForensics